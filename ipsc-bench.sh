@@ -0,0 +1,97 @@
+#!/bin/bash
+#
+# ipsc-bench.sh
+# Throughput of dissect_ipsc() per opcode, with and without a tree
+#
+# Copyright by Bogdan Diaconesc yo3iiu@yo3iiu.ro
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation; either version 2
+# of the License, or (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+#
+# ipsc-wire-bench -w writes one pcap per case (0x61-0x63, 0x70, 0x80
+# with every data type and voice bursts A and B, 0x84 with CSBK and
+# Data Header, 0x90-0x99); each is read by tshark with the IPSC plugin
+# loaded, three ways:
+#
+#  no tree   tshark -q, one pass: what dissect_ipsc() does without a tree
+#  2 pass    tshark -2 -q, the first pass and a second without a tree
+#  tree      tshark -V, the whole tree built and printed to /dev/null
+#
+# The time tshark takes to start is measured on a one packet copy of
+# each case and taken off, so pkt/s and ns/pkt are per packet.
+#
+# ./ipsc-bench.sh [packets per case]
+# TSHARK=/path/to/tshark CC=gcc ./ipsc-bench.sh 200000
+#
+
+TSHARK=${TSHARK:-tshark}
+CC=${CC:-cc}
+PACKETS=${1:-200000}
+
+case "$PACKETS" in
+  ''|*[!0-9]*) PACKETS=0 ;;
+esac
+if [ "$PACKETS" -lt 2 ]; then
+  echo "usage: $0 [packets per case, at least 2]" >&2
+  exit 1
+fi
+
+if ! "$TSHARK" -G protocols 2>/dev/null | grep -q "	ipsc$"; then
+  echo "$0: $TSHARK does not have the IPSC dissector" >&2
+  exit 1
+fi
+
+dir=$(mktemp -d) || exit 1
+trap 'rm -rf "$dir"' EXIT
+
+mkdir "$dir/one" "$dir/all"
+"$CC" -O2 -std=c99 -I"$(dirname "$0")" "$(dirname "$0")/ipsc-wire-bench.c" -o "$dir/ipsc-wire-bench" || exit 1
+"$dir/ipsc-wire-bench" -w "$dir/one" 1 > /dev/null || exit 1
+"$dir/ipsc-wire-bench" -w "$dir/all" "$PACKETS" > "$dir/cases" || exit 1
+
+# ns a tshark run takes, output thrown away
+run()
+{
+  local start end
+
+  start=$(date +%s%N)
+  "$TSHARK" -n -d udp.port==51001,ipsc "$@" > /dev/null 2>&1
+  end=$(date +%s%N)
+  echo $((end - start))
+}
+
+# pkt/s and ns/pkt from the run over all packets and the one packet run
+rate()
+{
+  awk -v all="$1" -v one="$2" -v n="$PACKETS" 'BEGIN {
+    ns = (all - one) / (n - 1);
+    if (ns <= 0)
+      printf " %12s %9s", "-", "-";   # lost in the start up noise, more packets
+    else
+      printf " %12.0f %9.1f", 1e9 / ns, ns;
+  }'
+}
+
+echo "$PACKETS packets per case, $("$TSHARK" -v | head -1)"
+printf "%-36s %12s %9s %12s %9s %12s %9s\n" "" "no tree/s" "ns/pkt" "2 pass/s" "ns/pkt" "tree/s" "ns/pkt"
+
+while IFS="	" read -r file name; do
+  one="$dir/one/$(basename "$file")"
+
+  printf "%-36s" "$name"
+  rate "$(run -r "$file" -q)" "$(run -r "$one" -q)"
+  rate "$(run -r "$file" -2 -q)" "$(run -r "$one" -2 -q)"
+  rate "$(run -r "$file" -V)" "$(run -r "$one" -V)"
+  echo
+done < "$dir/cases"
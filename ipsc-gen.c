@@ -0,0 +1,896 @@
+/* ipsc-gen.c
+ * Synthetic IPSC traffic for load and scale testing
+ *
+ * Copyright by Bogdan Diaconesc yo3iiu@yo3iiu.ro
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * Writes a pcap of N repeaters in one IPSC network. Repeater 0 is the
+ * master; the others register with it, fetch the peer list, register
+ * with each other and then keep alive every 5 seconds. Each timeslot
+ * carries M calls at a time, every one from a repeater to all its
+ * peers: voice (3 Voice LC Headers, superframes of bursts A to F and
+ * a Terminator) or, for a share of them, a multi block PVT_DATA
+ * transfer of a UDP/IP datagram.
+ *
+ * Seq No, Call Seq No and the 8 kHz timestamps follow each stream,
+ * data headers carry a valid CRC and with -k every packet gets the
+ * HMAC-SHA1 Auth Digest that packet-ipsc.c checks. Packets are
+ * written as they are built, so the size of the capture is only
+ * bounded by -t and -s.
+ *
+ * cc -O2 -std=c99 -I. ipsc-gen.c -o ipsc-gen
+ */
+
+/* getopt(), 64 bit file offsets */
+#define _POSIX_C_SOURCE 200112L
+#define _FILE_OFFSET_BITS 64
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <unistd.h>
+
+#include "ipsc-wire.h"
+
+#define GEN_MAX_REPEATERS       1000
+#define GEN_MAX_PACKET          256
+
+#define GEN_TICK_US             30000       /* the two timeslots alternate every 30 ms */
+#define GEN_BURST_TICKS         2           /* one burst per slot every 60 ms */
+#define GEN_TIMESTAMP_STEP      480         /* 60 ms at 8 kHz */
+#define GEN_KEEPALIVE_US        5000000
+#define GEN_START_US            1000000     /* registration happens before */
+#define GEN_SPACING_US          20          /* between packets of one tick */
+
+#define GEN_KEY_LEN             20
+#define GEN_BASE_RADIO_ID       3100000
+#define GEN_DISPATCHER_ID       9999
+
+/* Rate 3/4 unconfirmed data blocks */
+#define GEN_DATA_BLOCK_LEN      18
+
+typedef enum {
+    GEN_IDLE,
+    GEN_VOICE,
+    GEN_DATA
+} gen_state_t;
+
+/* One call position: a timeslot that carries calls back to back */
+typedef struct _gen_call_t {
+    gen_state_t state;
+    int         position;           /* among the calls of this timeslot */
+    unsigned    count;              /* calls made so far */
+    int         repeater;
+    int         slot;               /* 1 or 2 */
+    uint32_t    src_id;
+    uint32_t    dst_id;
+    uint8_t     stream_id;          /* Seq No */
+    uint32_t    call_ctrl;
+    uint16_t    call_seq;
+    uint32_t    timestamp;
+    unsigned    step;               /* packets sent in this call */
+    unsigned    steps;              /* packets in this call */
+    uint64_t    next_us;            /* start of the next call */
+
+    /* Voice: embedded LC, sent over B to E of every superframe */
+    uint8_t     emb_lc[IPSC_EMB_LC_RAW_LEN];
+
+    /* Data transfer: header and blocks */
+    uint8_t     data[128 * GEN_DATA_BLOCK_LEN];
+    uint8_t     data_hdr[IPSC_BURST_LEN];
+} gen_call_t;
+
+/* SHA-1, FIPS 180-4 */
+typedef struct _gen_sha1_t {
+    uint32_t h[5];
+    uint64_t len;
+    uint8_t  buf[64];
+    size_t   used;
+} gen_sha1_t;
+
+typedef struct _gen_t {
+    FILE       *out;
+    uint64_t    bytes;
+    uint64_t    packets;
+    uint64_t    max_bytes;
+    uint64_t    end_us;
+    uint64_t    base_sec;
+    uint64_t    last_us;            /* keeps the capture in time order */
+
+    int         repeaters;
+    int         calls_per_slot;
+    int         data_percent;
+    uint16_t    port;
+    uint32_t    rng;
+    uint16_t    ip_id;
+
+    uint8_t     stream_id[GEN_MAX_REPEATERS];
+
+    int         auth;
+    gen_sha1_t  hmac_inner;         /* state after the padded key */
+    gen_sha1_t  hmac_outer;
+} gen_t;
+
+#define ROL32(v, n) (((v) << (n)) | ((v) >> (32 - (n))))
+
+static void
+gen_sha1_block(uint32_t h[5], const uint8_t *p)
+{
+    uint32_t w[80], a, b, c, d, e, f, k, t;
+    int i;
+
+    for (i = 0; i < 16; i++)
+      w[i] = ipsc_wire_get32(p + 4 * i);
+    for (i = 16; i < 80; i++)
+      w[i] = ROL32(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+
+    a = h[0]; b = h[1]; c = h[2]; d = h[3]; e = h[4];
+    for (i = 0; i < 80; i++)
+    {
+      if (i < 20)      { f = (b & c) | (~b & d);           k = 0x5a827999; }
+      else if (i < 40) { f = b ^ c ^ d;                    k = 0x6ed9eba1; }
+      else if (i < 60) { f = (b & c) | (b & d) | (c & d);  k = 0x8f1bbcdc; }
+      else             { f = b ^ c ^ d;                    k = 0xca62c1d6; }
+      t = ROL32(a, 5) + f + e + k + w[i];
+      e = d; d = c; c = ROL32(b, 30); b = a; a = t;
+    }
+    h[0] += a; h[1] += b; h[2] += c; h[3] += d; h[4] += e;
+}
+
+static void
+gen_sha1_init(gen_sha1_t *ctx)
+{
+    ctx->h[0] = 0x67452301;
+    ctx->h[1] = 0xefcdab89;
+    ctx->h[2] = 0x98badcfe;
+    ctx->h[3] = 0x10325476;
+    ctx->h[4] = 0xc3d2e1f0;
+    ctx->len = 0;
+    ctx->used = 0;
+}
+
+static void
+gen_sha1_update(gen_sha1_t *ctx, const uint8_t *p, size_t len)
+{
+    size_t n;
+
+    ctx->len += len;
+    while (len)
+    {
+      n = 64 - ctx->used;
+      if (n > len)
+        n = len;
+      memcpy(ctx->buf + ctx->used, p, n);
+      ctx->used += n;
+      p += n;
+      len -= n;
+      if (ctx->used == 64)
+      {
+        gen_sha1_block(ctx->h, ctx->buf);
+        ctx->used = 0;
+      }
+    }
+}
+
+static void
+gen_sha1_final(gen_sha1_t *ctx, uint8_t digest[20])
+{
+    uint64_t bits = ctx->len * 8;
+    uint8_t pad = 0x80;
+    uint8_t len[8];
+    int i;
+
+    gen_sha1_update(ctx, &pad, 1);
+    pad = 0;
+    while (ctx->used != 56)
+      gen_sha1_update(ctx, &pad, 1);
+    for (i = 0; i < 8; i++)
+      len[i] = (uint8_t)(bits >> (56 - 8 * i));
+    gen_sha1_update(ctx, len, 8);
+
+    for (i = 0; i < 20; i++)
+      digest[i] = (uint8_t)(ctx->h[i / 4] >> (24 - 8 * (i % 4)));
+}
+
+/* Both HMAC pads are hashed once, per packet only the packet is */
+static void
+gen_hmac_key(gen_t *gen, const uint8_t key[GEN_KEY_LEN])
+{
+    uint8_t pad[64];
+    int i;
+
+    memset(pad, 0, sizeof(pad));
+    memcpy(pad, key, GEN_KEY_LEN);
+    for (i = 0; i < 64; i++)
+      pad[i] ^= 0x36;
+    gen_sha1_init(&gen->hmac_inner);
+    gen_sha1_update(&gen->hmac_inner, pad, 64);
+
+    for (i = 0; i < 64; i++)
+      pad[i] ^= 0x36 ^ 0x5c;
+    gen_sha1_init(&gen->hmac_outer);
+    gen_sha1_update(&gen->hmac_outer, pad, 64);
+
+    gen->auth = 1;
+}
+
+static void
+gen_digest(const gen_t *gen, const uint8_t *p, size_t len, uint8_t *digest)
+{
+    gen_sha1_t ctx;
+    uint8_t inner[20], outer[20];
+
+    ctx = gen->hmac_inner;
+    gen_sha1_update(&ctx, p, len);
+    gen_sha1_final(&ctx, inner);
+
+    ctx = gen->hmac_outer;
+    gen_sha1_update(&ctx, inner, sizeof(inner));
+    gen_sha1_final(&ctx, outer);
+
+    memcpy(digest, outer, IPSC_AUTH_DIGEST_LEN);
+}
+
+static void
+put16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)(v >> 8);
+    p[1] = (uint8_t)v;
+}
+
+static void
+put24(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)(v >> 16);
+    put16(p + 1, (uint16_t)v);
+}
+
+static void
+put32(uint8_t *p, uint32_t v)
+{
+    put16(p, (uint16_t)(v >> 16));
+    put16(p + 2, (uint16_t)v);
+}
+
+/* xorshift32, the same seed gives the same capture */
+static uint32_t
+gen_random(gen_t *gen, uint32_t range)
+{
+    gen->rng ^= gen->rng << 13;
+    gen->rng ^= gen->rng >> 17;
+    gen->rng ^= gen->rng << 5;
+    return range ? gen->rng % range : gen->rng;
+}
+
+static uint32_t
+gen_rpt_id(int repeater)
+{
+    return 312000 + repeater;
+}
+
+static uint32_t
+gen_ip(int repeater)
+{
+    return 0x0a000000 | (uint32_t)(repeater + 1);
+}
+
+/* Message CRC-32 of the data blocks, not checked by the dissector */
+static uint32_t
+gen_crc32(const uint8_t *p, size_t len)
+{
+    uint32_t crc = 0;
+    int i;
+
+    while (len--)
+    {
+      crc ^= (uint32_t)*p++ << 24;
+      for (i = 0; i < 8; i++)
+        crc = (crc & 0x80000000) ? (crc << 1) ^ 0x04c11db7 : crc << 1;
+    }
+    return crc;
+}
+
+static void
+gen_write(gen_t *gen, const void *p, size_t len)
+{
+    if (fwrite(p, 1, len, gen->out) != len)
+    {
+      perror("ipsc-gen: write");
+      exit(1);
+    }
+    gen->bytes += len;
+}
+
+/* pcap in native byte order, readers tell it from the magic */
+static void
+gen_pcap_header(gen_t *gen)
+{
+    uint32_t magic = 0xa1b2c3d4;
+    uint16_t version[2] = { 2, 4 };
+    uint32_t rest[4] = { 0, 0, 65535, 1 };  /* thiszone, sigfigs, snaplen, Ethernet */
+
+    gen_write(gen, &magic, sizeof(magic));
+    gen_write(gen, version, sizeof(version));
+    gen_write(gen, rest, sizeof(rest));
+}
+
+/*
+ * Send an IPSC message from one repeater to another: append the Auth
+ * Digest and write it as Ethernet/IPv4/UDP.
+ */
+static void
+gen_send(gen_t *gen, int from, int to, uint8_t *msg, size_t len, uint64_t time_us)
+{
+    uint8_t frame[14 + 20 + 8 + GEN_MAX_PACKET];
+    uint8_t *ip = frame + 14, *udp = frame + 34;
+    uint32_t rec[4], sum = 0;
+    int i;
+
+    /* Bursts of packets that do not fit their slot push the rest back */
+    if (gen->packets && time_us <= gen->last_us)
+      time_us = gen->last_us + 1;
+    gen->last_us = time_us;
+
+    if (gen->auth)
+    {
+      gen_digest(gen, msg, len, msg + len);
+      len += IPSC_AUTH_DIGEST_LEN;
+    }
+
+    /* Ethernet */
+    memcpy(frame, "\x02\x00\x00\x00", 4);
+    put16(frame + 4, (uint16_t)to);
+    memcpy(frame + 6, "\x02\x00\x00\x00", 4);
+    put16(frame + 10, (uint16_t)from);
+    put16(frame + 12, 0x0800);
+
+    /* IPv4, no options */
+    ip[0] = 0x45;
+    ip[1] = 0;
+    put16(ip + 2, (uint16_t)(20 + 8 + len));
+    put16(ip + 4, gen->ip_id++);
+    put16(ip + 6, 0x4000);
+    ip[8] = 64;
+    ip[9] = 17;
+    put16(ip + 10, 0);
+    put32(ip + 12, gen_ip(from));
+    put32(ip + 16, gen_ip(to));
+    for (i = 0; i < 20; i += 2)
+      sum += ipsc_wire_get16(ip + i);
+    while (sum >> 16)
+      sum = (sum & 0xffff) + (sum >> 16);
+    put16(ip + 10, (uint16_t)~sum);
+
+    /* UDP, no checksum */
+    put16(udp, gen->port);
+    put16(udp + 2, gen->port);
+    put16(udp + 4, (uint16_t)(8 + len));
+    put16(udp + 6, 0);
+
+    memcpy(udp + 8, msg, len);
+
+    rec[0] = (uint32_t)(gen->base_sec + time_us / 1000000);
+    rec[1] = (uint32_t)(time_us % 1000000);
+    rec[2] = rec[3] = (uint32_t)(42 + len);
+    gen_write(gen, rec, sizeof(rec));
+    gen_write(gen, frame, 42 + len);
+
+    gen->packets++;
+}
+
+/* Registration and keepalives share one layout */
+static size_t
+gen_build_reg(gen_t *gen, uint8_t *p, uint8_t opcode, int repeater)
+{
+    p[IPSC_OFF_OPCODE] = opcode;
+    put32(p + IPSC_OFF_RPT_ID, gen_rpt_id(repeater));
+    /* Peer operational, peer mode, both slots IPSC */
+    p[IPSC_REG_OFF_LINKING] = 0x6a;
+    p[IPSC_REG_OFF_SERVICE_FLAGS] = 0x00;
+    p[IPSC_REG_OFF_SERVICE_FLAGS + 1] = 0x00;
+    p[IPSC_REG_OFF_SERVICE_FLAGS + 2] = 0x00;
+    p[IPSC_REG_OFF_SERVICE_FLAGS + 3] = IPSC_FLAGS4_VOICE | IPSC_FLAGS4_DATA |
+                                        (gen->auth ? IPSC_FLAGS4_AUTH : 0) |
+                                        (repeater == 0 ? IPSC_FLAGS4_MASTER : 0);
+    put32(p + IPSC_REG_OFF_VERSION, 0x04020401);
+    return IPSC_REG_LEN;
+}
+
+/* A request and its reply */
+static void
+gen_exchange(gen_t *gen, int from, int to, uint8_t req, uint8_t reply, uint64_t time_us)
+{
+    uint8_t p[GEN_MAX_PACKET];
+    size_t len;
+
+    len = gen_build_reg(gen, p, req, from);
+    gen_send(gen, from, to, p, len, time_us);
+    len = gen_build_reg(gen, p, reply, to);
+    gen_send(gen, to, from, p, len, time_us + GEN_SPACING_US / 2);
+}
+
+/* PEER_LIST_REQ to the master and its PEER_LIST_REPLY */
+static void
+gen_peer_list(gen_t *gen, int peer, uint64_t time_us)
+{
+    uint8_t p[IPSC_PEER_LIST_OFF_ENTRIES + IPSC_PEER_LEN * GEN_MAX_REPEATERS + IPSC_AUTH_DIGEST_LEN];
+    uint8_t *entry;
+    int i;
+
+    p[IPSC_OFF_OPCODE] = 0x92;
+    put32(p + IPSC_OFF_RPT_ID, gen_rpt_id(peer));
+    gen_send(gen, peer, 0, p, IPSC_SHORT_LEN, time_us);
+
+    /* Peer Id, IP, port and linking of every peer but the master */
+    p[IPSC_OFF_OPCODE] = 0x93;
+    put32(p + IPSC_OFF_RPT_ID, gen_rpt_id(0));
+    put16(p + IPSC_PEER_LIST_OFF_LENGTH, (uint16_t)(IPSC_PEER_LEN * (gen->repeaters - 1)));
+    entry = p + IPSC_PEER_LIST_OFF_ENTRIES;
+    for (i = 1; i < gen->repeaters; i++, entry += IPSC_PEER_LEN)
+    {
+      put32(entry + IPSC_PEER_OFF_RPT_ID, gen_rpt_id(i));
+      put32(entry + IPSC_PEER_OFF_IP, gen_ip(i));
+      put16(entry + IPSC_PEER_OFF_PORT, gen->port);
+      entry[IPSC_PEER_OFF_LINKING] = 0x6a;
+    }
+
+    /* Large networks do not fit one datagram, the list is cut */
+    if (entry - p > GEN_MAX_PACKET - IPSC_AUTH_DIGEST_LEN)
+    {
+      entry = p + (GEN_MAX_PACKET - IPSC_AUTH_DIGEST_LEN - IPSC_PEER_LIST_OFF_ENTRIES) / IPSC_PEER_LEN * IPSC_PEER_LEN +
+              IPSC_PEER_LIST_OFF_ENTRIES;
+      put16(p + IPSC_PEER_LIST_OFF_LENGTH, (uint16_t)(entry - p - IPSC_PEER_LIST_OFF_ENTRIES));
+    }
+    gen_send(gen, 0, peer, p, (size_t)(entry - p), time_us + 500);
+}
+
+/* Every peer registers with the master, gets the peer list and registers with the other peers */
+static void
+gen_registration(gen_t *gen)
+{
+    uint64_t t = 0;
+    int i, j;
+
+    for (i = 1; i < gen->repeaters; i++)
+    {
+      gen_exchange(gen, i, 0, 0x90, 0x91, t);
+      gen_peer_list(gen, i, t + 2000);
+      t += 5000;
+
+      for (j = 1; j < i; j++)
+      {
+        gen_exchange(gen, i, j, 0x94, 0x95, t);
+        t += 1000;
+      }
+    }
+}
+
+static void
+gen_keepalive(gen_t *gen, uint64_t time_us)
+{
+    uint64_t t = time_us;
+    int i, j;
+
+    for (i = 1; i < gen->repeaters; i++)
+    {
+      gen_exchange(gen, i, 0, 0x96, 0x97, t);
+      t += GEN_SPACING_US;
+
+      for (j = 1; j < gen->repeaters; j++)
+      {
+        if (j == i)
+          continue;
+        gen_exchange(gen, i, j, 0x98, 0x99, t);
+        t += GEN_SPACING_US;
+      }
+    }
+}
+
+/* Call header, up to and including Data Type */
+static void
+gen_build_call_hdr(gen_call_t *call, uint8_t *p, uint8_t opcode, uint8_t data_type, int last)
+{
+    p[IPSC_OFF_OPCODE] = opcode;
+    put32(p + IPSC_OFF_RPT_ID, gen_rpt_id(call->repeater));
+    p[IPSC_CALL_OFF_SEQ_NO] = call->stream_id;
+    put24(p + IPSC_CALL_OFF_SRC_ID, call->src_id);
+    put24(p + IPSC_CALL_OFF_DST_ID, call->dst_id);
+    p[IPSC_CALL_OFF_PRIO] = (opcode == 0x80) ? 0x02 : 0x01;
+    put32(p + IPSC_CALL_OFF_CALL_CTRL, call->call_ctrl);
+    p[IPSC_CALL_OFF_CALL_CTRL_INFO] = (call->slot == 2 ? IPSC_CALL_CTRL_INFO_SLOT2 : 0) | (last ? 0x40 : 0);
+    p[IPSC_CALL_OFF_CALL_CTRL_SRC] = 0x01;
+    p[IPSC_CALL_OFF_PAYLOAD_TYPE] = last ? 0x5e : 0x5d;
+    put16(p + IPSC_CALL_OFF_CALL_SEQ_NO, call->call_seq++);
+    put32(p + IPSC_CALL_OFF_TIMESTAMP, call->timestamp);
+    put32(p + IPSC_CALL_OFF_SYNC_SRC, 0);
+    p[IPSC_CALL_OFF_DATA_TYPE] = data_type | (call->slot == 2 ? 0x80 : 0);
+
+    call->timestamp += GEN_TIMESTAMP_STEP;
+}
+
+/* A 96 bit burst after the call header */
+static size_t
+gen_build_burst(gen_t *gen, uint8_t *p, const uint8_t *burst, size_t len)
+{
+    p[IPSC_CALL_OFF_RSSI_THRESHOLD] = 0;
+    put16(p + IPSC_CALL_OFF_LENGTH_TO_FOLLOW, (uint16_t)((len + 4) / 2));
+    p[IPSC_CALL_OFF_RSSI_STATUS] = (uint8_t)(0x60 + gen_random(gen, 0x20));
+    p[IPSC_CALL_OFF_SLOT_TYPE_SYNC] = 0x40;
+    put16(p + IPSC_CALL_OFF_DATA_SIZE, (uint16_t)(len * 8));
+    memcpy(p + IPSC_CALL_OFF_PAYLOAD, burst, len);
+    return IPSC_CALL_DATA_LEN + len;
+}
+
+/* Full LC of a group voice call; the RS(12,9) parity is left zero */
+static void
+gen_build_full_lc(const gen_call_t *call, uint8_t *lc)
+{
+    memset(lc, 0, IPSC_BURST_LEN);
+    lc[0] = 0x00;               /* Group Voice Channel User */
+    lc[1] = 0x00;               /* Standard FID */
+    lc[2] = 0x00;               /* Service Options */
+    put24(lc + 3, call->dst_id);
+    put24(lc + 6, call->src_id);
+}
+
+/* Embedded LC of the call, B.2.1: the Full LC less its parity */
+static void
+gen_build_emb_lc(const gen_call_t *call, uint8_t *raw)
+{
+    uint8_t lc[IPSC_BURST_LEN];
+
+    gen_build_full_lc(call, lc);
+    ipsc_wire_emb_lc_encode(lc, raw);
+}
+
+static size_t
+gen_build_voice(gen_t *gen, gen_call_t *call, uint8_t *p, unsigned burst)
+{
+    uint8_t *v = p + IPSC_CALL_OFF_PAYLOAD2;
+    size_t len;
+    int i;
+
+    gen_build_call_hdr(call, p, 0x80, IPSC_DATA_TYPE_RATE_1, 0);
+
+    v[IPSC_VOICE_OFF_BURST] = (uint8_t)burst;
+    for (i = 0; i < IPSC_VOICE_AMBE_FRAMES * IPSC_VOICE_AMBE_FRAME_LEN; i++)
+      v[IPSC_VOICE_OFF_AMBE + i] = (uint8_t)gen_random(gen, 256);
+
+    /* B to E carry the EMB and a quarter of the embedded LC */
+    if (burst >= 1 && burst <= 4)
+    {
+      static const uint8_t lcss[4] = { 1, 3, 3, 2 };
+
+      /* Colour code 1, no privacy, LCSS and the QR(16,7,6) parity */
+      put16(v + IPSC_VOICE_OFF_EMB, (uint16_t)ipsc_wire_fec_encode(IPSC_FEC_QR_16_7, 0x08 | lcss[burst - 1]));
+      memcpy(v + IPSC_VOICE_OFF_EMBEDDED, call->emb_lc + 4 * (burst - 1), 4);
+      len = IPSC_VOICE_EMBEDDED_LEN;
+    }
+    else
+    {
+      len = IPSC_VOICE_LEN;
+    }
+
+    p[IPSC_CALL_OFF_LENGTH2] = (uint8_t)len;
+    return IPSC_CALL_OFF_PAYLOAD2 + len;
+}
+
+/*
+ * A UDP/IP datagram from the radio to the dispatcher, as Rate 3/4
+ * unconfirmed blocks behind a Data Header.
+ */
+static void
+gen_start_data(gen_t *gen, gen_call_t *call)
+{
+    uint8_t *ip = call->data, *hdr = call->data_hdr;
+    size_t len, total, pad, i;
+    unsigned blocks;
+    uint32_t crc;
+
+    len = 20 + 8 + 16 + gen_random(gen, 48);
+
+    /* IPv4 from the radio's CAI address, UDP to port 4001 */
+    memset(ip, 0, 28);
+    ip[0] = 0x45;
+    put16(ip + 2, (uint16_t)len);
+    ip[8] = 64;
+    ip[9] = 17;
+    put32(ip + 12, 0x0c000000 | call->src_id);
+    put32(ip + 16, 0x0d000000 | call->dst_id);
+    put16(ip + 20, 4001);
+    put16(ip + 22, 4001);
+    put16(ip + 24, (uint16_t)(len - 20));
+    for (i = 28; i < len; i++)
+      ip[i] = (uint8_t)gen_random(gen, 256);
+
+    /* User data, pad octets and the message CRC-32 fill whole blocks */
+    blocks = (unsigned)((len + 4 + GEN_DATA_BLOCK_LEN - 1) / GEN_DATA_BLOCK_LEN);
+    total = blocks * GEN_DATA_BLOCK_LEN;
+    pad = total - len - 4;
+    memset(ip + len, 0, pad);
+    crc = gen_crc32(ip, len + pad);
+    put32(ip + total - 4, crc);
+
+    /* Data Header: individual, unconfirmed, SAP IP */
+    hdr[0] = (uint8_t)((pad & 0x10) | 0x02);
+    hdr[1] = (uint8_t)(0x40 | (pad & 0x0f));
+    put24(hdr + 2, call->dst_id);
+    put24(hdr + 5, call->src_id);
+    hdr[8] = (uint8_t)(0x80 | blocks);
+    hdr[9] = 0x00;
+    put16(hdr + 10, ipsc_wire_burst_crc(hdr, IPSC_CRC_MASK_DATA_HDR));
+
+    call->state = GEN_DATA;
+    call->steps = 1 + blocks;
+}
+
+static void
+gen_start_call(gen_t *gen, gen_call_t *call)
+{
+    /* Calls that share a timeslot are on different repeaters while M <= N */
+    call->repeater = (int)((call->position + call->count++ * gen->calls_per_slot) % gen->repeaters);
+    call->stream_id = gen->stream_id[call->repeater]++;
+    call->call_ctrl = gen_random(gen, 0);
+    call->call_seq = (uint16_t)gen_random(gen, 0x10000);
+    call->timestamp = gen_random(gen, 0);
+    call->src_id = GEN_BASE_RADIO_ID + call->repeater * 1000 + gen_random(gen, 1000);
+    call->step = 0;
+
+    if ((int)gen_random(gen, 100) < gen->data_percent)
+    {
+      call->dst_id = GEN_DISPATCHER_ID;
+      gen_start_data(gen, call);
+    }
+    else
+    {
+      /* 2 to 10 seconds of superframes */
+      call->dst_id = 1 + gen_random(gen, 10);
+      call->state = GEN_VOICE;
+      call->steps = 3 + IPSC_VOICE_BURSTS * (6 + gen_random(gen, 28)) + 1;
+      gen_build_emb_lc(call, call->emb_lc);
+    }
+}
+
+/* The next packet of a call, sent to every peer */
+static void
+gen_step_call(gen_t *gen, gen_call_t *call, uint64_t time_us)
+{
+    uint8_t p[GEN_MAX_PACKET], burst[IPSC_BURST_LEN];
+    size_t len;
+    unsigned step = call->step;
+    int to;
+
+    if (call->state == GEN_VOICE)
+    {
+      if (step < 3)
+      {
+        gen_build_call_hdr(call, p, 0x80, IPSC_DATA_TYPE_VOICE_LC_HDR, 0);
+        gen_build_full_lc(call, burst);
+        len = gen_build_burst(gen, p, burst, IPSC_BURST_LEN);
+      }
+      else if (step == call->steps - 1)
+      {
+        gen_build_call_hdr(call, p, 0x80, IPSC_DATA_TYPE_TERMINATOR_LC, 1);
+        gen_build_full_lc(call, burst);
+        len = gen_build_burst(gen, p, burst, IPSC_BURST_LEN);
+      }
+      else
+      {
+        len = gen_build_voice(gen, call, p, (step - 3) % IPSC_VOICE_BURSTS);
+      }
+    }
+    else
+    {
+      if (step == 0)
+      {
+        gen_build_call_hdr(call, p, 0x84, IPSC_DATA_TYPE_DATA_HDR, 0);
+        len = gen_build_burst(gen, p, call->data_hdr, IPSC_BURST_LEN);
+      }
+      else
+      {
+        gen_build_call_hdr(call, p, 0x84, IPSC_DATA_TYPE_RATE_34, step == call->steps - 1);
+        len = gen_build_burst(gen, p, call->data + (step - 1) * GEN_DATA_BLOCK_LEN, GEN_DATA_BLOCK_LEN);
+      }
+    }
+
+    for (to = 0; to < gen->repeaters; to++)
+    {
+      if (to == call->repeater)
+        continue;
+      gen_send(gen, call->repeater, to, p, len, time_us);
+      time_us += GEN_SPACING_US;
+    }
+
+    if (++call->step == call->steps)
+      call->state = GEN_IDLE;
+}
+
+static uint64_t
+gen_parse_size(const char *s)
+{
+    char *end;
+    uint64_t v = strtoull(s, &end, 10);
+
+    switch (toupper((unsigned char)*end))
+    {
+      case 'K': return v << 10;
+      case 'M': return v << 20;
+      case 'G': return v << 30;
+      default:  return v;
+    }
+}
+
+/* Hex key, right aligned like packet-ipsc.c does */
+static int
+gen_parse_key(gen_t *gen, const char *s)
+{
+    uint8_t key[GEN_KEY_LEN];
+    size_t len = strlen(s), j;
+
+    if (len == 0 || len > 2 * GEN_KEY_LEN)
+      return 0;
+
+    memset(key, 0, sizeof(key));
+    for (j = 0; j < len; j++)
+    {
+      int c = (unsigned char)s[len - 1 - j];
+
+      if (!isxdigit(c))
+        return 0;
+      c = isdigit(c) ? c - '0' : tolower(c) - 'a' + 10;
+      key[GEN_KEY_LEN - 1 - j / 2] |= (uint8_t)(c << ((j & 1) ? 4 : 0));
+    }
+
+    gen_hmac_key(gen, key);
+    return 1;
+}
+
+static void
+usage(void)
+{
+    fprintf(stderr,
+            "usage: ipsc-gen -w file.pcap [options]\n"
+            "  -r N      repeaters, the first is the master (default 4)\n"
+            "  -c M      calls at a time on each timeslot (default 1)\n"
+            "  -t secs   capture length (default 60, or until -s)\n"
+            "  -s size   stop at this file size, K/M/G suffix\n"
+            "  -d pct    share of calls that are data transfers (default 10)\n"
+            "  -k key    network key in hex, adds the Auth Digest\n"
+            "  -p port   UDP port (default 51001)\n"
+            "  -S seed   random seed (default 1)\n");
+    exit(1);
+}
+
+int
+main(int argc, char **argv)
+{
+    static gen_t gen;
+    gen_call_t *calls;
+    const char *file = NULL;
+    uint64_t t, next_keepalive;
+    unsigned long seconds = 0;
+    unsigned tick = 0;
+    int ncalls, i, opt;
+
+    gen.repeaters = 4;
+    gen.calls_per_slot = 1;
+    gen.data_percent = 10;
+    gen.port = 51001;
+    gen.rng = 1;
+    gen.base_sec = 1700000000;
+
+    while ((opt = getopt(argc, argv, "w:r:c:t:s:d:k:p:S:")) != -1)
+    {
+      switch (opt)
+      {
+        case 'w': file = optarg; break;
+        case 'r': gen.repeaters = atoi(optarg); break;
+        case 'c': gen.calls_per_slot = atoi(optarg); break;
+        case 't': seconds = strtoul(optarg, NULL, 10); break;
+        case 's': gen.max_bytes = gen_parse_size(optarg); break;
+        case 'd': gen.data_percent = atoi(optarg); break;
+        case 'k':
+          if (!gen_parse_key(&gen, optarg))
+          {
+            fprintf(stderr, "ipsc-gen: the key must be 1 to 40 hex digits\n");
+            return 1;
+          }
+          break;
+        case 'p': gen.port = (uint16_t)atoi(optarg); break;
+        case 'S': gen.rng = (uint32_t)strtoul(optarg, NULL, 0) | 1; break;
+        default: usage();
+      }
+    }
+
+    if (!file || gen.repeaters < 2 || gen.repeaters > GEN_MAX_REPEATERS || gen.calls_per_slot < 0)
+      usage();
+
+    if (!seconds && !gen.max_bytes)
+      seconds = 60;
+    gen.end_us = seconds ? (uint64_t)seconds * 1000000 : UINT64_MAX;
+    if (!gen.max_bytes)
+      gen.max_bytes = UINT64_MAX;
+
+    if ((gen.out = fopen(file, "wb")) == NULL)
+    {
+      perror(file);
+      return 1;
+    }
+
+    /* M positions per timeslot, each carries one call after the other */
+    ncalls = 2 * gen.calls_per_slot;
+    calls = (gen_call_t *)calloc(ncalls ? ncalls : 1, sizeof(gen_call_t));
+    if (!calls)
+    {
+      fprintf(stderr, "ipsc-gen: out of memory\n");
+      return 1;
+    }
+    for (i = 0; i < ncalls; i++)
+    {
+      calls[i].slot = 1 + i / gen.calls_per_slot;
+      calls[i].position = i % gen.calls_per_slot;
+      calls[i].next_us = GEN_START_US + gen_random(&gen, 2000000);
+    }
+
+    gen_pcap_header(&gen);
+    gen_registration(&gen);
+
+    next_keepalive = GEN_KEEPALIVE_US;
+    for (t = GEN_START_US; t < gen.end_us && gen.bytes < gen.max_bytes; t += GEN_TICK_US, tick++)
+    {
+      if (t >= next_keepalive)
+      {
+        gen_keepalive(&gen, t);
+        next_keepalive += GEN_KEEPALIVE_US;
+      }
+
+      /* Slot 1 on even ticks, slot 2 on odd ones */
+      for (i = 0; i < ncalls; i++)
+      {
+        gen_call_t *call = &calls[i];
+
+        if ((tick % GEN_BURST_TICKS) != (unsigned)(call->slot - 1))
+          continue;
+
+        if (call->state == GEN_IDLE)
+        {
+          if (t < call->next_us)
+            continue;
+          gen_start_call(&gen, call);
+        }
+
+        gen_step_call(&gen, call, t + 2000 + i * 200);
+
+        /* 1 to 5 seconds between calls */
+        if (call->state == GEN_IDLE)
+          call->next_us = t + 1000000 + gen_random(&gen, 4000000);
+      }
+    }
+
+    if (fclose(gen.out) != 0)
+    {
+      perror(file);
+      return 1;
+    }
+
+    fprintf(stderr, "ipsc-gen: %llu packets, %llu bytes\n",
+            (unsigned long long)gen.packets, (unsigned long long)gen.bytes);
+    free(calls);
+    return 0;
+}
@@ -0,0 +1,590 @@
+/* ipsc-wire-bench.c
+ * Decode throughput of ipsc-wire.h, per opcode
+ *
+ * Copyright by Bogdan Diaconesc yo3iiu@yo3iiu.ro
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * Builds one synthetic packet per opcode and data type and runs it
+ * through the decode paths of ipsc-wire.h that packet-ipsc.c uses:
+ *
+ *  summary  the decode of dissect_ipsc_summary(), which runs on every
+ *           pass without a tree: opcode, rpt id, call header, RSSI,
+ *           CSBKO and FID, voice burst and EMB, linking and service
+ *           flags; the FEC of raw bursts runs once on the first pass
+ *           and is left out
+ *  full     every field the tree shows, read but not added to a tree
+ *
+ * This does not run the dissector. The tvb, the tree, the Info column,
+ * call tracking and the taps are not timed here; with -w the same
+ * cases are written as one pcap each instead, and ipsc-bench.sh feeds
+ * them through dissect_ipsc() in tshark, with and without a tree.
+ *
+ * cc -O2 -std=c99 -I. ipsc-wire-bench.c -o ipsc-wire-bench
+ * ./ipsc-wire-bench [packets per case]
+ * ./ipsc-wire-bench -w dir [packets per case]
+ */
+
+/* clock_gettime() */
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "ipsc-wire.h"
+
+#define BENCH_DEFAULT_PACKETS   2000000
+#define BENCH_MAX_LEN           128
+#define BENCH_PORT              51001
+#define BENCH_BURST_US          60000       /* one packet per burst */
+
+typedef struct _bench_case_t {
+    const char *name;
+    uint8_t     data[BENCH_MAX_LEN];
+    size_t      len;
+} bench_case_t;
+
+/* Keeps the compiler from dropping the decode */
+static volatile uint32_t bench_sink;
+
+static void
+put16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)(v >> 8);
+    p[1] = (uint8_t)v;
+}
+
+static void
+put24(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)(v >> 16);
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)v;
+}
+
+static void
+put32(uint8_t *p, uint32_t v)
+{
+    put16(p, (uint16_t)(v >> 16));
+    put16(p + 2, (uint16_t)v);
+}
+
+/* Opcode, Rpt Id, a body of body_len octets and the Auth Digest */
+static void
+build_simple(bench_case_t *bc, const char *name, uint8_t opcode, size_t body_len)
+{
+    size_t i;
+
+    bc->name = name;
+    memset(bc->data, 0, sizeof(bc->data));
+    bc->data[IPSC_OFF_OPCODE] = opcode;
+    put32(bc->data + IPSC_OFF_RPT_ID, 312000);
+    for (i = IPSC_SHORT_LEN; i < body_len + IPSC_AUTH_DIGEST_LEN; i++)
+      bc->data[i] = (uint8_t)(i * 37);
+    bc->len = body_len + IPSC_AUTH_DIGEST_LEN;
+}
+
+static void
+build_xcmp(bench_case_t *bc)
+{
+    uint8_t *xnl;
+
+    /* An XNL data message with an XCMP Radio Status request */
+    build_simple(bc, "0x70 XCMP_XNL", 0x70, IPSC_XNL_OFF_DATA + 20);
+    put16(bc->data + IPSC_XNL_OFF_LENGTH, 20);
+    xnl = bc->data + IPSC_XNL_OFF_DATA;
+    put16(xnl + IPSC_XNL_HDR_OFF_OPCODE, IPSC_XNL_OPCODE_DATA_MSG);
+    xnl[IPSC_XNL_HDR_OFF_PROTO] = IPSC_XNL_PROTO_XCMP;
+    put16(xnl + IPSC_XNL_HDR_OFF_PAYLOAD_LEN, 20 - IPSC_XNL_HDR_LEN);
+    put16(xnl + IPSC_XNL_HDR_LEN, 0x000e);
+}
+
+static void
+build_reg(bench_case_t *bc, const char *name, uint8_t opcode)
+{
+    build_simple(bc, name, opcode, IPSC_REG_LEN);
+    bc->data[IPSC_REG_OFF_LINKING] = 0x6a;
+    put32(bc->data + IPSC_REG_OFF_SERVICE_FLAGS, 0x000020dc);
+    put32(bc->data + IPSC_REG_OFF_VERSION, 0x04020401);
+}
+
+/* Eight peers, as the master lists them */
+static void
+build_peer_list(bench_case_t *bc)
+{
+    uint8_t *entry;
+    int i;
+
+    build_simple(bc, "0x93 PEER_LIST_REPLY", 0x93, IPSC_PEER_LIST_OFF_ENTRIES + 8 * IPSC_PEER_LEN);
+    put16(bc->data + IPSC_PEER_LIST_OFF_LENGTH, 8 * IPSC_PEER_LEN);
+    for (i = 0, entry = bc->data + IPSC_PEER_LIST_OFF_ENTRIES; i < 8; i++, entry += IPSC_PEER_LEN)
+    {
+      put32(entry + IPSC_PEER_OFF_RPT_ID, 312001 + i);
+      put32(entry + IPSC_PEER_OFF_IP, 0x0a000002 + i);
+      put16(entry + IPSC_PEER_OFF_PORT, 51001);
+      entry[IPSC_PEER_OFF_LINKING] = 0x6a;
+    }
+}
+
+/* Call header and a 12 octet burst, or Rate 1 data */
+static void
+build_call(bench_case_t *bc, const char *name, uint8_t opcode, uint8_t data_type, const uint8_t *burst)
+{
+    uint8_t *p = bc->data;
+    size_t body_len;
+
+    build_simple(bc, name, opcode, IPSC_CALL_DATA_LEN + IPSC_BURST_LEN);
+
+    p[IPSC_CALL_OFF_SEQ_NO] = 0x2a;
+    put24(p + IPSC_CALL_OFF_SRC_ID, 3120101);
+    put24(p + IPSC_CALL_OFF_DST_ID, 9);
+    p[IPSC_CALL_OFF_PRIO] = 0x02;
+    put32(p + IPSC_CALL_OFF_CALL_CTRL, 0x00001234);
+    p[IPSC_CALL_OFF_CALL_CTRL_INFO] = IPSC_CALL_CTRL_INFO_SLOT2;
+    p[IPSC_CALL_OFF_CALL_CTRL_SRC] = 0x01;
+    p[IPSC_CALL_OFF_PAYLOAD_TYPE] = 0x5d;
+    put16(p + IPSC_CALL_OFF_CALL_SEQ_NO, 4711);
+    put32(p + IPSC_CALL_OFF_TIMESTAMP, 480000);
+    put32(p + IPSC_CALL_OFF_SYNC_SRC, 0);
+    p[IPSC_CALL_OFF_DATA_TYPE] = data_type;
+
+    if (opcode == 0x80 && data_type == IPSC_DATA_TYPE_RATE_1)
+    {
+      p[IPSC_CALL_OFF_LENGTH2] = 24;
+      body_len = IPSC_CALL_OFF_PAYLOAD2 + 24;
+    }
+    else
+    {
+      p[IPSC_CALL_OFF_RSSI_THRESHOLD] = 0x00;
+      /* RSSI Status, Slot Type Sync, Data Size and the burst */
+      put16(p + IPSC_CALL_OFF_LENGTH_TO_FOLLOW, (IPSC_BURST_LEN + 4) / 2);
+      p[IPSC_CALL_OFF_RSSI_STATUS] = 0x80;
+      p[IPSC_CALL_OFF_SLOT_TYPE_SYNC] = 0x40;
+      put16(p + IPSC_CALL_OFF_DATA_SIZE, IPSC_BURST_LEN * 8);
+      memcpy(p + IPSC_CALL_OFF_PAYLOAD, burst, IPSC_BURST_LEN);
+      body_len = IPSC_CALL_DATA_LEN + IPSC_BURST_LEN;
+    }
+
+    memset(p + body_len, 0xa5, IPSC_AUTH_DIGEST_LEN);
+    bc->len = body_len + IPSC_AUTH_DIGEST_LEN;
+}
+
+/* The same call with the burst as sent on the air, BPTC(196,96) and slot type */
+static void
+build_raw_burst(bench_case_t *bc, const char *name, uint8_t opcode, uint8_t data_type, const uint8_t *burst)
+{
+    uint8_t *p = bc->data;
+    size_t body_len = IPSC_CALL_DATA_LEN + IPSC_RAW_BURST_LEN + 1;
+
+    build_call(bc, name, opcode, data_type, burst);
+
+    /* Length to Follow is in words, the burst gets a pad octet */
+    put16(p + IPSC_CALL_OFF_LENGTH_TO_FOLLOW, (IPSC_RAW_BURST_LEN + 1 + 4) / 2);
+    put16(p + IPSC_CALL_OFF_DATA_SIZE, IPSC_RAW_BURST_BITS);
+    memset(p + IPSC_CALL_OFF_PAYLOAD, 0, IPSC_RAW_BURST_LEN + 1);
+    ipsc_wire_bptc_encode(burst, p + IPSC_CALL_OFF_PAYLOAD);
+    ipsc_wire_slot_type_encode((uint8_t)(0x10 | data_type), p + IPSC_CALL_OFF_PAYLOAD);
+
+    /* A bit error in the BPTC and one in the slot type */
+    p[IPSC_CALL_OFF_PAYLOAD + 5] ^= 0x10;
+    p[IPSC_CALL_OFF_PAYLOAD + 20] ^= 0x40;
+
+    memset(p + body_len, 0xa5, IPSC_AUTH_DIGEST_LEN);
+    bc->len = body_len + IPSC_AUTH_DIGEST_LEN;
+}
+
+/* In step with dissect_ipsc_summary() in packet-ipsc.c */
+static uint32_t
+decode_summary(const uint8_t *data, size_t len)
+{
+    ipsc_wire_msg_t msg;
+    ipsc_wire_call_t call;
+    ipsc_wire_reg_t reg;
+    ipsc_wire_csbk_t csbk;
+    ipsc_wire_voice_t voice;
+    const uint8_t *payload;
+    uint16_t emb;
+    size_t payload_len = 0;
+    uint32_t h;
+    int dbm;
+
+    if (!ipsc_wire_msg(&msg, data, len))
+      return 0;
+
+    h = ipsc_wire_opcode(&msg) ^ ipsc_wire_rpt_id(&msg);
+
+    if (ipsc_wire_call(&msg, &call))
+    {
+      h ^= ipsc_wire_call_src_id(&call) ^ ipsc_wire_call_dst_id(&call) ^ ipsc_wire_call_slot(&call) ^
+           ipsc_wire_call_call_seq_no(&call) ^ ipsc_wire_call_timestamp(&call) ^
+           ipsc_wire_call_data_type(&call);
+      payload = ipsc_wire_call_payload(&call, &payload_len);
+
+      if (ipsc_wire_call_rssi(&call, &dbm))
+      {
+        h ^= (uint32_t)dbm;
+        if (ipsc_wire_call_rssi_threshold(&call, &dbm))
+          h ^= (uint32_t)dbm;
+      }
+
+      if (ipsc_wire_call_data_type(&call) == IPSC_DATA_TYPE_CSBK && payload && !ipsc_wire_call_raw_burst(&call) &&
+          ipsc_wire_csbk(payload, payload_len, &csbk))
+        h ^= ipsc_wire_csbk_csbko(&csbk) ^ ipsc_wire_csbk_fid(&csbk);
+
+      if (ipsc_wire_voice(&call, &voice))
+      {
+        h ^= ipsc_wire_voice_burst(&voice);
+        if (ipsc_wire_voice_has_emb(&voice))
+          h ^= ipsc_wire_voice_emb_decode(&voice, &emb);
+      }
+    }
+
+    if (ipsc_wire_reg(&msg, &reg))
+      h ^= ipsc_wire_reg_linking(&reg) ^ ipsc_wire_reg_flags4(&reg);
+
+    return h;
+}
+
+static uint32_t
+decode_full(const uint8_t *data, size_t len)
+{
+    ipsc_wire_msg_t msg;
+    ipsc_wire_call_t call;
+    ipsc_wire_reg_t reg;
+    ipsc_wire_peer_list_t list;
+    ipsc_wire_xnl_t xnl;
+    ipsc_wire_voice_t voice;
+    const uint8_t *payload, *digest, *entry, *raw;
+    uint8_t burst[IPSC_BURST_LEN], slot_type;
+    uint16_t emb;
+    size_t payload_len, body_len, i;
+    int exact;
+    uint32_t h;
+
+    if (!ipsc_wire_msg(&msg, data, len))
+      return 0;
+
+    h = ipsc_wire_opcode(&msg) ^ ipsc_wire_rpt_id(&msg);
+
+    body_len = ipsc_wire_body_length(&msg, &exact);
+    if (exact && (digest = ipsc_wire_digest(&msg, body_len)) != NULL)
+      h ^= digest[0] ^ digest[IPSC_AUTH_DIGEST_LEN - 1];
+
+    if (ipsc_wire_call(&msg, &call))
+    {
+      h ^= ipsc_wire_call_seq_no(&call) ^ ipsc_wire_call_src_id(&call) ^ ipsc_wire_call_dst_id(&call) ^
+           ipsc_wire_call_prio(&call) ^ ipsc_wire_call_ctrl(&call) ^ ipsc_wire_call_ctrl_info(&call) ^
+           ipsc_wire_call_ctrl_src(&call) ^ ipsc_wire_call_payload_type(&call) ^
+           ipsc_wire_call_call_seq_no(&call) ^ ipsc_wire_call_timestamp(&call) ^
+           ipsc_wire_call_sync_src(&call) ^ ipsc_wire_call_data_type(&call);
+
+      if (ipsc_wire_voice(&call, &voice))
+      {
+        h ^= ipsc_wire_voice_burst(&voice) ^ ipsc_wire_voice_ambe(&voice, 0)[0] ^
+             ipsc_wire_voice_ambe(&voice, 1)[0] ^ ipsc_wire_voice_ambe(&voice, 2)[0];
+        if (ipsc_wire_voice_has_emb(&voice))
+          h ^= ipsc_wire_voice_emb_cc(&voice) ^ ipsc_wire_voice_emb_pi(&voice) ^
+               ipsc_wire_voice_emb_lcss(&voice) ^ ipsc_wire_voice_emb(&voice) ^ ipsc_wire_voice_embedded(&voice) ^
+               ipsc_wire_voice_emb_decode(&voice, &emb) ^ emb;
+        return h;
+      }
+
+      if ((payload = ipsc_wire_call_payload(&call, &payload_len)) == NULL)
+        return h;
+
+      if ((raw = ipsc_wire_call_raw_burst(&call)) != NULL)
+      {
+        h ^= ipsc_wire_slot_type_decode(raw, &slot_type) ^ slot_type ^ ipsc_wire_bptc_decode(raw, burst);
+        payload = burst;
+        payload_len = IPSC_BURST_LEN;
+      }
+
+      switch (ipsc_wire_call_data_type(&call))
+      {
+        case IPSC_DATA_TYPE_VOICE_LC_HDR:
+        case IPSC_DATA_TYPE_TERMINATOR_LC:
+        {
+          ipsc_wire_full_lc_t lc;
+
+          if (ipsc_wire_full_lc(payload, payload_len, &lc))
+            h ^= ipsc_wire_full_lc_pf(&lc) ^ ipsc_wire_full_lc_flco(&lc) ^ ipsc_wire_full_lc_fid(&lc) ^
+                 ipsc_wire_full_lc_service_options(&lc) ^ ipsc_wire_full_lc_dst_id(&lc) ^
+                 ipsc_wire_full_lc_src_id(&lc);
+        }; break;
+
+        case IPSC_DATA_TYPE_CSBK:
+        {
+          ipsc_wire_csbk_t csbk;
+
+          if (ipsc_wire_csbk(payload, payload_len, &csbk))
+            h ^= ipsc_wire_csbk_lb(&csbk) ^ ipsc_wire_csbk_pf(&csbk) ^ ipsc_wire_csbk_csbko(&csbk) ^
+                 ipsc_wire_csbk_fid(&csbk) ^ ipsc_wire_csbk_byte3(&csbk) ^ ipsc_wire_csbk_byte4(&csbk) ^
+                 ipsc_wire_csbk_dst_id(&csbk) ^ ipsc_wire_csbk_src_id(&csbk) ^ ipsc_wire_csbk_crc(&csbk) ^
+                 ipsc_wire_csbk_crc_ok(&csbk);
+        }; break;
+
+        case IPSC_DATA_TYPE_DATA_HDR:
+        {
+          ipsc_wire_data_hdr_t hdr;
+
+          if (ipsc_wire_data_hdr(payload, payload_len, &hdr))
+            h ^= ipsc_wire_data_hdr_group(&hdr) ^ ipsc_wire_data_hdr_ack(&hdr) ^ ipsc_wire_data_hdr_hc(&hdr) ^
+                 ipsc_wire_data_hdr_dpf(&hdr) ^ ipsc_wire_data_hdr_sap(&hdr) ^
+                 ipsc_wire_data_hdr_pad_octets(&hdr) ^ ipsc_wire_data_hdr_dst_id(&hdr) ^
+                 ipsc_wire_data_hdr_src_id(&hdr) ^ ipsc_wire_data_hdr_full(&hdr) ^
+                 ipsc_wire_data_hdr_blocks(&hdr) ^ ipsc_wire_data_hdr_resync(&hdr) ^
+                 ipsc_wire_data_hdr_ns(&hdr) ^ ipsc_wire_data_hdr_fsn(&hdr) ^ ipsc_wire_data_hdr_crc(&hdr) ^
+                 ipsc_wire_data_hdr_crc_ok(&hdr);
+        }; break;
+
+        default:
+          h ^= payload[0] ^ (uint32_t)payload_len;
+      }
+    }
+    else if (ipsc_wire_reg(&msg, &reg))
+    {
+      h ^= ipsc_wire_reg_linking(&reg) ^ ipsc_wire_reg_service_flags(&reg) ^ ipsc_wire_reg_flags3(&reg) ^
+           ipsc_wire_reg_flags4(&reg) ^ ipsc_wire_reg_version(&reg) ^ ipsc_wire_reg_auth(&reg);
+    }
+    else if (ipsc_wire_peer_list(&msg, &list))
+    {
+      for (i = 0; i < list.count; i++)
+      {
+        entry = ipsc_wire_peer(&list, i);
+        h ^= ipsc_wire_peer_rpt_id(entry) ^ ipsc_wire_peer_ip(entry) ^ ipsc_wire_peer_port(entry) ^
+             ipsc_wire_peer_linking(entry);
+      }
+    }
+    else if (ipsc_wire_opcode(&msg) == 0x70 && len >= IPSC_XNL_OFF_DATA &&
+             ipsc_wire_xnl(data + IPSC_XNL_OFF_DATA, len - IPSC_XNL_OFF_DATA, &xnl))
+    {
+      h ^= ipsc_wire_xnl_opcode(&xnl) ^ ipsc_wire_xnl_proto(&xnl) ^ ipsc_wire_xnl_flags(&xnl) ^
+           ipsc_wire_xnl_dst(&xnl) ^ ipsc_wire_xnl_src(&xnl) ^ ipsc_wire_xnl_trans_id(&xnl) ^
+           ipsc_wire_xnl_payload_len(&xnl) ^ ipsc_wire_xcmp_opcode(&xnl);
+    }
+
+    return h;
+}
+
+/*
+ * One pcap of the case as Ethernet/IPv4/UDP, a packet per 60 ms burst.
+ * Seq No, Call Seq No and Timestamp move on with each copy, so call
+ * tracking sees one stream and not duplicates.
+ */
+static int
+bench_write_pcap(const bench_case_t *bc, const char *file, unsigned long packets)
+{
+    /* pcap in native byte order, readers tell it from the magic */
+    static const uint32_t magic = 0xa1b2c3d4;
+    static const uint16_t version[2] = { 2, 4 };
+    static const uint32_t rest[4] = { 0, 0, 65535, 1 };    /* thiszone, sigfigs, snaplen, Ethernet */
+    uint8_t frame[42 + BENCH_MAX_LEN];
+    uint8_t *ip = frame + 14, *udp = frame + 34, *p = frame + 42;
+    ipsc_wire_msg_t msg;
+    ipsc_wire_call_t call;
+    uint32_t rec[4], sum, time_us;
+    unsigned long n;
+    int is_call, i, ok;
+    FILE *out;
+
+    if ((out = fopen(file, "wb")) == NULL)
+      return 0;
+
+    memset(frame, 0, 42);
+    memcpy(frame, "\x02\x00\x00\x00\x00\x02\x02\x00\x00\x00\x00\x01", 12);
+    put16(frame + 12, 0x0800);
+    ip[0] = 0x45;
+    put16(ip + 2, (uint16_t)(20 + 8 + bc->len));
+    put16(ip + 6, 0x4000);
+    ip[8] = 64;
+    ip[9] = 17;
+    put32(ip + 12, 0x0a000001);
+    put32(ip + 16, 0x0a000002);
+    for (i = 0, sum = 0; i < 20; i += 2)
+      sum += ipsc_wire_get16(ip + i);
+    while (sum >> 16)
+      sum = (sum & 0xffff) + (sum >> 16);
+    put16(ip + 10, (uint16_t)~sum);
+    put16(udp, BENCH_PORT);
+    put16(udp + 2, BENCH_PORT);
+    put16(udp + 4, (uint16_t)(8 + bc->len));
+    memcpy(p, bc->data, bc->len);
+
+    is_call = ipsc_wire_msg(&msg, p, bc->len) && ipsc_wire_call(&msg, &call);
+
+    fwrite(&magic, sizeof(magic), 1, out);
+    fwrite(version, sizeof(version), 1, out);
+    fwrite(rest, sizeof(rest), 1, out);
+    for (n = 0; n < packets; n++)
+    {
+      if (is_call)
+      {
+        p[IPSC_CALL_OFF_SEQ_NO] = (uint8_t)n;
+        put16(p + IPSC_CALL_OFF_CALL_SEQ_NO, (uint16_t)n);
+        put32(p + IPSC_CALL_OFF_TIMESTAMP, (uint32_t)(n * 480));
+      }
+
+      time_us = (uint32_t)(n % (1000000 / BENCH_BURST_US)) * BENCH_BURST_US;
+      rec[0] = (uint32_t)(1700000000 + n / (1000000 / BENCH_BURST_US));
+      rec[1] = time_us;
+      rec[2] = rec[3] = (uint32_t)(42 + bc->len);
+      fwrite(rec, sizeof(rec), 1, out);
+      fwrite(frame, 42 + bc->len, 1, out);
+    }
+
+    ok = !ferror(out);
+    return (fclose(out) == 0 && ok) ? 1 : 0;
+}
+
+static double
+bench_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double
+bench_run(const bench_case_t *bc, unsigned long packets, uint32_t (*decode)(const uint8_t *, size_t))
+{
+    unsigned long i;
+    uint32_t h = 0;
+    double start;
+
+    start = bench_now();
+    for (i = 0; i < packets; i++)
+      h += decode(bc->data, bc->len);
+    bench_sink = h;
+
+    return bench_now() - start;
+}
+
+/* Voice burst A (no EMB) or B to F */
+static void
+build_voice(bench_case_t *bc, const char *name, uint8_t burst)
+{
+    uint8_t *v;
+    size_t len, i;
+
+    build_call(bc, name, 0x80, IPSC_DATA_TYPE_RATE_1, NULL);
+
+    len = (burst >= 1 && burst <= 4) ? IPSC_VOICE_EMBEDDED_LEN : IPSC_VOICE_LEN;
+    v = bc->data + IPSC_CALL_OFF_PAYLOAD2;
+    bc->data[IPSC_CALL_OFF_LENGTH2] = (uint8_t)len;
+    v[IPSC_VOICE_OFF_BURST] = burst;
+    for (i = IPSC_VOICE_OFF_AMBE; i < len; i++)
+      v[i] = (uint8_t)(i * 53);
+    if (len == IPSC_VOICE_EMBEDDED_LEN)
+      v[IPSC_VOICE_OFF_EMB] = 0x16;
+
+    memset(v + len, 0xa5, IPSC_AUTH_DIGEST_LEN);
+    bc->len = IPSC_CALL_OFF_PAYLOAD2 + len + IPSC_AUTH_DIGEST_LEN;
+}
+
+int
+main(int argc, char **argv)
+{
+    static const uint8_t full_lc[IPSC_BURST_LEN] = { 0x00, 0x00, 0x20, 0x00, 0x00, 0x09, 0x2f, 0x9b, 0xe5, 0x4c, 0x8b, 0x11 };
+    static const uint8_t csbk[IPSC_BURST_LEN] = { 0xbd, 0x00, 0x80, 0x0b, 0x00, 0x00, 0x09, 0x2f, 0x9b, 0xe5, 0x1d, 0x7a };
+    static const uint8_t data_hdr[IPSC_BURST_LEN] = { 0x82, 0x40, 0x00, 0x00, 0x09, 0x2f, 0x9b, 0xe5, 0x83, 0x00, 0xae, 0x71 };
+    static const char *names_80[] = {
+      "0x80 GROUP_VOICE PI Header", "0x80 GROUP_VOICE Voice LC Header",
+      "0x80 GROUP_VOICE Terminator LC", "0x80 GROUP_VOICE CSBK",
+      "0x80 GROUP_VOICE MBC Header", "0x80 GROUP_VOICE MBC Continuation",
+      "0x80 GROUP_VOICE Data Header", "0x80 GROUP_VOICE Rate 1/2 Data",
+      "0x80 GROUP_VOICE Rate 3/4 Data", "0x80 GROUP_VOICE Idle",
+      "0x80 GROUP_VOICE Rate 1 Data"
+    };
+
+    bench_case_t cases[40];
+    unsigned long packets = BENCH_DEFAULT_PACKETS;
+    double t_summary, t_full;
+    const char *dir = NULL;
+    char file[1024];
+    int n = 0, i, arg = 1;
+    uint8_t dt;
+
+    if (argc > 2 && strcmp(argv[1], "-w") == 0)
+    {
+      dir = argv[2];
+      arg = 3;
+    }
+    if (argc > arg)
+      packets = strtoul(argv[arg], NULL, 0);
+    if (packets == 0)
+    {
+      fprintf(stderr, "usage: %s [-w dir] [packets per case]\n", argv[0]);
+      return 1;
+    }
+
+    build_simple(&cases[n++], "0x61 CALL_CTL_1", 0x61, 26);
+    build_simple(&cases[n++], "0x62 CALL_CTL_2", 0x62, 7);
+    build_simple(&cases[n++], "0x63 CALL_CTL_3", 0x63, 6);
+    build_xcmp(&cases[n++]);
+    for (dt = 0x00; dt <= IPSC_DATA_TYPE_RATE_1; dt++)
+      build_call(&cases[n++], names_80[dt], 0x80, dt,
+                 dt == IPSC_DATA_TYPE_CSBK ? csbk : dt == IPSC_DATA_TYPE_DATA_HDR ? data_hdr : full_lc);
+    build_voice(&cases[n++], "0x80 GROUP_VOICE Voice Burst A", 0);
+    build_voice(&cases[n++], "0x80 GROUP_VOICE Voice Burst B", 1);
+    build_call(&cases[n++], "0x84 PVT_DATA CSBK", 0x84, IPSC_DATA_TYPE_CSBK, csbk);
+    build_call(&cases[n++], "0x84 PVT_DATA Data Header", 0x84, IPSC_DATA_TYPE_DATA_HDR, data_hdr);
+    build_raw_burst(&cases[n++], "0x84 PVT_DATA CSBK, raw burst", 0x84, IPSC_DATA_TYPE_CSBK, csbk);
+    build_reg(&cases[n++], "0x90 MASTER_REG_REQ", 0x90);
+    build_reg(&cases[n++], "0x91 MASTER_REG_REPLY", 0x91);
+    build_simple(&cases[n++], "0x92 PEER_LIST_REQ", 0x92, IPSC_SHORT_LEN);
+    build_peer_list(&cases[n++]);
+    build_reg(&cases[n++], "0x94 PEER_REG_REQ", 0x94);
+    build_reg(&cases[n++], "0x95 PEER_REG_REPLY", 0x95);
+    build_reg(&cases[n++], "0x96 MASTER_ALIVE_REQ", 0x96);
+    build_reg(&cases[n++], "0x97 MASTER_ALIVE_REPLY", 0x97);
+    build_reg(&cases[n++], "0x98 PEER_ALIVE_REQ", 0x98);
+    build_reg(&cases[n++], "0x99 PEER_ALIVE_REPLY", 0x99);
+
+    /* A pcap per case for ipsc-bench.sh, and the list of them on stdout */
+    if (dir)
+    {
+      for (i = 0; i < n; i++)
+      {
+        snprintf(file, sizeof(file), "%s/case%02d.pcap", dir, i);
+        if (!bench_write_pcap(&cases[i], file, packets))
+        {
+          perror(file);
+          return 1;
+        }
+        printf("%s\t%s\n", file, cases[i].name);
+      }
+      return 0;
+    }
+
+    printf("%lu packets per case\n", packets);
+    printf("%-36s %4s %14s %9s %14s %9s\n", "", "Len", "summary pkt/s", "ns/pkt", "full pkt/s", "ns/pkt");
+
+    for (i = 0; i < n; i++)
+    {
+      t_summary = bench_run(&cases[i], packets, decode_summary);
+      t_full = bench_run(&cases[i], packets, decode_full);
+
+      printf("%-36s %4u %14.0f %9.2f %14.0f %9.2f\n", cases[i].name, (unsigned)cases[i].len,
+             packets / t_summary, t_summary * 1e9 / packets,
+             packets / t_full, t_full * 1e9 / packets);
+    }
+
+    return 0;
+}
@@ -0,0 +1,1336 @@
+/* ipsc-wire.h
+ * Motorola IP Site Connect wire format, without Wireshark
+ *
+ * Copyright by Bogdan Diaconesc yo3iiu@yo3iiu.ro
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * Everything here works on the raw UDP payload. The views are a
+ * pointer and a length into the caller's buffer: nothing is allocated
+ * and nothing is copied. The functions that set up a view check the
+ * length once and return 0 when the packet is too short; after that
+ * the accessors read without any further check.
+ *
+ * Only the C library is needed, so the same decoder can be built into
+ * packet-ipsc.c and into collectors that do not link libwireshark.
+ */
+
+#ifndef __IPSC_WIRE_H__
+#define __IPSC_WIRE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef _MSC_VER
+#define IPSC_WIRE_API static __inline
+#else
+#define IPSC_WIRE_API static inline
+#endif
+
+/* Common to every message */
+#define IPSC_OFF_OPCODE                 0
+#define IPSC_OFF_RPT_ID                 1
+#define IPSC_SHORT_LEN                  5
+
+#define IPSC_AUTH_DIGEST_LEN            10
+
+/* GROUP_VOICE, GROUP_DATA and PVT_DATA */
+#define IPSC_CALL_OFF_SEQ_NO            5
+#define IPSC_CALL_OFF_SRC_ID            6
+#define IPSC_CALL_OFF_DST_ID            9
+#define IPSC_CALL_OFF_PRIO              12
+#define IPSC_CALL_OFF_CALL_CTRL         13
+#define IPSC_CALL_OFF_CALL_CTRL_INFO    17
+#define IPSC_CALL_OFF_CALL_CTRL_SRC     18
+#define IPSC_CALL_OFF_PAYLOAD_TYPE      19
+#define IPSC_CALL_OFF_CALL_SEQ_NO       20
+#define IPSC_CALL_OFF_TIMESTAMP         22
+#define IPSC_CALL_OFF_SYNC_SRC          26
+#define IPSC_CALL_OFF_DATA_TYPE         30
+#define IPSC_CALL_OFF_RSSI_THRESHOLD    31
+#define IPSC_CALL_OFF_LENGTH2           31  /* Rate 1 data, in octets */
+#define IPSC_CALL_OFF_LENGTH_TO_FOLLOW  32  /* in 2 octet words */
+#define IPSC_CALL_OFF_RSSI_STATUS       34
+#define IPSC_CALL_OFF_SLOT_TYPE_SYNC    35
+#define IPSC_CALL_OFF_DATA_SIZE         36
+#define IPSC_CALL_OFF_PAYLOAD           38
+#define IPSC_CALL_OFF_PAYLOAD2          32  /* Rate 1 data */
+
+#define IPSC_CALL_HDR_LEN               31  /* up to Data Type Voice Hdr */
+#define IPSC_CALL_BURST_LEN             34  /* up to Length to Follow */
+#define IPSC_CALL_DATA_LEN              38  /* up to Data Size */
+
+#define IPSC_CALL_CTRL_INFO_SLOT2       0x20
+
+/* Data types, low nibble of IPSC_CALL_OFF_DATA_TYPE */
+#define IPSC_DATA_TYPE_VOICE_LC_HDR     0x01
+#define IPSC_DATA_TYPE_TERMINATOR_LC    0x02
+#define IPSC_DATA_TYPE_CSBK             0x03
+#define IPSC_DATA_TYPE_DATA_HDR         0x06
+#define IPSC_DATA_TYPE_RATE_12          0x07
+#define IPSC_DATA_TYPE_RATE_34          0x08
+#define IPSC_DATA_TYPE_RATE_1           0x0a
+
+/*
+ * Voice bursts are GROUP_VOICE with data type Rate 1; the octet at
+ * IPSC_CALL_OFF_LENGTH2 gives the length of the burst that follows.
+ */
+#define IPSC_VOICE_OFF_BURST            0   /* position in the superframe, 0 (A) to 5 (F) */
+#define IPSC_VOICE_OFF_AMBE             1   /* three 72 bit AMBE+2 frames */
+#define IPSC_VOICE_AMBE_FRAME_LEN       9
+#define IPSC_VOICE_AMBE_FRAMES          3
+#define IPSC_VOICE_OFF_EMB              28  /* bursts B to E: EMB ... */
+#define IPSC_VOICE_OFF_EMBEDDED         30  /* ... and 32 bits of embedded signalling */
+#define IPSC_VOICE_LEN                  28
+#define IPSC_VOICE_EMBEDDED_LEN         34
+
+#define IPSC_VOICE_BURSTS               6   /* A to F */
+
+/* 96 bit bursts in the call payload: Full LC, CSBK and Data Header */
+#define IPSC_BURST_LEN                  12
+
+/* Registration and keepalives, 0x90 to 0x99 */
+#define IPSC_REG_OFF_LINKING            5
+#define IPSC_REG_OFF_SERVICE_FLAGS      6
+#define IPSC_REG_OFF_VERSION            10
+#define IPSC_REG_LEN                    14
+
+#define IPSC_FLAGS3_CSBK                0x80
+#define IPSC_FLAGS3_RPT_CALL_MON        0x40
+#define IPSC_FLAGS3_3RD_PARTY           0x20
+#define IPSC_FLAGS4_XNL_CONNECTED       0x80
+#define IPSC_FLAGS4_XNL_MASTER          0x40
+#define IPSC_FLAGS4_XNL_SLAVE           0x20
+#define IPSC_FLAGS4_AUTH                0x10
+#define IPSC_FLAGS4_VOICE               0x08
+#define IPSC_FLAGS4_DATA                0x04
+#define IPSC_FLAGS4_MASTER              0x01
+
+/* PEER_LIST_REPLY: octets of entries, then one entry per peer */
+#define IPSC_PEER_LIST_OFF_LENGTH       5
+#define IPSC_PEER_LIST_OFF_ENTRIES      7
+#define IPSC_PEER_OFF_RPT_ID            0
+#define IPSC_PEER_OFF_IP                4
+#define IPSC_PEER_OFF_PORT              8
+#define IPSC_PEER_OFF_LINKING           10
+#define IPSC_PEER_LEN                   11
+
+/* XCMP/XNL: octets of XNL data, then the XNL packet or a piece of it */
+#define IPSC_XNL_OFF_LENGTH             5
+#define IPSC_XNL_OFF_DATA               7
+
+/* XNL header, from the start of the XNL packet */
+#define IPSC_XNL_HDR_OFF_OPCODE         0
+#define IPSC_XNL_HDR_OFF_PROTO          2
+#define IPSC_XNL_HDR_OFF_FLAGS          3
+#define IPSC_XNL_HDR_OFF_DST            4
+#define IPSC_XNL_HDR_OFF_SRC            6
+#define IPSC_XNL_HDR_OFF_TRANS_ID       8
+#define IPSC_XNL_HDR_OFF_PAYLOAD_LEN    10
+#define IPSC_XNL_HDR_LEN                12
+
+#define IPSC_XNL_OPCODE_DATA_MSG        0x000b
+#define IPSC_XNL_PROTO_XCMP             0x01
+
+/* XCMP opcode: the top nibble tells request, reply and broadcast apart */
+#define IPSC_XCMP_TYPE_MASK             0xf000
+#define IPSC_XCMP_TYPE_REQUEST          0x0000
+#define IPSC_XCMP_TYPE_REPLY            0x8000
+#define IPSC_XCMP_TYPE_BROADCAST        0xb000
+
+/* Big endian loads */
+IPSC_WIRE_API uint16_t ipsc_wire_get16(const uint8_t *p) { return (uint16_t)(p[0] << 8 | p[1]); }
+IPSC_WIRE_API uint32_t ipsc_wire_get24(const uint8_t *p) { return (uint32_t)p[0] << 16 | (uint32_t)p[1] << 8 | p[2]; }
+IPSC_WIRE_API uint32_t ipsc_wire_get32(const uint8_t *p) { return (uint32_t)p[0] << 24 | ipsc_wire_get24(p + 1); }
+
+/*
+ * A message
+ */
+typedef struct _ipsc_wire_msg_t {
+    const uint8_t *data;
+    size_t         len;
+} ipsc_wire_msg_t;
+
+/* Always sets the view, returns 1 if the packet has an opcode and a Rpt Id */
+IPSC_WIRE_API int
+ipsc_wire_msg(ipsc_wire_msg_t *msg, const uint8_t *data, size_t len)
+{
+    msg->data = data;
+    msg->len = len;
+    return len >= IPSC_SHORT_LEN;
+}
+
+IPSC_WIRE_API uint8_t  ipsc_wire_opcode(const ipsc_wire_msg_t *msg) { return msg->data[IPSC_OFF_OPCODE]; }
+IPSC_WIRE_API uint32_t ipsc_wire_rpt_id(const ipsc_wire_msg_t *msg) { return ipsc_wire_get32(msg->data + IPSC_OFF_RPT_ID); }
+
+/*
+ * Length of the message without the Auth Digest, 0 if the opcode is
+ * not known or a call packet does not add up: no DMR data type, a
+ * Rate 1 length other than a voice burst, or a Data Size larger than
+ * Length to Follow. When the length
+ * depends on octets that are not in the packet, or on a layout that
+ * is not known, the minimum is returned and *exact is cleared. Needs
+ * a view with an opcode.
+ */
+IPSC_WIRE_API size_t
+ipsc_wire_body_length(const ipsc_wire_msg_t *msg, int *exact)
+{
+    const uint8_t *p = msg->data;
+    unsigned length_to_follow;
+
+    *exact = 1;
+
+    switch (p[IPSC_OFF_OPCODE])
+    {
+      /* CALL_CTL_1, CALL_CTL_2, CALL_CTL_3 */
+      case 0x61:
+        return 26;
+      case 0x62:
+        return 7;
+      case 0x63:
+        return 6;
+
+      /* XCMP/XNL */
+      case 0x70:
+        if (msg->len < IPSC_XNL_OFF_DATA)
+        {
+          *exact = 0;
+          return IPSC_XNL_OFF_DATA;
+        }
+        return IPSC_XNL_OFF_DATA + ipsc_wire_get16(p + IPSC_XNL_OFF_LENGTH);
+
+      /* GROUP_VOICE, GROUP_DATA, PVT_DATA: Rate 1 data sized by its own octet, the rest by Length to Follow */
+      case 0x80:
+      case 0x83:
+      case 0x84:
+        if (msg->len < IPSC_CALL_HDR_LEN)
+        {
+          *exact = 0;
+          return IPSC_CALL_HDR_LEN;
+        }
+        if ((p[IPSC_CALL_OFF_DATA_TYPE] & 0x0f) > IPSC_DATA_TYPE_RATE_1)
+          return 0;
+        if (p[IPSC_OFF_OPCODE] == 0x80 && (p[IPSC_CALL_OFF_DATA_TYPE] & 0x0f) == IPSC_DATA_TYPE_RATE_1)
+        {
+          if (msg->len < IPSC_CALL_OFF_PAYLOAD2)
+          {
+            *exact = 0;
+            return IPSC_CALL_OFF_PAYLOAD2;
+          }
+          if (p[IPSC_CALL_OFF_LENGTH2] != IPSC_VOICE_LEN && p[IPSC_CALL_OFF_LENGTH2] != IPSC_VOICE_EMBEDDED_LEN)
+            return 0;
+          return IPSC_CALL_OFF_PAYLOAD2 + p[IPSC_CALL_OFF_LENGTH2];
+        }
+        if (msg->len < IPSC_CALL_BURST_LEN)
+        {
+          *exact = 0;
+          return IPSC_CALL_BURST_LEN;
+        }
+        /* Length to Follow counts RSSI Status, Slot Type Sync and Data Size, which is in bits */
+        length_to_follow = ipsc_wire_get16(p + IPSC_CALL_OFF_LENGTH_TO_FOLLOW);
+        if (length_to_follow == 1)
+          return 0;
+        if (length_to_follow && msg->len >= IPSC_CALL_DATA_LEN &&
+            ipsc_wire_get16(p + IPSC_CALL_OFF_DATA_SIZE) > 8 * (2 * length_to_follow - 4))
+          return 0;
+        return IPSC_CALL_BURST_LEN + 2 * length_to_follow;
+
+      /* RPT_WAKE_UP, only the start is known */
+      case 0x85:
+        *exact = 0;
+        return IPSC_SHORT_LEN;
+
+      /* PEER_LIST_REPLY */
+      case 0x93:
+        if (msg->len < IPSC_PEER_LIST_OFF_ENTRIES)
+        {
+          *exact = 0;
+          return IPSC_PEER_LIST_OFF_ENTRIES;
+        }
+        return IPSC_PEER_LIST_OFF_ENTRIES + ipsc_wire_get16(p + IPSC_PEER_LIST_OFF_LENGTH);
+
+      /* PEER_LIST_REQ, DE_REG_REQ, DE_REG_REPLY */
+      case 0x92:
+      case 0x9a:
+      case 0x9b:
+        return IPSC_SHORT_LEN;
+
+      case 0x90:
+      case 0x91:
+      case 0x94:
+      case 0x95:
+      case 0x96:
+      case 0x97:
+      case 0x98:
+      case 0x99:
+        return IPSC_REG_LEN;
+
+      default:
+        return 0;
+    }
+}
+
+/* The Auth Digest after a body of body_len octets, NULL if it is not in the packet */
+IPSC_WIRE_API const uint8_t *
+ipsc_wire_digest(const ipsc_wire_msg_t *msg, size_t body_len)
+{
+    if (msg->len < body_len + IPSC_AUTH_DIGEST_LEN)
+      return NULL;
+    return msg->data + body_len;
+}
+
+/*
+ * Call header of GROUP_VOICE, GROUP_DATA and PVT_DATA
+ */
+typedef struct _ipsc_wire_call_t {
+    const uint8_t *data;
+    size_t         len;
+} ipsc_wire_call_t;
+
+/* Returns 1 if the message is a call and holds the call header */
+IPSC_WIRE_API int
+ipsc_wire_call(const ipsc_wire_msg_t *msg, ipsc_wire_call_t *call)
+{
+    if (msg->len < IPSC_CALL_HDR_LEN)
+      return 0;
+
+    switch (msg->data[IPSC_OFF_OPCODE])
+    {
+      case 0x80:
+      case 0x83:
+      case 0x84:
+        call->data = msg->data;
+        call->len = msg->len;
+        return 1;
+
+      default:
+        return 0;
+    }
+}
+
+IPSC_WIRE_API uint8_t  ipsc_wire_call_seq_no(const ipsc_wire_call_t *c)         { return c->data[IPSC_CALL_OFF_SEQ_NO]; }
+IPSC_WIRE_API uint32_t ipsc_wire_call_src_id(const ipsc_wire_call_t *c)         { return ipsc_wire_get24(c->data + IPSC_CALL_OFF_SRC_ID); }
+IPSC_WIRE_API uint32_t ipsc_wire_call_dst_id(const ipsc_wire_call_t *c)         { return ipsc_wire_get24(c->data + IPSC_CALL_OFF_DST_ID); }
+IPSC_WIRE_API uint8_t  ipsc_wire_call_prio(const ipsc_wire_call_t *c)           { return c->data[IPSC_CALL_OFF_PRIO]; }
+IPSC_WIRE_API uint32_t ipsc_wire_call_ctrl(const ipsc_wire_call_t *c)           { return ipsc_wire_get32(c->data + IPSC_CALL_OFF_CALL_CTRL); }
+IPSC_WIRE_API uint8_t  ipsc_wire_call_ctrl_info(const ipsc_wire_call_t *c)      { return c->data[IPSC_CALL_OFF_CALL_CTRL_INFO]; }
+IPSC_WIRE_API uint8_t  ipsc_wire_call_ctrl_src(const ipsc_wire_call_t *c)       { return c->data[IPSC_CALL_OFF_CALL_CTRL_SRC]; }
+IPSC_WIRE_API uint8_t  ipsc_wire_call_payload_type(const ipsc_wire_call_t *c)   { return c->data[IPSC_CALL_OFF_PAYLOAD_TYPE]; }
+IPSC_WIRE_API uint16_t ipsc_wire_call_call_seq_no(const ipsc_wire_call_t *c)    { return ipsc_wire_get16(c->data + IPSC_CALL_OFF_CALL_SEQ_NO); }
+IPSC_WIRE_API uint32_t ipsc_wire_call_timestamp(const ipsc_wire_call_t *c)      { return ipsc_wire_get32(c->data + IPSC_CALL_OFF_TIMESTAMP); }
+IPSC_WIRE_API uint32_t ipsc_wire_call_sync_src(const ipsc_wire_call_t *c)       { return ipsc_wire_get32(c->data + IPSC_CALL_OFF_SYNC_SRC); }
+IPSC_WIRE_API uint8_t  ipsc_wire_call_data_type(const ipsc_wire_call_t *c)      { return c->data[IPSC_CALL_OFF_DATA_TYPE] & 0x0f; }
+
+/* Timeslot from Call Ctrl Info, 1 or 2 */
+IPSC_WIRE_API uint8_t
+ipsc_wire_call_slot(const ipsc_wire_call_t *c)
+{
+    return (c->data[IPSC_CALL_OFF_CALL_CTRL_INFO] & IPSC_CALL_CTRL_INFO_SLOT2) ? 2 : 1;
+}
+
+/*
+ * The payload after the call header: the burst at 38 sized by Length
+ * to Follow, or the Rate 1 data at 32 sized by its own length octet.
+ * The length is cut to what the packet holds. Returns NULL if there
+ * is no payload.
+ */
+IPSC_WIRE_API const uint8_t *
+ipsc_wire_call_payload(const ipsc_wire_call_t *c, size_t *len)
+{
+    size_t offset, declared;
+    unsigned length_to_follow;
+
+    if (c->data[IPSC_OFF_OPCODE] == 0x80 && ipsc_wire_call_data_type(c) == IPSC_DATA_TYPE_RATE_1)
+    {
+      if (c->len < IPSC_CALL_OFF_PAYLOAD2)
+        return NULL;
+      offset = IPSC_CALL_OFF_PAYLOAD2;
+      declared = c->data[IPSC_CALL_OFF_LENGTH2];
+    }
+    else
+    {
+      if (c->len < IPSC_CALL_DATA_LEN)
+        return NULL;
+      length_to_follow = ipsc_wire_get16(c->data + IPSC_CALL_OFF_LENGTH_TO_FOLLOW);
+      /* RSSI Status, Slot Type Sync and Data Size are counted in it */
+      if (length_to_follow < 3)
+        return NULL;
+      offset = IPSC_CALL_OFF_PAYLOAD;
+      declared = 2 * length_to_follow - 4;
+    }
+
+    *len = (declared < c->len - offset) ? declared : c->len - offset;
+    return c->data + offset;
+}
+
+/*
+ * RSSI of the call packets that carry Length to Follow; voice bursts
+ * have their Rate 1 length and data there instead. RSSI Status is the
+ * level in dB below 1 mW, 0x60 is -96 dBm, and 0 means not measured.
+ * RSSI Threshold and Parity has the threshold the same way in its low
+ * 7 bits and the parity in the top one.
+ */
+#define IPSC_RSSI_THRESHOLD_PARITY      0x80
+
+IPSC_WIRE_API int
+ipsc_wire_call_has_rssi(const ipsc_wire_call_t *c)
+{
+    return !(c->data[IPSC_OFF_OPCODE] == 0x80 && ipsc_wire_call_data_type(c) == IPSC_DATA_TYPE_RATE_1);
+}
+
+/* Returns 1 and the level in dBm if the packet has one */
+IPSC_WIRE_API int
+ipsc_wire_call_rssi(const ipsc_wire_call_t *c, int *dbm)
+{
+    if (!ipsc_wire_call_has_rssi(c) || c->len <= IPSC_CALL_OFF_RSSI_STATUS ||
+        ipsc_wire_get16(c->data + IPSC_CALL_OFF_LENGTH_TO_FOLLOW) == 0 || c->data[IPSC_CALL_OFF_RSSI_STATUS] == 0)
+      return 0;
+
+    *dbm = -(int)c->data[IPSC_CALL_OFF_RSSI_STATUS];
+    return 1;
+}
+
+IPSC_WIRE_API int
+ipsc_wire_call_rssi_threshold(const ipsc_wire_call_t *c, int *dbm)
+{
+    if (!ipsc_wire_call_has_rssi(c) || c->len <= IPSC_CALL_OFF_RSSI_THRESHOLD ||
+        (c->data[IPSC_CALL_OFF_RSSI_THRESHOLD] & ~IPSC_RSSI_THRESHOLD_PARITY) == 0)
+      return 0;
+
+    *dbm = -(int)(c->data[IPSC_CALL_OFF_RSSI_THRESHOLD] & ~IPSC_RSSI_THRESHOLD_PARITY);
+    return 1;
+}
+
+/*
+ * Running min/avg/max of RSSI over a time bucket. Buckets start on a
+ * multiple of their length in seconds since the epoch, so buckets of
+ * different repeaters and captures line up.
+ */
+typedef struct _ipsc_wire_rssi_stats_t {
+    int64_t  start;         /* s since the epoch */
+    uint32_t count;
+    int      min;           /* dBm */
+    int      max;
+    int64_t  sum;
+} ipsc_wire_rssi_stats_t;
+
+IPSC_WIRE_API int64_t
+ipsc_wire_rssi_bucket(int64_t secs, unsigned length)
+{
+    int64_t start = secs - secs % (int64_t)length;
+
+    return (secs < 0 && start != secs) ? start - length : start;
+}
+
+IPSC_WIRE_API void
+ipsc_wire_rssi_stats_add(ipsc_wire_rssi_stats_t *s, int dbm)
+{
+    if (!s->count || dbm < s->min)
+      s->min = dbm;
+    if (!s->count || dbm > s->max)
+      s->max = dbm;
+    s->sum += dbm;
+    s->count++;
+}
+
+IPSC_WIRE_API double
+ipsc_wire_rssi_stats_avg(const ipsc_wire_rssi_stats_t *s)
+{
+    return s->count ? (double)s->sum / s->count : 0.0;
+}
+
+/*
+ * CSBK, ETSI TS 102 361-1 9.1.5 and 9.2.8
+ */
+typedef struct _ipsc_wire_csbk_t {
+    const uint8_t *data;
+} ipsc_wire_csbk_t;
+
+IPSC_WIRE_API int
+ipsc_wire_csbk(const uint8_t *payload, size_t len, ipsc_wire_csbk_t *csbk)
+{
+    if (len < IPSC_BURST_LEN)
+      return 0;
+    csbk->data = payload;
+    return 1;
+}
+
+IPSC_WIRE_API int      ipsc_wire_csbk_lb(const ipsc_wire_csbk_t *b)     { return (b->data[0] & 0x80) != 0; }
+IPSC_WIRE_API int      ipsc_wire_csbk_pf(const ipsc_wire_csbk_t *b)     { return (b->data[0] & 0x40) != 0; }
+IPSC_WIRE_API uint8_t  ipsc_wire_csbk_csbko(const ipsc_wire_csbk_t *b)  { return b->data[0] & 0x3f; }
+IPSC_WIRE_API uint8_t  ipsc_wire_csbk_fid(const ipsc_wire_csbk_t *b)    { return b->data[1]; }
+IPSC_WIRE_API uint8_t  ipsc_wire_csbk_byte3(const ipsc_wire_csbk_t *b)  { return b->data[2]; }
+IPSC_WIRE_API uint8_t  ipsc_wire_csbk_byte4(const ipsc_wire_csbk_t *b)  { return b->data[3]; }
+IPSC_WIRE_API uint32_t ipsc_wire_csbk_dst_id(const ipsc_wire_csbk_t *b) { return ipsc_wire_get24(b->data + 4); }
+IPSC_WIRE_API uint32_t ipsc_wire_csbk_src_id(const ipsc_wire_csbk_t *b) { return ipsc_wire_get24(b->data + 7); }
+IPSC_WIRE_API uint16_t ipsc_wire_csbk_crc(const ipsc_wire_csbk_t *b)    { return ipsc_wire_get16(b->data + 10); }
+
+/* Feature Set Ids that have CSBKs of their own, TS 102 361-2 and Motorola */
+#define IPSC_CSBK_FID_STANDARD          0x00
+#define IPSC_CSBK_FID_CONNECT_PLUS      0x06
+#define IPSC_CSBK_FID_MOTOROLA          0x10
+
+#define IPSC_CSBKO_PREAMBLE             0x3d
+
+/*
+ * Full Link Control, ETSI TS 102 361-1 7.1.1 and 9.1.6
+ */
+typedef struct _ipsc_wire_full_lc_t {
+    const uint8_t *data;
+} ipsc_wire_full_lc_t;
+
+IPSC_WIRE_API int
+ipsc_wire_full_lc(const uint8_t *payload, size_t len, ipsc_wire_full_lc_t *lc)
+{
+    if (len < IPSC_BURST_LEN)
+      return 0;
+    lc->data = payload;
+    return 1;
+}
+
+IPSC_WIRE_API int      ipsc_wire_full_lc_pf(const ipsc_wire_full_lc_t *l)              { return (l->data[0] & 0x80) != 0; }
+IPSC_WIRE_API uint8_t  ipsc_wire_full_lc_flco(const ipsc_wire_full_lc_t *l)            { return l->data[0] & 0x3f; }
+IPSC_WIRE_API uint8_t  ipsc_wire_full_lc_fid(const ipsc_wire_full_lc_t *l)             { return l->data[1]; }
+IPSC_WIRE_API uint8_t  ipsc_wire_full_lc_service_options(const ipsc_wire_full_lc_t *l) { return l->data[2]; }
+IPSC_WIRE_API uint32_t ipsc_wire_full_lc_dst_id(const ipsc_wire_full_lc_t *l)          { return ipsc_wire_get24(l->data + 3); }
+IPSC_WIRE_API uint32_t ipsc_wire_full_lc_src_id(const ipsc_wire_full_lc_t *l)          { return ipsc_wire_get24(l->data + 6); }
+
+/* Full LC Opcodes of voice calls, TS 102 361-2 7.1.1 */
+#define IPSC_FLCO_GROUP_VOICE           0x00
+#define IPSC_FLCO_UNIT_TO_UNIT_VOICE    0x03
+
+/*
+ * Data Header, ETSI TS 102 361-1 9.2.6 and 9.2.7
+ */
+typedef struct _ipsc_wire_data_hdr_t {
+    const uint8_t *data;
+} ipsc_wire_data_hdr_t;
+
+IPSC_WIRE_API int
+ipsc_wire_data_hdr(const uint8_t *payload, size_t len, ipsc_wire_data_hdr_t *hdr)
+{
+    if (len < IPSC_BURST_LEN)
+      return 0;
+    hdr->data = payload;
+    return 1;
+}
+
+IPSC_WIRE_API int      ipsc_wire_data_hdr_group(const ipsc_wire_data_hdr_t *h)   { return (h->data[0] & 0x80) != 0; }
+IPSC_WIRE_API int      ipsc_wire_data_hdr_ack(const ipsc_wire_data_hdr_t *h)     { return (h->data[0] & 0x40) != 0; }
+IPSC_WIRE_API int      ipsc_wire_data_hdr_hc(const ipsc_wire_data_hdr_t *h)      { return (h->data[0] & 0x20) != 0; }
+IPSC_WIRE_API uint8_t  ipsc_wire_data_hdr_dpf(const ipsc_wire_data_hdr_t *h)     { return h->data[0] & 0x0f; }
+IPSC_WIRE_API uint8_t  ipsc_wire_data_hdr_sap(const ipsc_wire_data_hdr_t *h)     { return h->data[1] >> 4; }
+IPSC_WIRE_API uint32_t ipsc_wire_data_hdr_dst_id(const ipsc_wire_data_hdr_t *h)  { return ipsc_wire_get24(h->data + 2); }
+IPSC_WIRE_API uint32_t ipsc_wire_data_hdr_src_id(const ipsc_wire_data_hdr_t *h)  { return ipsc_wire_get24(h->data + 5); }
+IPSC_WIRE_API int      ipsc_wire_data_hdr_full(const ipsc_wire_data_hdr_t *h)    { return (h->data[8] & 0x80) != 0; }
+IPSC_WIRE_API uint8_t  ipsc_wire_data_hdr_blocks(const ipsc_wire_data_hdr_t *h)  { return h->data[8] & 0x7f; }
+IPSC_WIRE_API int      ipsc_wire_data_hdr_resync(const ipsc_wire_data_hdr_t *h)  { return (h->data[9] & 0x80) != 0; }
+IPSC_WIRE_API uint8_t  ipsc_wire_data_hdr_ns(const ipsc_wire_data_hdr_t *h)      { return (h->data[9] >> 4) & 0x07; }
+IPSC_WIRE_API uint8_t  ipsc_wire_data_hdr_fsn(const ipsc_wire_data_hdr_t *h)     { return h->data[9] & 0x0f; }
+IPSC_WIRE_API uint16_t ipsc_wire_data_hdr_crc(const ipsc_wire_data_hdr_t *h)     { return ipsc_wire_get16(h->data + 10); }
+
+/* Pad Octet Count, its MSB is in the first octet */
+IPSC_WIRE_API uint8_t
+ipsc_wire_data_hdr_pad_octets(const ipsc_wire_data_hdr_t *h)
+{
+    return (h->data[0] & 0x10) | (h->data[1] & 0x0f);
+}
+
+/*
+ * CRC-CCITT of the 96 bit bursts, ETSI TS 102 361-1 B.3.7: x^16 + x^12 +
+ * x^5 + 1 over the first 80 bits, inverted and masked with the value of
+ * the data type from B.3.12. Two octets per step: the CRC is linear, so
+ * the second table is the first one run over a further octet of zeros.
+ */
+#define IPSC_CRC_MASK_CSBK              0xa5a5
+#define IPSC_CRC_MASK_DATA_HDR          0xcccc
+
+static const uint16_t ipsc_wire_crc_ccitt_table[2][256] = {
+  {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50a5, 0x60c6, 0x70e7,
+    0x8108, 0x9129, 0xa14a, 0xb16b, 0xc18c, 0xd1ad, 0xe1ce, 0xf1ef,
+    0x1231, 0x0210, 0x3273, 0x2252, 0x52b5, 0x4294, 0x72f7, 0x62d6,
+    0x9339, 0x8318, 0xb37b, 0xa35a, 0xd3bd, 0xc39c, 0xf3ff, 0xe3de,
+    0x2462, 0x3443, 0x0420, 0x1401, 0x64e6, 0x74c7, 0x44a4, 0x5485,
+    0xa56a, 0xb54b, 0x8528, 0x9509, 0xe5ee, 0xf5cf, 0xc5ac, 0xd58d,
+    0x3653, 0x2672, 0x1611, 0x0630, 0x76d7, 0x66f6, 0x5695, 0x46b4,
+    0xb75b, 0xa77a, 0x9719, 0x8738, 0xf7df, 0xe7fe, 0xd79d, 0xc7bc,
+    0x48c4, 0x58e5, 0x6886, 0x78a7, 0x0840, 0x1861, 0x2802, 0x3823,
+    0xc9cc, 0xd9ed, 0xe98e, 0xf9af, 0x8948, 0x9969, 0xa90a, 0xb92b,
+    0x5af5, 0x4ad4, 0x7ab7, 0x6a96, 0x1a71, 0x0a50, 0x3a33, 0x2a12,
+    0xdbfd, 0xcbdc, 0xfbbf, 0xeb9e, 0x9b79, 0x8b58, 0xbb3b, 0xab1a,
+    0x6ca6, 0x7c87, 0x4ce4, 0x5cc5, 0x2c22, 0x3c03, 0x0c60, 0x1c41,
+    0xedae, 0xfd8f, 0xcdec, 0xddcd, 0xad2a, 0xbd0b, 0x8d68, 0x9d49,
+    0x7e97, 0x6eb6, 0x5ed5, 0x4ef4, 0x3e13, 0x2e32, 0x1e51, 0x0e70,
+    0xff9f, 0xefbe, 0xdfdd, 0xcffc, 0xbf1b, 0xaf3a, 0x9f59, 0x8f78,
+    0x9188, 0x81a9, 0xb1ca, 0xa1eb, 0xd10c, 0xc12d, 0xf14e, 0xe16f,
+    0x1080, 0x00a1, 0x30c2, 0x20e3, 0x5004, 0x4025, 0x7046, 0x6067,
+    0x83b9, 0x9398, 0xa3fb, 0xb3da, 0xc33d, 0xd31c, 0xe37f, 0xf35e,
+    0x02b1, 0x1290, 0x22f3, 0x32d2, 0x4235, 0x5214, 0x6277, 0x7256,
+    0xb5ea, 0xa5cb, 0x95a8, 0x8589, 0xf56e, 0xe54f, 0xd52c, 0xc50d,
+    0x34e2, 0x24c3, 0x14a0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+    0xa7db, 0xb7fa, 0x8799, 0x97b8, 0xe75f, 0xf77e, 0xc71d, 0xd73c,
+    0x26d3, 0x36f2, 0x0691, 0x16b0, 0x6657, 0x7676, 0x4615, 0x5634,
+    0xd94c, 0xc96d, 0xf90e, 0xe92f, 0x99c8, 0x89e9, 0xb98a, 0xa9ab,
+    0x5844, 0x4865, 0x7806, 0x6827, 0x18c0, 0x08e1, 0x3882, 0x28a3,
+    0xcb7d, 0xdb5c, 0xeb3f, 0xfb1e, 0x8bf9, 0x9bd8, 0xabbb, 0xbb9a,
+    0x4a75, 0x5a54, 0x6a37, 0x7a16, 0x0af1, 0x1ad0, 0x2ab3, 0x3a92,
+    0xfd2e, 0xed0f, 0xdd6c, 0xcd4d, 0xbdaa, 0xad8b, 0x9de8, 0x8dc9,
+    0x7c26, 0x6c07, 0x5c64, 0x4c45, 0x3ca2, 0x2c83, 0x1ce0, 0x0cc1,
+    0xef1f, 0xff3e, 0xcf5d, 0xdf7c, 0xaf9b, 0xbfba, 0x8fd9, 0x9ff8,
+    0x6e17, 0x7e36, 0x4e55, 0x5e74, 0x2e93, 0x3eb2, 0x0ed1, 0x1ef0
+  },
+  {
+    0x0000, 0x3331, 0x6662, 0x5553, 0xccc4, 0xfff5, 0xaaa6, 0x9997,
+    0x89a9, 0xba98, 0xefcb, 0xdcfa, 0x456d, 0x765c, 0x230f, 0x103e,
+    0x0373, 0x3042, 0x6511, 0x5620, 0xcfb7, 0xfc86, 0xa9d5, 0x9ae4,
+    0x8ada, 0xb9eb, 0xecb8, 0xdf89, 0x461e, 0x752f, 0x207c, 0x134d,
+    0x06e6, 0x35d7, 0x6084, 0x53b5, 0xca22, 0xf913, 0xac40, 0x9f71,
+    0x8f4f, 0xbc7e, 0xe92d, 0xda1c, 0x438b, 0x70ba, 0x25e9, 0x16d8,
+    0x0595, 0x36a4, 0x63f7, 0x50c6, 0xc951, 0xfa60, 0xaf33, 0x9c02,
+    0x8c3c, 0xbf0d, 0xea5e, 0xd96f, 0x40f8, 0x73c9, 0x269a, 0x15ab,
+    0x0dcc, 0x3efd, 0x6bae, 0x589f, 0xc108, 0xf239, 0xa76a, 0x945b,
+    0x8465, 0xb754, 0xe207, 0xd136, 0x48a1, 0x7b90, 0x2ec3, 0x1df2,
+    0x0ebf, 0x3d8e, 0x68dd, 0x5bec, 0xc27b, 0xf14a, 0xa419, 0x9728,
+    0x8716, 0xb427, 0xe174, 0xd245, 0x4bd2, 0x78e3, 0x2db0, 0x1e81,
+    0x0b2a, 0x381b, 0x6d48, 0x5e79, 0xc7ee, 0xf4df, 0xa18c, 0x92bd,
+    0x8283, 0xb1b2, 0xe4e1, 0xd7d0, 0x4e47, 0x7d76, 0x2825, 0x1b14,
+    0x0859, 0x3b68, 0x6e3b, 0x5d0a, 0xc49d, 0xf7ac, 0xa2ff, 0x91ce,
+    0x81f0, 0xb2c1, 0xe792, 0xd4a3, 0x4d34, 0x7e05, 0x2b56, 0x1867,
+    0x1b98, 0x28a9, 0x7dfa, 0x4ecb, 0xd75c, 0xe46d, 0xb13e, 0x820f,
+    0x9231, 0xa100, 0xf453, 0xc762, 0x5ef5, 0x6dc4, 0x3897, 0x0ba6,
+    0x18eb, 0x2bda, 0x7e89, 0x4db8, 0xd42f, 0xe71e, 0xb24d, 0x817c,
+    0x9142, 0xa273, 0xf720, 0xc411, 0x5d86, 0x6eb7, 0x3be4, 0x08d5,
+    0x1d7e, 0x2e4f, 0x7b1c, 0x482d, 0xd1ba, 0xe28b, 0xb7d8, 0x84e9,
+    0x94d7, 0xa7e6, 0xf2b5, 0xc184, 0x5813, 0x6b22, 0x3e71, 0x0d40,
+    0x1e0d, 0x2d3c, 0x786f, 0x4b5e, 0xd2c9, 0xe1f8, 0xb4ab, 0x879a,
+    0x97a4, 0xa495, 0xf1c6, 0xc2f7, 0x5b60, 0x6851, 0x3d02, 0x0e33,
+    0x1654, 0x2565, 0x7036, 0x4307, 0xda90, 0xe9a1, 0xbcf2, 0x8fc3,
+    0x9ffd, 0xaccc, 0xf99f, 0xcaae, 0x5339, 0x6008, 0x355b, 0x066a,
+    0x1527, 0x2616, 0x7345, 0x4074, 0xd9e3, 0xead2, 0xbf81, 0x8cb0,
+    0x9c8e, 0xafbf, 0xfaec, 0xc9dd, 0x504a, 0x637b, 0x3628, 0x0519,
+    0x10b2, 0x2383, 0x76d0, 0x45e1, 0xdc76, 0xef47, 0xba14, 0x8925,
+    0x991b, 0xaa2a, 0xff79, 0xcc48, 0x55df, 0x66ee, 0x33bd, 0x008c,
+    0x13c1, 0x20f0, 0x75a3, 0x4692, 0xdf05, 0xec34, 0xb967, 0x8a56,
+    0x9a68, 0xa959, 0xfc0a, 0xcf3b, 0x56ac, 0x659d, 0x30ce, 0x03ff
+  }
+};
+
+IPSC_WIRE_API uint16_t
+ipsc_wire_crc_ccitt(const uint8_t *p, size_t len)
+{
+    uint16_t crc = 0;
+
+    for (; len >= 2; len -= 2, p += 2)
+    {
+      crc ^= (uint16_t)(p[0] << 8 | p[1]);
+      crc = ipsc_wire_crc_ccitt_table[1][crc >> 8] ^ ipsc_wire_crc_ccitt_table[0][crc & 0xff];
+    }
+    if (len)
+      crc = (uint16_t)(crc << 8) ^ ipsc_wire_crc_ccitt_table[0][(crc >> 8) ^ *p];
+
+    return crc;
+}
+
+/* The CRC a 96 bit burst of that mask should carry in its last two octets */
+IPSC_WIRE_API uint16_t
+ipsc_wire_burst_crc(const uint8_t *burst, uint16_t mask)
+{
+    return (uint16_t)~ipsc_wire_crc_ccitt(burst, IPSC_BURST_LEN - 2) ^ mask;
+}
+
+IPSC_WIRE_API int
+ipsc_wire_csbk_crc_ok(const ipsc_wire_csbk_t *b)
+{
+    return ipsc_wire_burst_crc(b->data, IPSC_CRC_MASK_CSBK) == ipsc_wire_csbk_crc(b);
+}
+
+IPSC_WIRE_API int
+ipsc_wire_data_hdr_crc_ok(const ipsc_wire_data_hdr_t *h)
+{
+    return ipsc_wire_burst_crc(h->data, IPSC_CRC_MASK_DATA_HDR) == ipsc_wire_data_hdr_crc(h);
+}
+
+/*
+ * Forward error correction, ETSI TS 102 361-1 B.1 and B.3. The codes
+ * are systematic: a code word is the data, first bit most significant,
+ * followed by the parity. The syndrome is the parity the data should
+ * have, from the encoding table, XOR the parity received; the syndrome
+ * table turns it into the error pattern. Both tables of a code are
+ * built the first time it is used, so a word costs two lookups.
+ */
+#define IPSC_FEC_GOLAY_20_8             0   /* slot type */
+#define IPSC_FEC_QR_16_7                1   /* EMB */
+#define IPSC_FEC_HAMMING_15_11          2   /* BPTC(196,96) rows */
+#define IPSC_FEC_HAMMING_13_9           3   /* BPTC(196,96) columns */
+#define IPSC_FEC_HAMMING_16_11          4   /* embedded LC rows */
+#define IPSC_FEC_CODES                  5
+
+/* Syndrome table entries: error pattern, bit count in the top octet */
+#define IPSC_FEC_UNCORRECTABLE          0xffffffffU
+
+typedef struct _ipsc_wire_fec_code_t {
+    unsigned        k;          /* data bits */
+    unsigned        p;          /* parity bits */
+    unsigned        t;          /* errors corrected */
+    const uint16_t *rows;       /* parity of each data bit, the first bit first */
+    uint16_t       *encode;     /* parity of every data word */
+    uint32_t       *syndrome;   /* error pattern of every syndrome */
+} ipsc_wire_fec_code_t;
+
+IPSC_WIRE_API uint32_t
+ipsc_wire_fec_syndrome(const ipsc_wire_fec_code_t *code, uint32_t word)
+{
+    return (code->encode[word >> code->p] ^ word) & ((1U << code->p) - 1);
+}
+
+/* Every error pattern of up to left more bits, from bit from on */
+IPSC_WIRE_API void
+ipsc_wire_fec_errors(ipsc_wire_fec_code_t *code, uint32_t e, unsigned from, unsigned left, unsigned count)
+{
+    unsigned i;
+
+    code->syndrome[ipsc_wire_fec_syndrome(code, e)] = e | (uint32_t)count << 24;
+    if (!left)
+      return;
+    for (i = from; i < code->k + code->p; i++)
+      ipsc_wire_fec_errors(code, e | 1U << i, i + 1, left - 1, count + 1);
+}
+
+/* The encode and syndrome tables of all the codes, once */
+IPSC_WIRE_API void
+ipsc_wire_fec_build(ipsc_wire_fec_code_t *codes)
+{
+    ipsc_wire_fec_code_t *code;
+    unsigned i, d;
+
+    for (code = codes; code < codes + IPSC_FEC_CODES; code++)
+    {
+      for (d = 0; d < 1U << code->k; d++)
+      {
+        code->encode[d] = 0;
+        for (i = 0; i < code->k; i++)
+          if (d & 1U << (code->k - 1 - i))
+            code->encode[d] ^= code->rows[i];
+      }
+      for (i = 0; i < 1U << code->p; i++)
+        code->syndrome[i] = IPSC_FEC_UNCORRECTABLE;
+      ipsc_wire_fec_errors(code, 0, 0, code->t, 0);
+    }
+}
+
+IPSC_WIRE_API const ipsc_wire_fec_code_t *
+ipsc_wire_fec(unsigned id)
+{
+    /*
+     * Golay(20,8): x^11 + x^10 + x^6 + x^5 + x^4 + x^2 + 1 and even parity.
+     * QR(16,7,6): x^8 + x^5 + x^4 + x^3 + 1 and even parity.
+     * Hamming(15,11,3), (13,9,3) and (16,11,4): the equations of B.3.5 and B.3.6.
+     */
+    static const uint16_t golay_rows[8] = {
+      0x3da, 0xd99, 0x6cd, 0x367, 0xdc6, 0xa97, 0x93e, 0x8eb
+    };
+    static const uint16_t qr_rows[7] = {
+      0x04f, 0x11e, 0x1b7, 0x1e2, 0x1c9, 0x0e5, 0x073
+    };
+    static const uint16_t h15_rows[11] = {
+      0x9, 0xd, 0xf, 0xe, 0x7, 0xa, 0x5, 0xb, 0xc, 0x6, 0x3
+    };
+    static const uint16_t h13_rows[9] = {
+      0xf, 0xe, 0x7, 0xa, 0x5, 0xb, 0xc, 0x6, 0x3
+    };
+    static const uint16_t h16_rows[11] = {
+      0x13, 0x1a, 0x1f, 0x1c, 0x0e, 0x15, 0x0b, 0x16, 0x19, 0x0d, 0x07
+    };
+    static uint16_t golay_encode[1 << 8], qr_encode[1 << 7];
+    static uint16_t h15_encode[1 << 11], h13_encode[1 << 9], h16_encode[1 << 11];
+    static uint32_t golay_syndrome[1 << 12], qr_syndrome[1 << 9];
+    static uint32_t h15_syndrome[1 << 4], h13_syndrome[1 << 4], h16_syndrome[1 << 5];
+    static ipsc_wire_fec_code_t codes[IPSC_FEC_CODES] = {
+      { 8, 12, 3, golay_rows, golay_encode, golay_syndrome },
+      { 7, 9, 2, qr_rows, qr_encode, qr_syndrome },
+      { 11, 4, 1, h15_rows, h15_encode, h15_syndrome },
+      { 9, 4, 1, h13_rows, h13_encode, h13_syndrome },
+      { 11, 5, 1, h16_rows, h16_encode, h16_syndrome }
+    };
+    static int ready = 0;
+
+    if (!ready)
+    {
+      ipsc_wire_fec_build(codes);
+      ready = 1;
+    }
+
+    return &codes[id];
+}
+
+IPSC_WIRE_API uint32_t
+ipsc_wire_fec_encode(unsigned id, uint32_t data)
+{
+    const ipsc_wire_fec_code_t *code = ipsc_wire_fec(id);
+
+    return data << code->p | code->encode[data];
+}
+
+/* Corrects the code word in place; bits corrected, -1 if it cannot be */
+IPSC_WIRE_API int
+ipsc_wire_fec_decode(unsigned id, uint32_t *word)
+{
+    const ipsc_wire_fec_code_t *code = ipsc_wire_fec(id);
+    uint32_t e = code->syndrome[ipsc_wire_fec_syndrome(code, *word)];
+
+    if (e == IPSC_FEC_UNCORRECTABLE)
+      return -1;
+    *word ^= e & 0xffffff;
+    return (int)(e >> 24);
+}
+
+IPSC_WIRE_API unsigned
+ipsc_wire_bit(const uint8_t *p, unsigned i)
+{
+    return (p[i >> 3] >> (7 - (i & 7))) & 1;
+}
+
+IPSC_WIRE_API void
+ipsc_wire_set_bit(uint8_t *p, unsigned i, unsigned b)
+{
+    if (b)
+      p[i >> 3] |= (uint8_t)(0x80 >> (i & 7));
+    else
+      p[i >> 3] &= (uint8_t)~(0x80 >> (i & 7));
+}
+
+/*
+ * A burst as sent on the air, 264 bits: 98 bits of BPTC(196,96), 10 of
+ * slot type, 48 of sync or EMB, 10 of slot type and 98 of BPTC. Some
+ * repeaters forward the Voice LC Header, Terminator, CSBK, Data Header
+ * and Rate 1/2 data like this, with a Data Size of 264 bits, instead
+ * of the 96 decoded bits.
+ */
+#define IPSC_RAW_BURST_LEN              33
+#define IPSC_RAW_BURST_BITS             264
+#define IPSC_BPTC_BITS                  196
+
+/* BPTC bit i is at this bit of the burst */
+IPSC_WIRE_API unsigned
+ipsc_wire_bptc_pos(unsigned i)
+{
+    return i < IPSC_BPTC_BITS / 2 ? i : i + 68;
+}
+
+/* Slot type bit i, 0 to 19 */
+IPSC_WIRE_API unsigned
+ipsc_wire_slot_type_pos(unsigned i)
+{
+    return i < 10 ? 98 + i : 146 + i;
+}
+
+/* Colour code and data type, 4 bits each; bits corrected, -1 if it cannot be */
+IPSC_WIRE_API int
+ipsc_wire_slot_type_decode(const uint8_t *raw, uint8_t *slot_type)
+{
+    uint32_t word = 0;
+    unsigned i;
+    int errors;
+
+    for (i = 0; i < 20; i++)
+      word = word << 1 | ipsc_wire_bit(raw, ipsc_wire_slot_type_pos(i));
+
+    errors = ipsc_wire_fec_decode(IPSC_FEC_GOLAY_20_8, &word);
+    *slot_type = (uint8_t)(word >> 12);
+    return errors;
+}
+
+IPSC_WIRE_API void
+ipsc_wire_slot_type_encode(uint8_t slot_type, uint8_t *raw)
+{
+    uint32_t word = ipsc_wire_fec_encode(IPSC_FEC_GOLAY_20_8, slot_type);
+    unsigned i;
+
+    for (i = 0; i < 20; i++)
+      ipsc_wire_set_bit(raw, ipsc_wire_slot_type_pos(i), (word >> (19 - i)) & 1);
+}
+
+/*
+ * BPTC(196,96), B.1.1: the bits are interleaved with index i * 181 mod
+ * 196 over a 13 x 15 matrix that starts after one reserved bit. The 9
+ * first rows are Hamming(15,11,3) and all 15 columns Hamming(13,9,3),
+ * which makes the 4 parity rows Hamming(15,11,3) words too. Columns
+ * and rows are corrected in turn until nothing changes, and the burst
+ * is good when every row and column then checks out. The 96 data bits
+ * are the 11 first of each of the 9 rows, less 3 more reserved bits at
+ * the start.
+ */
+#define IPSC_BPTC_PASSES                5
+
+IPSC_WIRE_API unsigned
+ipsc_wire_bptc_matrix(unsigned row, unsigned col)
+{
+    return 1 + row * 15 + col;
+}
+
+/* Burst bit of every matrix bit, built on first use */
+IPSC_WIRE_API const uint16_t *
+ipsc_wire_bptc_interleave(void)
+{
+    static uint16_t pos[IPSC_BPTC_BITS];
+    static int ready = 0;
+    unsigned i;
+
+    if (!ready)
+    {
+      for (i = 0; i < IPSC_BPTC_BITS; i++)
+        pos[i] = (uint16_t)ipsc_wire_bptc_pos(i * 181 % IPSC_BPTC_BITS);
+      ready = 1;
+    }
+
+    return pos;
+}
+
+/* Column syndromes, all 15 at once: check k of every column in one word */
+IPSC_WIRE_API uint32_t
+ipsc_wire_bptc_column_checks(const uint32_t *rows, uint32_t *checks)
+{
+    const ipsc_wire_fec_code_t *h13 = ipsc_wire_fec(IPSC_FEC_HAMMING_13_9);
+    unsigned k, row;
+
+    for (k = 0; k < 4; k++)
+    {
+      checks[k] = rows[12 - k];
+      for (row = 0; row < 9; row++)
+        if (h13->rows[row] & 1U << k)
+          checks[k] ^= rows[row];
+    }
+
+    /* Columns with a syndrome */
+    return checks[0] | checks[1] | checks[2] | checks[3];
+}
+
+/* 96 bits from the burst, bits corrected or -1 if errors remain */
+IPSC_WIRE_API int
+ipsc_wire_bptc_decode(const uint8_t *raw, uint8_t *info)
+{
+    const uint16_t *pos = ipsc_wire_bptc_interleave();
+    const ipsc_wire_fec_code_t *h13 = ipsc_wire_fec(IPSC_FEC_HAMMING_13_9);
+    const ipsc_wire_fec_code_t *h15 = ipsc_wire_fec(IPSC_FEC_HAMMING_15_11);
+    uint32_t rows[13], received[13], checks[4], word, e, s;
+    uint64_t acc;
+    unsigned i, row, col, n, p, k;
+    int errors = 0, fixed = 1, pass;
+
+    /* One word per row, the first column in the top bit */
+    for (row = 0, i = 1; row < 13; row++)
+    {
+      for (col = 0, word = 0; col < 15; col++, i++)
+      {
+        p = pos[i];
+        word = word << 1 | ((raw[p >> 3] >> (7 - (p & 7))) & 1);
+      }
+      rows[row] = received[row] = word;
+    }
+
+    for (pass = 0; pass < IPSC_BPTC_PASSES && fixed; pass++)
+    {
+      fixed = 0;
+
+      if (ipsc_wire_bptc_column_checks(rows, checks))
+      {
+        for (col = 0; col < 15; col++)
+        {
+          for (k = 0, s = 0; k < 4; k++)
+            s |= ((checks[k] >> (14 - col)) & 1) << k;
+          e = h13->syndrome[s];
+          if (!s || e == IPSC_FEC_UNCORRECTABLE)
+            continue;
+          for (row = 0; row < 13; row++)
+            if (e & 1U << (12 - row))
+              rows[row] ^= 1U << (14 - col);
+          fixed = 1;
+        }
+      }
+
+      /* The parity rows are Hamming(15,11,3) words as well */
+      for (row = 0; row < 13; row++)
+      {
+        e = h15->syndrome[ipsc_wire_fec_syndrome(h15, rows[row])];
+        if (e && e != IPSC_FEC_UNCORRECTABLE)
+        {
+          rows[row] ^= e & 0xffffff;
+          fixed = 1;
+        }
+      }
+    }
+
+    /* 8 bits of the first row, then 11 of each of the others */
+    acc = (rows[0] >> 4) & 0xff;
+    for (row = 1, n = 8, i = 0; row < 9; row++)
+    {
+      acc = acc << 11 | ((rows[row] >> 4) & 0x7ff);
+      for (n += 11; n >= 8; n -= 8)
+        info[i++] = (uint8_t)(acc >> (n - 8));
+    }
+
+    /* Good only if every row and column checks out; corrected is what differs from the burst */
+    if (ipsc_wire_bptc_column_checks(rows, checks))
+      return -1;
+    for (row = 0; row < 13; row++)
+    {
+      if (ipsc_wire_fec_syndrome(h15, rows[row]))
+        return -1;
+      for (word = rows[row] ^ received[row]; word; word &= word - 1)
+        errors++;
+    }
+
+    return errors;
+}
+
+IPSC_WIRE_API void
+ipsc_wire_bptc_encode(const uint8_t *info, uint8_t *raw)
+{
+    uint8_t m[IPSC_BPTC_BITS];
+    uint32_t word;
+    unsigned i, row, col, n;
+
+    for (i = 0; i < IPSC_BPTC_BITS; i++)
+      m[i] = 0;
+    for (row = 0, n = 0; row < 9; row++)
+      for (col = row ? 0 : 3; col < 11; col++, n++)
+        m[ipsc_wire_bptc_matrix(row, col)] = (uint8_t)ipsc_wire_bit(info, n);
+
+    for (row = 0; row < 9; row++)
+    {
+      for (col = 0, word = 0; col < 11; col++)
+        word = word << 1 | m[ipsc_wire_bptc_matrix(row, col)];
+      word = ipsc_wire_fec_encode(IPSC_FEC_HAMMING_15_11, word);
+      for (col = 11; col < 15; col++)
+        m[ipsc_wire_bptc_matrix(row, col)] = (uint8_t)((word >> (14 - col)) & 1);
+    }
+
+    for (col = 0; col < 15; col++)
+    {
+      for (row = 0, word = 0; row < 9; row++)
+        word = word << 1 | m[ipsc_wire_bptc_matrix(row, col)];
+      word = ipsc_wire_fec_encode(IPSC_FEC_HAMMING_13_9, word);
+      for (row = 9; row < 13; row++)
+        m[ipsc_wire_bptc_matrix(row, col)] = (uint8_t)((word >> (12 - row)) & 1);
+    }
+
+    for (i = 0; i < IPSC_BPTC_BITS; i++)
+      ipsc_wire_set_bit(raw, ipsc_wire_bptc_interleave()[i], m[i]);
+}
+
+/* The raw burst of a call packet, NULL if it carries the 96 bits or no BPTC burst */
+IPSC_WIRE_API const uint8_t *
+ipsc_wire_call_raw_burst(const ipsc_wire_call_t *c)
+{
+    const uint8_t *payload;
+    size_t len;
+
+    switch (ipsc_wire_call_data_type(c))
+    {
+      case IPSC_DATA_TYPE_VOICE_LC_HDR:
+      case IPSC_DATA_TYPE_TERMINATOR_LC:
+      case IPSC_DATA_TYPE_CSBK:
+      case IPSC_DATA_TYPE_DATA_HDR:
+      case IPSC_DATA_TYPE_RATE_12:
+        break;
+      default:
+        return NULL;
+    }
+
+    if ((payload = ipsc_wire_call_payload(c, &len)) == NULL || len < IPSC_RAW_BURST_LEN ||
+        ipsc_wire_get16(c->data + IPSC_CALL_OFF_DATA_SIZE) != IPSC_RAW_BURST_BITS)
+      return NULL;
+    return payload;
+}
+
+/*
+ * Voice burst, in a GROUP_VOICE of data type Rate 1 that is exactly
+ * IPSC_VOICE_LEN or IPSC_VOICE_EMBEDDED_LEN long. Everything is at a
+ * fixed offset from the burst position octet.
+ */
+typedef struct _ipsc_wire_voice_t {
+    const uint8_t *data;
+    size_t len;
+} ipsc_wire_voice_t;
+
+IPSC_WIRE_API int
+ipsc_wire_voice(const ipsc_wire_call_t *c, ipsc_wire_voice_t *v)
+{
+    size_t len;
+
+    if (c->data[IPSC_OFF_OPCODE] != 0x80 || ipsc_wire_call_data_type(c) != IPSC_DATA_TYPE_RATE_1 ||
+        c->len < IPSC_CALL_OFF_PAYLOAD2)
+      return 0;
+
+    len = c->data[IPSC_CALL_OFF_LENGTH2];
+    if ((len != IPSC_VOICE_LEN && len != IPSC_VOICE_EMBEDDED_LEN) || c->len < IPSC_CALL_OFF_PAYLOAD2 + len ||
+        c->data[IPSC_CALL_OFF_PAYLOAD2 + IPSC_VOICE_OFF_BURST] >= IPSC_VOICE_BURSTS)
+      return 0;
+
+    v->data = c->data + IPSC_CALL_OFF_PAYLOAD2;
+    v->len = len;
+    return 1;
+}
+
+/* 0 (A) to 5 (F) */
+IPSC_WIRE_API uint8_t  ipsc_wire_voice_burst(const ipsc_wire_voice_t *v)          { return v->data[IPSC_VOICE_OFF_BURST]; }
+IPSC_WIRE_API int      ipsc_wire_voice_has_emb(const ipsc_wire_voice_t *v)        { return v->len == IPSC_VOICE_EMBEDDED_LEN; }
+
+/* EMB and embedded signalling, only if ipsc_wire_voice_has_emb() */
+IPSC_WIRE_API uint16_t ipsc_wire_voice_emb(const ipsc_wire_voice_t *v)            { return ipsc_wire_get16(v->data + IPSC_VOICE_OFF_EMB); }
+IPSC_WIRE_API uint8_t  ipsc_wire_voice_emb_cc(const ipsc_wire_voice_t *v)         { return v->data[IPSC_VOICE_OFF_EMB] >> 4; }
+IPSC_WIRE_API int      ipsc_wire_voice_emb_pi(const ipsc_wire_voice_t *v)         { return (v->data[IPSC_VOICE_OFF_EMB] & 0x08) != 0; }
+IPSC_WIRE_API uint8_t  ipsc_wire_voice_emb_lcss(const ipsc_wire_voice_t *v)       { return (v->data[IPSC_VOICE_OFF_EMB] >> 1) & 0x03; }
+IPSC_WIRE_API uint32_t ipsc_wire_voice_embedded(const ipsc_wire_voice_t *v)       { return ipsc_wire_get32(v->data + IPSC_VOICE_OFF_EMBEDDED); }
+
+/* EMB after QR(16,7,6), bits corrected or -1 if it cannot be */
+IPSC_WIRE_API int
+ipsc_wire_voice_emb_decode(const ipsc_wire_voice_t *v, uint16_t *emb)
+{
+    uint32_t word = ipsc_wire_voice_emb(v);
+    int errors = ipsc_wire_fec_decode(IPSC_FEC_QR_16_7, &word);
+
+    *emb = (uint16_t)word;
+    return errors;
+}
+
+/* AMBE+2 frame 0 to 2, IPSC_VOICE_AMBE_FRAME_LEN octets */
+IPSC_WIRE_API const uint8_t *
+ipsc_wire_voice_ambe(const ipsc_wire_voice_t *v, unsigned i)
+{
+    return v->data + IPSC_VOICE_OFF_AMBE + i * IPSC_VOICE_AMBE_FRAME_LEN;
+}
+
+/*
+ * Embedded LC, ETSI TS 102 361-1 B.2.1: 72 bits of LC and a 5 bit
+ * checksum in the first 7 rows of a 8 x 16 matrix, sent down the
+ * columns as the embedded signalling of bursts B, C, D and E. Bit
+ * (row, column) of the matrix is bit column * 8 + row of the 128 bits.
+ * Rows 0 and 1 carry 11 LC bits, rows 2 to 6 carry 10 and a checksum
+ * bit in column 10; each of the 7 is Hamming(16,11,4) and the last row
+ * is the even parity of the columns.
+ */
+#define IPSC_EMB_LC_RAW_LEN             16  /* the four embedded signalling fragments */
+#define IPSC_EMB_LC_LEN                 9
+
+#define IPSC_EMB_LCSS_SINGLE            0
+#define IPSC_EMB_LCSS_FIRST             1
+#define IPSC_EMB_LCSS_LAST              2
+#define IPSC_EMB_LCSS_CONTINUATION      3
+
+/*
+ * LC from the 128 bits, returns 1 if its checksum is right. errors
+ * gets the bits the rows corrected, -1 if a row or column is still
+ * wrong after that. With the 7 rows good, a single bit off in the
+ * parity row is the parity row's own error and counts as corrected.
+ */
+IPSC_WIRE_API int
+ipsc_wire_emb_lc_decode(const uint8_t *raw, uint8_t *lc, int *errors)
+{
+    uint32_t rows[8], parity = 0;
+    unsigned row, col, n = 0, sum = 0, cs = 0;
+    int e;
+
+    *errors = 0;
+    for (row = 0; row < 8; row++)
+    {
+      for (col = 0, rows[row] = 0; col < 16; col++)
+        rows[row] = rows[row] << 1 | ipsc_wire_bit(raw, col * 8 + row);
+      if (row == 7)
+        break;
+      if ((e = ipsc_wire_fec_decode(IPSC_FEC_HAMMING_16_11, &rows[row])) < 0)
+        *errors = -1;
+      else if (*errors >= 0)
+        *errors += e;
+      parity ^= rows[row];
+    }
+    /* The rows decode, so one bit off is in the parity row itself */
+    parity ^= rows[7];
+    if (parity && *errors >= 0 && !(parity & (parity - 1)))
+      *errors += 1;
+    else if (parity)
+      *errors = -1;
+
+    for (n = 0; n < IPSC_EMB_LC_LEN; n++)
+      lc[n] = 0;
+
+    for (row = 0, n = 0; row < 7; row++)
+    {
+      for (col = 0; col < (row < 2 ? 11U : 10U); col++, n++)
+        ipsc_wire_set_bit(lc, n, (rows[row] >> (15 - col)) & 1);
+      if (row >= 2)
+        cs = cs << 1 | ((rows[row] >> 5) & 1);
+    }
+
+    for (n = 0; n < IPSC_EMB_LC_LEN; n++)
+      sum += lc[n];
+
+    return sum % 31 == cs;
+}
+
+/* The 128 bits of an LC, as the embedded signalling of B to E */
+IPSC_WIRE_API void
+ipsc_wire_emb_lc_encode(const uint8_t *lc, uint8_t *raw)
+{
+    uint32_t rows[8];
+    unsigned row, col, n = 0, sum = 0, cs;
+
+    for (row = 0; row < IPSC_EMB_LC_LEN; row++)
+      sum += lc[row];
+    cs = sum % 31;
+
+    rows[7] = 0;
+    for (row = 0; row < 7; row++)
+    {
+      for (col = 0, rows[row] = 0; col < (row < 2 ? 11U : 10U); col++, n++)
+        rows[row] = rows[row] << 1 | ipsc_wire_bit(lc, n);
+      if (row >= 2)
+        rows[row] = rows[row] << 1 | ((cs >> (6 - row)) & 1);
+      rows[row] = ipsc_wire_fec_encode(IPSC_FEC_HAMMING_16_11, rows[row]);
+      rows[7] ^= rows[row];
+    }
+
+    for (row = 0; row < 8; row++)
+      for (col = 0; col < 16; col++)
+        ipsc_wire_set_bit(raw, col * 8 + row, (rows[row] >> (15 - col)) & 1);
+}
+
+/*
+ * Registration flags of MASTER/PEER_REG and the keepalives
+ */
+typedef struct _ipsc_wire_reg_t {
+    const uint8_t *data;
+} ipsc_wire_reg_t;
+
+/* Returns 1 if the message carries linking, service flags and version */
+IPSC_WIRE_API int
+ipsc_wire_reg(const ipsc_wire_msg_t *msg, ipsc_wire_reg_t *reg)
+{
+    if (msg->len < IPSC_REG_LEN)
+      return 0;
+
+    switch (msg->data[IPSC_OFF_OPCODE])
+    {
+      case 0x90:
+      case 0x91:
+      case 0x94:
+      case 0x95:
+      case 0x96:
+      case 0x97:
+      case 0x98:
+      case 0x99:
+        reg->data = msg->data;
+        return 1;
+
+      default:
+        return 0;
+    }
+}
+
+IPSC_WIRE_API uint8_t  ipsc_wire_reg_linking(const ipsc_wire_reg_t *r)        { return r->data[IPSC_REG_OFF_LINKING]; }
+IPSC_WIRE_API uint32_t ipsc_wire_reg_service_flags(const ipsc_wire_reg_t *r)  { return ipsc_wire_get32(r->data + IPSC_REG_OFF_SERVICE_FLAGS); }
+IPSC_WIRE_API uint8_t  ipsc_wire_reg_flags3(const ipsc_wire_reg_t *r)         { return r->data[IPSC_REG_OFF_SERVICE_FLAGS + 2]; }
+IPSC_WIRE_API uint8_t  ipsc_wire_reg_flags4(const ipsc_wire_reg_t *r)         { return r->data[IPSC_REG_OFF_SERVICE_FLAGS + 3]; }
+IPSC_WIRE_API uint32_t ipsc_wire_reg_version(const ipsc_wire_reg_t *r)        { return ipsc_wire_get32(r->data + IPSC_REG_OFF_VERSION); }
+IPSC_WIRE_API int      ipsc_wire_reg_auth(const ipsc_wire_reg_t *r)           { return (ipsc_wire_reg_flags4(r) & IPSC_FLAGS4_AUTH) != 0; }
+
+/*
+ * Peer entries of PEER_LIST_REPLY, as many whole ones as the packet holds
+ */
+typedef struct _ipsc_wire_peer_list_t {
+    const uint8_t *entries;
+    size_t         count;
+} ipsc_wire_peer_list_t;
+
+/* Returns 1 if the message is a PEER_LIST_REPLY */
+IPSC_WIRE_API int
+ipsc_wire_peer_list(const ipsc_wire_msg_t *msg, ipsc_wire_peer_list_t *list)
+{
+    size_t len;
+
+    if (msg->len < IPSC_PEER_LIST_OFF_ENTRIES || msg->data[IPSC_OFF_OPCODE] != 0x93)
+      return 0;
+
+    len = ipsc_wire_get16(msg->data + IPSC_PEER_LIST_OFF_LENGTH);
+    if (len > msg->len - IPSC_PEER_LIST_OFF_ENTRIES)
+      len = msg->len - IPSC_PEER_LIST_OFF_ENTRIES;
+
+    list->entries = msg->data + IPSC_PEER_LIST_OFF_ENTRIES;
+    list->count = len / IPSC_PEER_LEN;
+    return 1;
+}
+
+/* Entry i, below count */
+IPSC_WIRE_API const uint8_t *
+ipsc_wire_peer(const ipsc_wire_peer_list_t *list, size_t i)
+{
+    return list->entries + i * IPSC_PEER_LEN;
+}
+
+IPSC_WIRE_API uint32_t ipsc_wire_peer_rpt_id(const uint8_t *e)   { return ipsc_wire_get32(e + IPSC_PEER_OFF_RPT_ID); }
+IPSC_WIRE_API uint32_t ipsc_wire_peer_ip(const uint8_t *e)       { return ipsc_wire_get32(e + IPSC_PEER_OFF_IP); }
+IPSC_WIRE_API uint16_t ipsc_wire_peer_port(const uint8_t *e)     { return ipsc_wire_get16(e + IPSC_PEER_OFF_PORT); }
+IPSC_WIRE_API uint8_t  ipsc_wire_peer_linking(const uint8_t *e)  { return e[IPSC_PEER_OFF_LINKING]; }
+
+/*
+ * XNL header, on the XNL data of XCMP_XNL or on a reassembled XNL packet
+ */
+typedef struct _ipsc_wire_xnl_t {
+    const uint8_t *data;
+    size_t         len;
+} ipsc_wire_xnl_t;
+
+/* Returns 1 if the header is there; the payload may still be cut */
+IPSC_WIRE_API int
+ipsc_wire_xnl(const uint8_t *data, size_t len, ipsc_wire_xnl_t *xnl)
+{
+    if (len < IPSC_XNL_HDR_LEN)
+      return 0;
+
+    xnl->data = data;
+    xnl->len = len;
+    return 1;
+}
+
+IPSC_WIRE_API uint16_t ipsc_wire_xnl_opcode(const ipsc_wire_xnl_t *x)       { return ipsc_wire_get16(x->data + IPSC_XNL_HDR_OFF_OPCODE); }
+IPSC_WIRE_API uint8_t  ipsc_wire_xnl_proto(const ipsc_wire_xnl_t *x)        { return x->data[IPSC_XNL_HDR_OFF_PROTO]; }
+IPSC_WIRE_API uint8_t  ipsc_wire_xnl_flags(const ipsc_wire_xnl_t *x)        { return x->data[IPSC_XNL_HDR_OFF_FLAGS]; }
+IPSC_WIRE_API uint16_t ipsc_wire_xnl_dst(const ipsc_wire_xnl_t *x)          { return ipsc_wire_get16(x->data + IPSC_XNL_HDR_OFF_DST); }
+IPSC_WIRE_API uint16_t ipsc_wire_xnl_src(const ipsc_wire_xnl_t *x)          { return ipsc_wire_get16(x->data + IPSC_XNL_HDR_OFF_SRC); }
+IPSC_WIRE_API uint16_t ipsc_wire_xnl_trans_id(const ipsc_wire_xnl_t *x)     { return ipsc_wire_get16(x->data + IPSC_XNL_HDR_OFF_TRANS_ID); }
+IPSC_WIRE_API uint16_t ipsc_wire_xnl_payload_len(const ipsc_wire_xnl_t *x)  { return ipsc_wire_get16(x->data + IPSC_XNL_HDR_OFF_PAYLOAD_LEN); }
+
+/* Octets of the whole XNL packet, header included */
+IPSC_WIRE_API size_t
+ipsc_wire_xnl_total_len(const ipsc_wire_xnl_t *x)
+{
+    return IPSC_XNL_HDR_LEN + ipsc_wire_xnl_payload_len(x);
+}
+
+/* XCMP opcode of an XCMP data message, 0 if it is something else or cut before it */
+IPSC_WIRE_API uint16_t
+ipsc_wire_xcmp_opcode(const ipsc_wire_xnl_t *x)
+{
+    if (ipsc_wire_xnl_opcode(x) != IPSC_XNL_OPCODE_DATA_MSG || ipsc_wire_xnl_proto(x) != IPSC_XNL_PROTO_XCMP ||
+        x->len < IPSC_XNL_HDR_LEN + 2 || ipsc_wire_xnl_payload_len(x) < 2)
+      return 0;
+
+    return ipsc_wire_get16(x->data + IPSC_XNL_HDR_LEN);
+}
+
+#endif /* __IPSC_WIRE_H__ */
@@ -28,6 +28,7 @@
 #include <string.h>
 #include <glib.h>
 #include <epan/packet.h>
+#include <epan/pint.h>
 #include <epan/strutil.h>
 #include <epan/arptypes.h>
 #include <epan/addr_resolv.h>
@@ -38,6 +39,13 @@
 #include <epan/ax25_pids.h>
 #include <epan/prefs.h>
 #include <epan/expert.h>
+#include <epan/tap.h>
+#include <epan/stats_tree.h>
+#include <epan/sha1.h>
+#include <epan/conversation.h>
+
+#include "packet-ipsc.h"
+#include "ipsc-wire.h"
 
 /*
  * TODO: Isolate L3 from L2 by making each
@@ -135,6 +143,8 @@ static int hf_ipsc_data_hdr_byte9_udto_id = -1;
 static int hf_ipsc_data_hdr_byte9_nibble1_id = -1;
 /* CRC */
 static int hf_ipsc_data_hdr_crc_id = -1;
+static int hf_ipsc_data_hdr_crc_good_id = -1;
+static int hf_ipsc_data_hdr_crc_bad_id = -1;
 
 /* CSBK Header */
 static int hf_ipsc_csbk_hdr_byte1_id = -1;
@@ -144,6 +154,33 @@ static int hf_ipsc_csbk_hdr_byte4_id = -1;
 static int hf_ipsc_csbk_hdr_dst_id = -1;
 static int hf_ipsc_csbk_hdr_src_id = -1;
 static int hf_ipsc_csbk_hdr_crc_id = -1;
+static int hf_ipsc_csbk_hdr_crc_good_id = -1;
+static int hf_ipsc_csbk_hdr_crc_bad_id = -1;
+
+/* CSBK by CSBKO */
+static int hf_ipsc_csbk_lb_id = -1;
+static int hf_ipsc_csbk_pf_id = -1;
+static int hf_ipsc_csbk_opcode_id = -1;
+static int hf_ipsc_csbk_service_options_id = -1;
+static int hf_ipsc_csbk_emergency_id = -1;
+static int hf_ipsc_csbk_privacy_id = -1;
+static int hf_ipsc_csbk_broadcast_id = -1;
+static int hf_ipsc_csbk_ovcm_id = -1;
+static int hf_ipsc_csbk_priority_id = -1;
+static int hf_ipsc_csbk_answer_id = -1;
+static int hf_ipsc_csbk_nack_info_id = -1;
+static int hf_ipsc_csbk_nack_source_id = -1;
+static int hf_ipsc_csbk_nack_service_id = -1;
+static int hf_ipsc_csbk_nack_reason_id = -1;
+static int hf_ipsc_csbk_preamble_data_id = -1;
+static int hf_ipsc_csbk_preamble_group_id = -1;
+static int hf_ipsc_csbk_preamble_blocks_id = -1;
+static int hf_ipsc_csbk_grant_channel_id = -1;
+static int hf_ipsc_csbk_grant_slot_id = -1;
+static int hf_ipsc_csbk_grant_late_entry_id = -1;
+static int hf_ipsc_csbk_grant_emergency_id = -1;
+static int hf_ipsc_csbk_grant_offset_id = -1;
+static int hf_ipsc_csbk_data_id = -1;
 
 /* Full LC*/
 static int hf_ipsc_full_lc_byte1_id = -1;
@@ -152,1060 +189,5136 @@ static int hf_ipsc_full_lc_fid_id = -1;
 static int hf_ipsc_voice_pdu_service_options_id = -1;
 static int hf_ipsc_voice_pdu_dst_id = -1;
 static int hf_ipsc_voice_pdu_src_id = -1;
+/* Voice burst */
+static int hf_ipsc_voice_burst_id = -1;
+static int hf_ipsc_voice_ambe_id = -1;
+static int hf_ipsc_voice_emb_id = -1;
+static int hf_ipsc_voice_emb_cc_id = -1;
+static int hf_ipsc_voice_emb_pi_id = -1;
+static int hf_ipsc_voice_emb_lcss_id = -1;
+static int hf_ipsc_voice_emb_parity_id = -1;
+static int hf_ipsc_voice_embedded_id = -1;
+static int hf_ipsc_voice_emb_corrected_id = -1;
+
+/* Embedded LC (generated) */
+static int hf_ipsc_emb_lc_id = -1;
+static int hf_ipsc_emb_lc_checksum_good_id = -1;
+static int hf_ipsc_emb_lc_checksum_bad_id = -1;
+static int hf_ipsc_emb_lc_first_frame_id = -1;
+static int hf_ipsc_emb_lc_corrected_id = -1;
+
+/* Raw bursts, slot type and BPTC(196,96) (generated) */
+static int hf_ipsc_burst_slot_type_id = -1;
+static int hf_ipsc_burst_slot_type_cc_id = -1;
+static int hf_ipsc_burst_slot_type_data_type_id = -1;
+static int hf_ipsc_burst_slot_type_corrected_id = -1;
+static int hf_ipsc_burst_info_id = -1;
+static int hf_ipsc_burst_bptc_corrected_id = -1;
 
 
 static int hf_ipsc_digest_id = -1;
+static int hf_ipsc_digest_good_id = -1;
+static int hf_ipsc_digest_bad_id = -1;
+static int hf_ipsc_digest_key_id = -1;
 
 /* XCMP/XNL */
 static int hf_ipsc_xcmp_xnl_length_id = -1;
 static int hf_ipsc_xcmp_xnl_data_id = -1;
 
+/* XNL header and XCMP */
+static int hf_ipsc_xnl_id = -1;
+static int hf_ipsc_xnl_opcode_id = -1;
+static int hf_ipsc_xnl_proto_id = -1;
+static int hf_ipsc_xnl_flags_id = -1;
+static int hf_ipsc_xnl_dst_id = -1;
+static int hf_ipsc_xnl_src_id = -1;
+static int hf_ipsc_xnl_trans_id_id = -1;
+static int hf_ipsc_xnl_payload_len_id = -1;
+static int hf_ipsc_xnl_piece_id = -1;
+static int hf_ipsc_xnl_first_frame_id = -1;
+static int hf_ipsc_xnl_reassembled_in_id = -1;
+static int hf_ipsc_xcmp_opcode_id = -1;
+static int hf_ipsc_xcmp_type_id = -1;
+static int hf_ipsc_xcmp_message_id = -1;
+static int hf_ipsc_xcmp_data_id = -1;
+static int hf_ipsc_xcmp_response_in_id = -1;
+static int hf_ipsc_xcmp_response_to_id = -1;
+static int hf_ipsc_xcmp_time_id = -1;
+
 static int hf_ipsc_unk1_id = -1;
 
-static gint ett_ipsc = -1;
+/* Call tracking (generated) */
+static int hf_ipsc_call_id = -1;
+static int hf_ipsc_call_start_frame_id = -1;
+static int hf_ipsc_call_end_frame_id = -1;
+static int hf_ipsc_call_duration_id = -1;
+static int hf_ipsc_call_time_id = -1;
+static int hf_ipsc_call_packet_index_id = -1;
+static int hf_ipsc_call_late_entry_id = -1;
 
-void proto_register_ipsc(void);
-void proto_reg_handoff_ipsc(void);
+/* Multi-block data reassembly */
+static int hf_ipsc_data_block_id = -1;
+static int hf_ipsc_data_blocks_id = -1;
+static int hf_ipsc_data_header_frame_id = -1;
+static int hf_ipsc_data_reassembled_in_id = -1;
+static int hf_ipsc_data_reassembled_length_id = -1;
+static int hf_ipsc_data_hc_status_id = -1;
 
-void
-dissect_short_messages(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree)
-{
-    proto_item *ipsc_item = NULL;
-    proto_tree *ipsc_tree = NULL;
+/* Voice stream analysis (generated) */
+static int hf_ipsc_analysis_id = -1;
+static int hf_ipsc_analysis_delta_id = -1;
+static int hf_ipsc_analysis_jitter_id = -1;
+static int hf_ipsc_analysis_lost_id = -1;
+static int hf_ipsc_analysis_duplicate_id = -1;
+static int hf_ipsc_analysis_out_of_order_id = -1;
+static int hf_ipsc_analysis_stream_received_id = -1;
+static int hf_ipsc_analysis_stream_lost_id = -1;
+static int hf_ipsc_analysis_stream_duplicates_id = -1;
+static int hf_ipsc_analysis_stream_out_of_order_id = -1;
+static int hf_ipsc_analysis_stream_max_jitter_id = -1;
 
-    ipsc_item = proto_tree_add_item(tree, proto_ipsc, tvb, 0, -1, ENC_NA);
-    ipsc_tree = proto_item_add_subtree(ipsc_item, ett_ipsc);
+/* Airtime accounting (generated) */
+static int hf_ipsc_airtime_id = -1;
+static int hf_ipsc_airtime_slot_id = -1;
+static int hf_ipsc_airtime_added_id = -1;
+static int hf_ipsc_airtime_slot_busy_id = -1;
+static int hf_ipsc_airtime_slot_utilization_id = -1;
+static int hf_ipsc_airtime_slot_calls_id = -1;
 
-    /* Type */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_type, tvb, 0, 1, ENC_BIG_ENDIAN);
-    /* SRC_ID */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_rpt_id, tvb, 1, 4, ENC_BIG_ENDIAN);
-    /* Auth Digest */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_digest_id, tvb, 14, 10, ENC_BIG_ENDIAN);
-}
+/* RSSI (generated) */
+static int hf_ipsc_rssi_id = -1;
+static int hf_ipsc_rssi_dbm_id = -1;
+static int hf_ipsc_rssi_threshold_dbm_id = -1;
+static int hf_ipsc_rssi_interval_start_id = -1;
+static int hf_ipsc_rssi_interval_count_id = -1;
+static int hf_ipsc_rssi_interval_min_id = -1;
+static int hf_ipsc_rssi_interval_avg_id = -1;
+static int hf_ipsc_rssi_interval_max_id = -1;
 
-void
-dissect_CALL_CTL_1(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree)
-{
-    proto_item *ipsc_item = NULL;
-    proto_tree *ipsc_tree = NULL;
+/* Registration and keepalive tracking (generated) */
+static int hf_ipsc_rr_response_in_id = -1;
+static int hf_ipsc_rr_response_to_id = -1;
+static int hf_ipsc_rr_time_id = -1;
+static int hf_ipsc_rr_unanswered_id = -1;
+static int hf_ipsc_rr_missed_id = -1;
+static int hf_ipsc_rr_peer_event_id = -1;
 
-    ipsc_item = proto_tree_add_item(tree, proto_ipsc, tvb, 0, -1, ENC_NA);
-    ipsc_tree = proto_item_add_subtree(ipsc_item, ett_ipsc);
+/* PEER_LIST_REPLY */
+static int hf_ipsc_peer_list_length_id = -1;
+static int hf_ipsc_peer_list_same_as_id = -1;
+static int hf_ipsc_peer_id = -1;
+static int hf_ipsc_peer_rpt_id_id = -1;
+static int hf_ipsc_peer_ip_id = -1;
+static int hf_ipsc_peer_port_id = -1;
+static int hf_ipsc_peer_linking_id = -1;
 
-    /* Type */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_type, tvb, 0, 1, ENC_BIG_ENDIAN);
-    /* SRC_ID */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_rpt_id, tvb, 1, 4, ENC_BIG_ENDIAN);
-    /* SRC_ID */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_rpt_id, tvb, 5, 4, ENC_BIG_ENDIAN);
-    /* Unk_17_Byte */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_unk1_id, tvb, 9, 17, ENC_BIG_ENDIAN);
-    /* Auth Digest */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_digest_id, tvb, 26, 10, ENC_BIG_ENDIAN);
-}
+/* Peer table (generated) */
+static int hf_ipsc_peer_table_id = -1;
+static int hf_ipsc_peer_table_ip_id = -1;
+static int hf_ipsc_peer_table_port_id = -1;
+static int hf_ipsc_peer_table_linking_id = -1;
+static int hf_ipsc_peer_table_master_id = -1;
+static int hf_ipsc_peer_table_listed_in_id = -1;
 
-void
-dissect_CALL_CTL_2(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree)
-{
-    proto_item *ipsc_item = NULL;
-    proto_tree *ipsc_tree = NULL;
+static gint ett_ipsc = -1;
+static gint ett_ipsc_call = -1;
+static gint ett_ipsc_analysis = -1;
+static gint ett_ipsc_airtime = -1;
+static gint ett_ipsc_rssi = -1;
+static gint ett_ipsc_peer = -1;
+static gint ett_ipsc_digest = -1;
+static gint ett_ipsc_xnl = -1;
+static gint ett_ipsc_crc = -1;
+static gint ett_ipsc_voice = -1;
+static gint ett_ipsc_fec = -1;
 
-    ipsc_item = proto_tree_add_item(tree, proto_ipsc, tvb, 0, -1, ENC_NA);
-    ipsc_tree = proto_item_add_subtree(ipsc_item, ett_ipsc);
+static int ipsc_tap = -1;
 
-    /* Type */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_type, tvb, 0, 1, ENC_BIG_ENDIAN);
-    /* SRC_ID */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_rpt_id, tvb, 1, 4, ENC_BIG_ENDIAN);
-    /* Unk_2_Byte */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_unk1_id, tvb, 5, 2, ENC_BIG_ENDIAN);
-    /* Auth Digest */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_digest_id, tvb, 7, 10, ENC_BIG_ENDIAN);
-}
+static dissector_handle_t ip_handle;
+static dissector_handle_t data_handle;
 
-void
-dissect_CALL_CTL_3(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree)
-{
-    proto_item *ipsc_item = NULL;
-    proto_tree *ipsc_tree = NULL;
+/* Preferences */
+static guint ipsc_cai_network = 12;
+static guint ipsc_cai_group_network = 225;
+static const char *ipsc_auth_keys_pref = "";
+static range_t *global_ipsc_port_range;
+static gboolean ipsc_try_heuristic = TRUE;
+static guint ipsc_rssi_interval = 60;
 
-    ipsc_item = proto_tree_add_item(tree, proto_ipsc, tvb, 0, -1, ENC_NA);
-    ipsc_tree = proto_item_add_subtree(ipsc_item, ett_ipsc);
+#define IPSC_DEFAULT_PORT_RANGE "51001"
 
-    /* Type */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_type, tvb, 0, 1, ENC_BIG_ENDIAN);
-    /* SRC_ID */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_rpt_id, tvb, 1, 4, ENC_BIG_ENDIAN);
-    /* Unk 1 Byte */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_unk1_id, tvb, 5, 1, ENC_BIG_ENDIAN);
-    /* Auth Digest */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_digest_id, tvb, 6, 10, ENC_BIG_ENDIAN);
-}
+static const value_string valstring_type[] = {
+  { 0x61, "CALL_CTL_1" },
+  { 0x62, "CALL_CTL_2" },
+  { 0x63, "CALL_CTL_3" },
+  { 0x70, "XCMP_XNL" },
+  { 0x80, "GROUP_VOICE" },
+  { 0x83, "GROUP_DATA" },
+  { 0x84, "PVT_DATA" },
+  { 0x85, "RPT_WAKE_UP" },
+  { 0x90, "MASTER_REG_REQ" },
+  { 0x91, "MASTER_REG_REPLY"},
+  { 0x92, "PEER_LIST_REQ"},
+  { 0x93, "PEER_LIST_REPLY"},
+  { 0x94, "PEER_REG_REQ"},
+  { 0x95, "PEER_REG_REPLY"},
+  { 0x96, "MASTER_ALIVE_REQ"},
+  { 0x97, "MASTER_ALIVE_REPLY"},
+  { 0x98, "PEER_ALIVE_REQ"},
+  { 0x99, "PEER_ALIVE_REPLY"},
+  { 0x9a, "DE_REG_REQ"},
+  { 0x9b, "DE_REG_REPLY"},
+  { 0, NULL }
+};
 
-void
-dissect_PVT_DATA(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree)
-{
-    proto_item *ipsc_item = NULL;
-    proto_tree *ipsc_tree = NULL;
+static const value_string valstring_peer_event[] = {
+  { IPSC_PEER_EVENT_JOIN, "Join" },
+  { IPSC_PEER_EVENT_LEAVE, "Leave" },
+  { 0, NULL }
+};
 
-    guint16 length_to_follow = 0;
+static const value_string valstring_data_type[] = {
+  { 0x00, "PI header" },
+  { 0x01, "Voice LC Header" },
+  { 0x02, "Terminator with LC" },
+  { 0x03, "CSBK" },
+  { 0x04, "MBC Header" },
+  { 0x05, "MBC Continuation" },
+  { 0x06, "Data Header" },
+  { 0x07, "Rate 1/2 Data" },
+  { 0x08, "Rate 3/4 Data" },
+  { 0x09, "Idle" },
+  { 0x0a, "Rate 1 Data" },
+  { 0x0b, "Reserved" },
+  { 0x0c, "Reserved" },
+  { 0x0d, "Reserved" },
+  { 0x0e, "Reserved" },
+  { 0x0f, "Reserved" },
+  { 0, NULL },
+};
 
-    ipsc_item = proto_tree_add_item(tree, proto_ipsc, tvb, 0, -1, ENC_NA);
-    ipsc_tree = proto_item_add_subtree(ipsc_item, ett_ipsc);
+static const value_string valstring_xnl_opcode[] = {
+  { 0x0002, "MASTER_STATUS_BRDCST" },
+  { 0x0003, "DEV_MASTER_QUERY" },
+  { 0x0004, "DEV_AUTH_KEY_REQUEST" },
+  { 0x0005, "DEV_AUTH_KEY_REPLY" },
+  { 0x0006, "DEV_CONN_REQUEST" },
+  { 0x0007, "DEV_CONN_REPLY" },
+  { 0x0008, "DEV_SYSMAP_REQUEST" },
+  { 0x0009, "DEV_SYSMAP_BRDCST" },
+  { 0x000b, "DATA_MSG" },
+  { 0x000c, "DATA_MSG_ACK" },
+  { 0, NULL },
+};
 
-    /* Type */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_type, tvb, 0, 1, ENC_BIG_ENDIAN);
-    /* RPT_ID */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_rpt_id, tvb, 1, 4, ENC_BIG_ENDIAN);
-    /* SEQ NO */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_seq_no_id, tvb, 5, 1, ENC_BIG_ENDIAN);
-    /* Src Id */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_src_id, tvb, 6, 3, ENC_BIG_ENDIAN);
-    /* Dst Id */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_dst_id, tvb, 9, 3, ENC_BIG_ENDIAN);
-    /* Prio V/D */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_prio_v_d_id, tvb, 12, 1, ENC_BIG_ENDIAN);
-    /* Call Ctrl */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_call_ctrl_id, tvb, 13, 4, ENC_BIG_ENDIAN);
-    /* Call Ctrl Info */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_call_ctrl_info_id, tvb, 17, 1, ENC_BIG_ENDIAN);
-    /* Call Ctrl Src */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_call_ctrl_src_id, tvb, 18, 1, ENC_BIG_ENDIAN);
-    /* Payload Type */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_payload_type_id, tvb, 19, 1, ENC_BIG_ENDIAN);
-    /* Call Seq No */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_call_seq_no_id, tvb, 20, 2, ENC_BIG_ENDIAN);
-    /* Timestamp */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_timestamp_id, tvb, 22, 4, ENC_BIG_ENDIAN);
-    /* Sync Src Id */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_sync_src_id, tvb, 26, 4, ENC_BIG_ENDIAN);
-    /* Data Type Voice Hdr */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_data_type_voice_hdr_id, tvb, 30, 1, ENC_BIG_ENDIAN);
-    /* RSSI Threshold and Parity */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_rssi_threshold_and_parity_id, tvb, 31, 1, ENC_BIG_ENDIAN);
-    /* Length to Follow */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_length_to_follow_id, tvb, 32, 2, ENC_BIG_ENDIAN);
+static const value_string valstring_xnl_proto[] = {
+  { 0x00, "XNL Control" },
+  { 0x01, "XCMP" },
+  { 0, NULL },
+};
 
-    /* 
-     * Decide how the rest of data looks like
-     * based on length_to_follow
-     */
-    if ((length_to_follow = tvb_get_ntohs(tvb, 32)) != 0)
-    {
+static const value_string valstring_xcmp_type[] = {
+  { 0x0, "Request" },
+  { 0x8, "Reply" },
+  { 0xb, "Broadcast" },
+  { 0, NULL },
+};
 
-      proto_item *ipsc_data_item = NULL;
-      proto_tree *ipsc_data_tree = NULL;
+/* XCMP opcode without its type nibble */
+static const value_string valstring_xcmp_message[] = {
+  { 0x000e, "Radio Status" },
+  { 0x000f, "Version Information" },
+  { 0x0400, "Device Initialization Status" },
+  { 0x0401, "Display Text" },
+  { 0x0402, "Indicator Update" },
+  { 0x0405, "Physical User Input" },
+  { 0x0406, "Volume Control" },
+  { 0x0407, "Speaker Control" },
+  { 0x0408, "Transmit Power Level" },
+  { 0x040d, "Channel Selection" },
+  { 0, NULL },
+};
 
-      guint data_type = 0;
+static const value_string valstring_csbk_fid[] = {
+  { IPSC_CSBK_FID_STANDARD, "Standard" },
+  { IPSC_CSBK_FID_CONNECT_PLUS, "Connect Plus" },
+  { IPSC_CSBK_FID_MOTOROLA, "Motorola" },
+  { 0, NULL },
+};
 
-      /* RSSI Status */
-      proto_tree_add_item(ipsc_tree, hf_ipsc_rssi_status_id, tvb, 34, 1, ENC_BIG_ENDIAN);
-      /* Slot Type Sync */
-      proto_tree_add_item(ipsc_tree, hf_ipsc_slot_type_sync_id, tvb, 35, 1, ENC_BIG_ENDIAN);
-      /* Data Size - in words of 2bytes*/
-      proto_tree_add_item(ipsc_tree, hf_ipsc_data_size_id, tvb, 36, 2, ENC_BIG_ENDIAN);
-      /* Data */
-      ipsc_data_item = proto_tree_add_item(ipsc_tree, hf_ipsc_data_id, tvb, 38, 2 * length_to_follow - 4, ENC_BIG_ENDIAN);
-      /* Get Data Type */
-      data_type = tvb_get_guint8(tvb, 30) & 0x0f;
+static const value_string valstring_csbk_answer[] = {
+  { 0x20, "Proceed" },
+  { 0x21, "Deny" },
+  { 0, NULL },
+};
 
-      /* Header based on Data Type */
-      switch (data_type)
-      {
-        /* Data Type is CSBK header */
-        case 0x03:
-        {
-          ipsc_data_tree = proto_item_add_subtree(ipsc_data_item, ett_ipsc);
+static const value_string valstring_csbk_nack_source[] = {
+  { 0x00, "BS" },
+  { 0x01, "MS" },
+  { 0, NULL },
+};
 
-          /* CSBK Hdr Byte 1 */
-          proto_tree_add_item(ipsc_data_tree, hf_ipsc_csbk_hdr_byte1_id, tvb, 38, 1, ENC_BIG_ENDIAN);
-          /* CSBK Hdr FID */
-          proto_tree_add_item(ipsc_data_tree, hf_ipsc_csbk_hdr_fid_id, tvb, 39, 1, ENC_BIG_ENDIAN);
-          /* CSBK Byte 3 */
-          proto_tree_add_item(ipsc_data_tree, hf_ipsc_csbk_hdr_byte3_id, tvb, 40, 1, ENC_BIG_ENDIAN);
-          /* CSBK Byte 4 */
-          proto_tree_add_item(ipsc_data_tree, hf_ipsc_csbk_hdr_byte4_id, tvb, 41, 1, ENC_BIG_ENDIAN);
-          /* CSBK Dst */
-          proto_tree_add_item(ipsc_data_tree, hf_ipsc_csbk_hdr_dst_id, tvb, 42, 3, ENC_BIG_ENDIAN);
-          /* CSBK Src */
-          proto_tree_add_item(ipsc_data_tree, hf_ipsc_csbk_hdr_src_id, tvb, 45, 3, ENC_BIG_ENDIAN);
-          /* TODO - whatis the rest of the data to CRC? */
-          /* CSBK CRC */
-          proto_tree_add_item(ipsc_data_tree, hf_ipsc_csbk_hdr_crc_id, tvb, 48, 2, ENC_BIG_ENDIAN);
+static const value_string valstring_csbk_grant_slot[] = {
+  { 0x00, "1" },
+  { 0x01, "2" },
+  { 0, NULL },
+};
 
-        }; break;
+static const value_string valstring_voice_burst[] = {
+  { 0, "A" },
+  { 1, "B" },
+  { 2, "C" },
+  { 3, "D" },
+  { 4, "E" },
+  { 5, "F" },
+  { 0, NULL },
+};
 
-        /* If Data Type is Data Header */
-        case 0x06:
-        {
-          proto_item *byte1_item = NULL;
-          proto_tree *byte1_tree = NULL;
-          proto_item *byte2_item = NULL;
-          proto_tree *byte2_tree = NULL;
-          proto_item *byte8_item = NULL;
-          proto_tree *byte8_tree = NULL;
-          proto_item *byte9_item = NULL;
-          proto_tree *byte9_tree = NULL;
+static const value_string valstring_voice_lcss[] = {
+  { 0, "Single fragment" },
+  { 1, "First fragment" },
+  { 2, "Last fragment" },
+  { 3, "Continuation fragment" },
+  { 0, NULL },
+};
 
-          /* Add subtree for Data Header */
-          ipsc_data_tree = proto_item_add_subtree(ipsc_data_item, ett_ipsc);
+static const true_false_string tfs_csbk_preamble_content = { "Data", "CSBK" };
+static const true_false_string tfs_csbk_group = { "Group", "Individual" };
 
-          /* Data Hdr Byte 1 */
-          byte1_item = proto_tree_add_item(ipsc_data_tree, hf_ipsc_data_hdr_byte1_id, tvb, 38, 1, ENC_BIG_ENDIAN);
-          /* Add subtree for Byte 1 */
-          byte1_tree = proto_item_add_subtree(byte1_item, ett_ipsc);
-          /* Byte 1 G/I */
-          proto_tree_add_item(byte1_tree, hf_ipsc_data_hdr_byte1_gi_id, tvb, 38, 1, ENC_BIG_ENDIAN);
-          /* Byte 1 A */
-          proto_tree_add_item(byte1_tree, hf_ipsc_data_hdr_byte1_a_id, tvb, 38, 1, ENC_BIG_ENDIAN);
-          /* Byte 1 HC */
-          proto_tree_add_item(byte1_tree, hf_ipsc_data_hdr_byte1_hc_id, tvb, 38, 1, ENC_BIG_ENDIAN);
-          /* Byte 1 POCMSB */
-          proto_tree_add_item(byte1_tree, hf_ipsc_data_hdr_byte1_pocmsb_id, tvb, 38, 1, ENC_BIG_ENDIAN);
-          /* Byte 1 DPF */
-          proto_tree_add_item(byte1_tree, hf_ipsc_data_hdr_byte1_dpf_id, tvb, 38, 1, ENC_BIG_ENDIAN);
 
-          /* Data Hdr Byte 2 */
-          byte2_item = proto_tree_add_item(ipsc_data_tree, hf_ipsc_data_hdr_byte2_id, tvb, 39, 1, ENC_BIG_ENDIAN);
-          /* Add subtree for Byte 2 */
-          byte2_tree = proto_item_add_subtree(byte2_item, ett_ipsc);
-          /* Byte 2 SAP */
-          proto_tree_add_item(byte2_tree, hf_ipsc_data_hdr_byte2_sap_id, tvb, 39, 1, ENC_BIG_ENDIAN);
-          /* Byte 2 POC */
-          proto_tree_add_item(byte2_tree, hf_ipsc_data_hdr_byte2_poc_id, tvb, 39, 1, ENC_BIG_ENDIAN);
+void proto_register_ipsc(void);
+void proto_reg_handoff_ipsc(void);
 
-          /* Data Hdr Dst */
-          proto_tree_add_item(ipsc_data_tree, hf_ipsc_data_hdr_dst_id, tvb, 40, 3, ENC_BIG_ENDIAN);
-          /* Data Hdr Src */
-          proto_tree_add_item(ipsc_data_tree, hf_ipsc_data_hdr_src_id, tvb, 43, 3, ENC_BIG_ENDIAN);
+/*
+ * Call tracking
+ *
+ * A call is identified by repeater, source, destination and timeslot.
+ * It is opened by a Voice LC Header and closed by a Terminator with LC;
+ * the Voice LC Header is sent three times, and the repeats before the
+ * first burst belong to the call they opened. A call that goes quiet
+ * for IPSC_CALL_TIMEOUT ends at its last packet, so whatever comes
+ * after it starts a new one.
+ * The table below only holds calls that are still open; the call
+ * itself lives in seasonal memory and is reached from every frame
+ * through the per-packet data, so later passes never hash anything.
+ */
+#define IPSC_CALL_TIMEOUT       5       /* seconds without a packet */
 
-          /* Data Hdr Byte 8 */
-          byte8_item = proto_tree_add_item(ipsc_data_tree, hf_ipsc_data_hdr_byte8_id, tvb, 46, 1, ENC_BIG_ENDIAN);
-          /* Add tree for Byte 8 */
-          byte8_tree = proto_item_add_subtree(byte8_item, ett_ipsc);
-          /* Byte 8 F */
-          proto_tree_add_item(byte8_tree, hf_ipsc_data_hdr_byte8_f_id, tvb, 46, 1, ENC_BIG_ENDIAN);
-          /* Byte 8 BTF */
-          proto_tree_add_item(byte8_tree, hf_ipsc_data_hdr_byte8_btf_id, tvb, 46, 1, ENC_BIG_ENDIAN);
+typedef struct _ipsc_call_key_t {
+    guint32 rpt_id;
+    guint32 src_id;
+    guint32 dst_id;
+    guint8  slot;
+} ipsc_call_key_t;
 
-          /* Data Hdr Byte 9 */
-          byte9_item = proto_tree_add_item(ipsc_data_tree, hf_ipsc_data_hdr_byte9_id, tvb, 47, 1, ENC_BIG_ENDIAN);
-          /* Add tree for Byte 9 */
-          byte9_tree = proto_item_add_subtree(byte9_item, ett_ipsc);
+/*
+ * Voice stream analysis, in the spirit of the RTP analysis: Call Seq No
+ * is checked against a sliding window of the last 64 sequence numbers,
+ * so duplicates and late packets are told apart from loss; a packet
+ * further back than the window restarts the stream. The interarrival
+ * jitter is computed from Timestamp as in RFC 3550.
+ */
+#define IPSC_TIMESTAMP_RATE     8000    /* Timestamp ticks per second */
+#define IPSC_SEQ_WINDOW         64
 
-          /* If Confirmed header */
-          if (tvb_get_guint8(tvb, 38) & 0x40)
-          {
-            /* Byte 9 S */
-            proto_tree_add_item(byte9_tree, hf_ipsc_data_hdr_byte9_s_id, tvb, 47, 1, ENC_BIG_ENDIAN);
-            /* Byte 9 N(S) */
-            proto_tree_add_item(byte9_tree, hf_ipsc_data_hdr_byte9_ns_id, tvb, 47, 1, ENC_BIG_ENDIAN);
-          }
-          else
-          {
-            /* Add data in the first nibble */
-            proto_tree_add_item(byte9_tree, hf_ipsc_data_hdr_byte9_nibble1_id, tvb, 47, 1, ENC_BIG_ENDIAN);
-          }
+typedef struct _ipsc_stream_t {
+    gboolean seen;
+    guint16  max_seq;       /* highest Call Seq No so far */
+    guint64  window;        /* bit n set: max_seq - n was received */
+    guint32  last_timestamp;
+    nstime_t last_arrival;
+    guint32  received;
+    guint32  lost;
+    guint32  duplicates;
+    guint32  out_of_order;
+    gdouble  jitter;        /* ms */
+    gdouble  max_jitter;    /* ms */
+} ipsc_stream_t;
 
-          /* Byte 9 FSN */
-          proto_tree_add_item(byte9_tree, hf_ipsc_data_hdr_byte9_fsn_id, tvb, 47, 1, ENC_BIG_ENDIAN);
+typedef struct _ipsc_call_t {
+    ipsc_call_key_t key;
+    guint32  call_id;
+    guint32  start_frame;
+    guint32  end_frame;     /* 0 while the call is open */
+    nstime_t start_time;
+    nstime_t end_time;
+    guint32  packet_count;
+    guint32  last_frame;
+    nstime_t last_time;
+    guint8   last_data_type;
+    gboolean group;         /* FLCO of the LC that opened it */
+    gboolean late_entry;    /* opened by an embedded LC, the Voice LC Header was missed */
+    ipsc_stream_t stream;
+} ipsc_call_t;
 
-          /* Data Hdr CRC */
-          proto_tree_add_item(ipsc_data_tree, hf_ipsc_data_hdr_crc_id, tvb, 48, 2, ENC_BIG_ENDIAN);
+/*
+ * Embedded LC
+ *
+ * Bursts B to E of a voice superframe each carry a quarter of the
+ * embedded LC, LCSS telling the first, continuation and last fragment.
+ * The fragments are collected per stream on the first pass and the
+ * burst that brings the last one gets the LC and the outcome of its
+ * checksum. A voice stream with no open call, the capture having
+ * started after its Voice LC Header, gets its call from the first
+ * good embedded LC.
+ */
+typedef struct _ipsc_emb_lc_t {
+    ipsc_call_key_t key;
+    guint8  raw[IPSC_EMB_LC_RAW_LEN];
+    guint8  fragments;      /* collected so far, 0 while waiting for a first one */
+    guint32 first_frame;
+} ipsc_emb_lc_t;
 
-          /* TODO - what is the rest of the bytes (Data?) */
+/*
+ * Airtime accounting
+ *
+ * Every call packet (voice burst, Voice LC Header, Terminator, CSBK,
+ * Data Header or data block) stands for one 60 ms TDMA burst on its
+ * repeater and timeslot, and the packets lost right before it were on
+ * the air as well, as many as fit in the time since the previous
+ * packet of the call. Duplicates add nothing. The totals are kept per
+ * repeater and timeslot as the first pass goes, so each frame carries
+ * the busy time it added and the slot totals so far; summing the former
+ * in an I/O graph gives the busy time per interval. Utilization is the
+ * busy time over the time since the first IPSC frame of the capture.
+ */
+#define IPSC_BURST_TIME         0.060   /* seconds */
 
-        }; break;
+typedef struct _ipsc_slot_usage_t {
+    ipsc_call_key_t key;    /* src_id and dst_id are 0 */
+    guint64  bursts;
+    guint32  calls;         /* voice calls and data transfers started */
+} ipsc_slot_usage_t;
 
-        default:
-          break;
-      }
+/*
+ * RSSI time series
+ *
+ * The RSSI Status of call packets is summed per repeater, timeslot and
+ * radio (Src Id) into buckets of the "RSSI interval" preference as the
+ * first pass goes, so each frame carries its level and the min/avg/max
+ * of its bucket so far; the last frame of a bucket has the totals.
+ * Only the bucket being filled is kept for each radio.
+ */
+typedef struct _ipsc_rssi_series_t {
+    ipsc_call_key_t key;    /* dst_id is 0 */
+    ipsc_wire_rssi_stats_t stats;
+} ipsc_rssi_series_t;
 
-      /* Auth Digest */
-      proto_tree_add_item(ipsc_tree, hf_ipsc_digest_id, tvb, 38 + (2 * length_to_follow - 4), 10, ENC_BIG_ENDIAN);
-    }
-    else
-    {
-      /* Auth Digest */
-      proto_tree_add_item(ipsc_tree, hf_ipsc_digest_id, tvb, 34, 10, ENC_BIG_ENDIAN);
-    }
-}
+/*
+ * Multi-block data reassembly
+ *
+ * A Data Header announces how many Rate 1/2, 3/4 or 1 blocks follow on
+ * the same repeater, source, destination and timeslot. The blocks are
+ * collected in a fixed size buffer per pending transfer; the user data
+ * is copied once to seasonal memory when the last block arrives and
+ * the buffer is freed. Transfers that stall for longer than the timeout
+ * are dropped, and no more than IPSC_DATA_MAX_PENDING are kept at once.
+ */
+#define IPSC_DATA_MAX_BLOCKS        127     /* Blocks to Follow is 7 bits */
+#define IPSC_DATA_MAX_BLOCK_LEN     24      /* Rate 1 block */
+#define IPSC_DATA_MAX_PENDING       256
+#define IPSC_DATA_TIMEOUT           10      /* seconds between blocks */
 
-void
-dissect_GROUP_VOICE(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree)
-{
-    proto_item *ipsc_item = NULL;
-    proto_tree *ipsc_tree = NULL;
+/* ipsc_data_pdu_t hc_status */
+#define IPSC_HC_NONE                0       /* not a compressed SAP */
+#define IPSC_HC_OK                  1
+#define IPSC_HC_TRUNCATED           2
+#define IPSC_HC_NO_CONTEXT          3       /* compressed TCP before any uncompressed one */
+#define IPSC_HC_UNKNOWN_PORT_ID     4
 
-    guint16 length_to_follow = 0;
-    guint data_type = 0;
+typedef struct _ipsc_data_pdu_t {
+    guint32  header_frame;
+    guint32  reassembled_in;    /* 0 until the last block is seen */
+    guint8   blocks;            /* Blocks to Follow */
+    guint8   sap;               /* Service Access Point */
+    gboolean group;             /* Data Header G/I */
+    guint32  src_id;            /* Data Header Src */
+    guint32  dst_id;            /* Data Header Dst */
+    guint8  *data;              /* user data, without pad octets and CRC-32 */
+    guint    len;
+    /* SAP 2 and 3, the rebuilt IP packet */
+    guint8   hc_status;         /* IPSC_HC_xxx */
+    guint8  *ip_data;
+    guint    ip_len;
+} ipsc_data_pdu_t;
 
-    ipsc_item = proto_tree_add_item(tree, proto_ipsc, tvb, 0, -1, ENC_NA);
-    ipsc_tree = proto_item_add_subtree(ipsc_item, ett_ipsc);
+static const value_string valstring_hc_status[] = {
+  { IPSC_HC_OK, "OK" },
+  { IPSC_HC_TRUNCATED, "Truncated compressed header" },
+  { IPSC_HC_NO_CONTEXT, "No context for compressed TCP header" },
+  { IPSC_HC_UNKNOWN_PORT_ID, "Unknown UDP port identifier" },
+  { 0, NULL }
+};
 
-    /* Type */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_type, tvb, 0, 1, ENC_BIG_ENDIAN);
-    /* RPT_ID */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_rpt_id, tvb, 1, 4, ENC_BIG_ENDIAN);
-    /* SEQ NO */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_seq_no_id, tvb, 5, 1, ENC_BIG_ENDIAN);
-    /* Src Id */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_src_id, tvb, 6, 3, ENC_BIG_ENDIAN);
-    /* Dst Id */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_dst_id, tvb, 9, 3, ENC_BIG_ENDIAN);
-    /* Prio Video/Data */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_prio_v_d_id, tvb, 12, 1, ENC_BIG_ENDIAN);
-    /* Call Ctrl */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_call_ctrl_id, tvb, 13, 4, ENC_BIG_ENDIAN);
-    /* Call Ctrl Info */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_call_ctrl_info_id, tvb, 17, 1, ENC_BIG_ENDIAN);
-    /* Call Ctrl Src */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_call_ctrl_src_id, tvb, 18, 1, ENC_BIG_ENDIAN);
-    /* Payload Type */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_payload_type_id, tvb, 19, 1, ENC_BIG_ENDIAN);
-    /* Call Seq No */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_call_seq_no_id, tvb, 20, 2, ENC_BIG_ENDIAN);
-    /* Timestamp */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_timestamp_id, tvb, 22, 4, ENC_BIG_ENDIAN);
-    /* Sync Src Id */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_sync_src_id, tvb, 26, 4, ENC_BIG_ENDIAN);
-    /* Data Type Voice Hdr */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_data_type_voice_hdr_id, tvb, 30, 1, ENC_BIG_ENDIAN);
-    /* Get Data Type */
-    data_type = tvb_get_guint8(tvb, 30) & 0xf;
+typedef struct _ipsc_data_transfer_t {
+    ipsc_call_key_t  key;
+    ipsc_data_pdu_t *pdu;
+    gboolean confirmed;         /* blocks start with serial number and CRC-9 */
+    guint8   pad_octets;
+    guint8   next_block;
+    nstime_t last_time;
+    guint    len;
+    guint8   buf[IPSC_DATA_MAX_BLOCKS * IPSC_DATA_MAX_BLOCK_LEN];
+} ipsc_data_transfer_t;
 
-    switch (data_type)
-    {
-      case 0x01:
-        /* Voice LC Header */
-      case 0x02:
-      {
-        /* Voice LC Termination Header */
+/* ipsc_packet_data_t data_flags */
+#define IPSC_DATA_ABANDONED         0x01    /* an incomplete transfer was dropped here */
+#define IPSC_DATA_TABLE_FULL        0x02    /* too many pending transfers, header ignored */
+#define IPSC_DATA_RAW_BLOCK         0x04    /* a raw block that does not decode, transfer dropped */
 
-        /* RSSI Threshold and Parity */
-        proto_tree_add_item(ipsc_tree, hf_ipsc_rssi_threshold_and_parity_id, tvb, 31, 1, ENC_BIG_ENDIAN);
-        /* Length to Follow */
-        proto_tree_add_item(ipsc_tree, hf_ipsc_length_to_follow_id, tvb, 32, 2, ENC_BIG_ENDIAN);
+/* ipsc_packet_data_t peer_auth */
+#define IPSC_PEER_AUTH_UNKNOWN      0       /* no registration or keepalive seen yet */
+#define IPSC_PEER_AUTH_YES          1
+#define IPSC_PEER_AUTH_NO           2
 
-        /* 
-        * Decide how the rest of data looks like
-        * based on length_to_follow (words of 2 bytes each)
-        */
-        if ((length_to_follow = tvb_get_ntohs(tvb, 32)) != 0)
-        {
-          proto_item *ipsc_voice_item = NULL;
-          proto_tree *ipsc_voice_tree = NULL;
+/* ipsc_packet_data_t digest */
+#define IPSC_DIGEST_UNCHECKED       0       /* no keys, no digest, or not where the first pass looked */
+#define IPSC_DIGEST_GOOD            1
+#define IPSC_DIGEST_BAD             2
 
-          /* RSSI Status */
-          proto_tree_add_item(ipsc_tree, hf_ipsc_rssi_status_id, tvb, 34, 1, ENC_BIG_ENDIAN);
-          /* Slot Type Sync */
-          proto_tree_add_item(ipsc_tree, hf_ipsc_slot_type_sync_id, tvb, 35, 1, ENC_BIG_ENDIAN);
-          /* Data Size - in words of 2bytes */
-          proto_tree_add_item(ipsc_tree, hf_ipsc_data_size_id, tvb, 36, 2, ENC_BIG_ENDIAN);
-          /* Full LC / Voice PDU */
-          ipsc_voice_item = proto_tree_add_item(ipsc_tree, hf_ipsc_data_id, tvb, 38, 2 * length_to_follow - 4, ENC_BIG_ENDIAN);
-          ipsc_voice_tree = proto_item_add_subtree(ipsc_voice_item, ett_ipsc);
-          /* Voice PDU Byte 1 */ 
-          proto_tree_add_item(ipsc_voice_tree, hf_ipsc_full_lc_byte1_id, tvb, 38, 1, ENC_BIG_ENDIAN);
-          /* Voice PDU FID */
-          proto_tree_add_item(ipsc_voice_tree, hf_ipsc_full_lc_fid_id, tvb, 39, 1, ENC_BIG_ENDIAN);
-          /* Voice PDU Service Options */
-          proto_tree_add_item(ipsc_voice_tree, hf_ipsc_voice_pdu_service_options_id, tvb, 40, 1, ENC_BIG_ENDIAN);
-          /* Voice PDU Dst */
-          proto_tree_add_item(ipsc_voice_tree, hf_ipsc_voice_pdu_dst_id, tvb, 41, 3, ENC_BIG_ENDIAN);
-          /* Voice PDU Rst */
-          proto_tree_add_item(ipsc_voice_tree, hf_ipsc_voice_pdu_src_id, tvb, 44, 3, ENC_BIG_ENDIAN);
+#define IPSC_PEER_CAPS_KNOWN        0x100
 
-          /* TODO - Add rest of bytes - Data? */
+/*
+ * Peer table
+ *
+ * Filled from PEER_LIST_REPLY. Masters send the same list over and over,
+ * so the last list of each master is kept and a new one is compared to
+ * it first; only a list that differs touches the table, and then only
+ * the peers that were added, changed or dropped. A peer that shows up
+ * with another address or mode gets a new entry rather than an update,
+ * so the frames that point at the old one keep what was true for them.
+ * Every frame finds its repeater with one lookup on the first pass.
+ */
+typedef struct _ipsc_peer_t {
+    guint32 rpt_id;
+    guint32 master_id;      /* Rpt Id of the PEER_LIST_REPLY */
+    guint32 ip;             /* network order */
+    guint16 port;
+    guint8  linking;
+    guint32 listed_in;      /* PEER_LIST_REPLY that added it */
+    guint32 last_list;      /* last changed list of master_id that had it, internal */
+} ipsc_peer_t;
 
-          /* Auth Digest */
-          proto_tree_add_item(ipsc_tree, hf_ipsc_digest_id, tvb, 38 + (2 * length_to_follow - 4), 10, ENC_BIG_ENDIAN);
-        }
+/* Last list of a master */
+typedef struct _ipsc_peer_list_t {
+    guint32  frame;
+    guint    len;
+    guint8  *entries;
+} ipsc_peer_list_t;
 
-      }; break;
+/*
+ * XNL and XCMP
+ *
+ * XCMP_XNL carries an XNL packet, or the start of one when the XNL
+ * Payload Length runs past the XNL data of the message; the rest then
+ * comes in the next XCMP_XNL messages of the same repeater. Only the
+ * first piece has an XNL header, so the pieces are collected per UDP
+ * conversation and sending repeater, as the data blocks are, and the
+ * whole XNL packet is copied once to seasonal memory. An XCMP request is kept
+ * under its XNL source, destination and Transaction Id, which the reply
+ * comes back with, so the reply finds it with one lookup.
+ */
+#define IPSC_XNL_TIMEOUT            10      /* seconds between pieces */
 
-      case 0x0a:
-      {
-        /* Rate 1 data */
+typedef struct _ipsc_xnl_pdu_t {
+    guint32  first_frame;
+    guint32  reassembled_in;    /* 0 until the last piece is seen */
+    guint8  *data;              /* the whole XNL packet, once complete */
+    guint    len;
+    guint    pieces;            /* so far */
+} ipsc_xnl_pdu_t;
 
-        /* length to folow is in bytes */
-        length_to_follow = tvb_get_guint8(tvb, 31);
-        /* Length to Follow */
-        proto_tree_add_item(ipsc_tree, hf_ipsc_length_to_follow2_id, tvb, 31, 1, ENC_BIG_ENDIAN);
-        /* Data */
-        proto_tree_add_item(ipsc_tree, hf_ipsc_data_id, tvb, 32, length_to_follow, ENC_BIG_ENDIAN);
-        /* Auth Digest */
-        proto_tree_add_item(ipsc_tree, hf_ipsc_digest_id, tvb, 32 + length_to_follow, 10, ENC_BIG_ENDIAN);
+typedef struct _ipsc_xnl_pending_t {
+    guint64  key;               /* conversation index << 32 | rpt_id */
+    ipsc_xnl_pdu_t *pdu;
+    nstime_t last_time;
+    guint    len;
+    guint    total;
+    guint8  *buf;
+} ipsc_xnl_pending_t;
 
-      }; break;
+typedef struct _ipsc_xcmp_transaction_t {
+    guint64  key;               /* requester << 32 | responder << 16 | Transaction Id */
+    guint16  opcode;            /* of the request */
+    guint32  request_frame;
+    guint32  reply_frame;       /* 0 until the reply is seen */
+    nstime_t request_time;
+} ipsc_xcmp_transaction_t;
 
-      default:
-      {
-        /* Auth Digest */
-        proto_tree_add_item(ipsc_tree, hf_ipsc_digest_id, tvb, 30, 10, ENC_BIG_ENDIAN);
-      }
-    }
-}
+/* Attached to every IPSC frame on the first pass */
+typedef struct _ipsc_packet_data_t {
+    guint8       peer_auth;     /* IPSC_PEER_AUTH_xxx, as known at this frame */
+    /* Auth Digest, checked once on the first pass */
+    guint8       digest;        /* IPSC_DIGEST_xxx */
+    gint8        digest_key;    /* index of the key that matched */
+    guint32      digest_offset;
+    ipsc_call_t *call;      /* NULL if the frame is not part of a call */
+    guint32      packet_index;
+    /* Multi-block data */
+    ipsc_data_pdu_t *data_pdu;  /* NULL if the frame is not part of a data transfer */
+    guint8       data_block;    /* 1 based, 0 for the Data Header */
+    guint8       data_flags;    /* IPSC_DATA_xxx */
+    gboolean     call_start;    /* opens a voice call or a data transfer */
+    /* Stream analysis at this frame */
+    guint8       stream_flags;  /* IPSC_STREAM_xxx */
+    guint16      lost;          /* packets missing right before this one */
+    gdouble      delta;         /* ms since the previous in order packet */
+    gdouble      jitter;        /* ms */
+    /* Airtime accounting at this frame */
+    gdouble      airtime;       /* s added to the slot busy time */
+    gdouble      slot_busy;     /* s, slot total so far */
+    gdouble      slot_utilization;  /* % */
+    guint32      slot_calls;
+    /* RSSI bucket of the repeater, timeslot and radio, up to this frame; count 0 without RSSI */
+    ipsc_wire_rssi_stats_t rssi;
+    /* Registration and keepalive tracking */
+    guint32      rr_frame;      /* the reply of a request, the request of a reply */
+    nstime_t     rr_time;       /* round trip time, on a reply */
+    guint32      rr_rpt_id;     /* requester, on a reply */
+    guint32      rr_unanswered; /* previous keepalive left without reply, on a request */
+    guint8       rr_missed;     /* keepalives in a row left unanswered, on a request */
+    guint8       peer_event;    /* IPSC_PEER_EVENT_xxx */
+    /* Peer table */
+    const ipsc_peer_t *peer;    /* entry of the Rpt Id at this frame, NULL if not listed */
+    guint32      peer_list_same_as; /* PEER_LIST_REPLY that had the very same list */
+    /* XNL and XCMP */
+    ipsc_xnl_pdu_t *xnl_pdu;    /* NULL if the XNL packet fits the frame */
+    guint8       xnl_piece;     /* 1 based */
+    ipsc_xcmp_transaction_t *xcmp;  /* on an XCMP request or reply */
+    /* Raw burst, Golay(20,8) and BPTC(196,96) decoded once on the first pass */
+    guint8      *burst;         /* the corrected 96 bits, NULL if the payload is not a raw burst */
+    guint8       slot_type;
+    gint16       slot_type_errors;  /* bits corrected, -1 if uncorrectable */
+    gint16       burst_errors;
+    /* Embedded LC, on the burst that completes it */
+    guint8      *emb_lc;        /* IPSC_EMB_LC_LEN octets, NULL on other frames */
+    gboolean     emb_lc_ok;     /* checksum */
+    gint8        emb_lc_errors; /* bits the Hamming rows corrected, -1 if they could not */
+    guint32      emb_lc_first_frame;
+} ipsc_packet_data_t;
 
-void
-dissect_XCMP_XNL(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree)
-{
-    proto_item *ipsc_item = NULL;
-    proto_tree *ipsc_tree = NULL;
+/*
+ * Registration and keepalive tracking
+ *
+ * MASTER_REG, PEER_LIST, PEER_REG, MASTER_ALIVE, PEER_ALIVE and DE_REG
+ * are request/reply pairs between two repeaters, the request opcode
+ * being even and the reply the next one. The requests waiting for their
+ * reply are kept in the UDP conversation, one per kind and direction, so
+ * a reply finds its request with the conversation lookup and an index.
+ * A keepalive sent while the previous one is still unanswered counts
+ * that one as missed; IPSC_PEER_MAX_MISSED in a row, or a DE_REG_REQ,
+ * take the link down. A registration or keepalive answered on a link
+ * that is down brings it up.
+ */
+#define IPSC_RR_KINDS               6       /* (opcode - 0x90) / 2, 0x90 to 0x9b */
+#define IPSC_RR_PEER_LIST           1
+#define IPSC_RR_MASTER_ALIVE        3
+#define IPSC_RR_PEER_ALIVE          4
+#define IPSC_RR_DE_REG              5
+#define IPSC_PEER_MAX_MISSED        3
 
-    guint16 data_len = NULL;
+typedef struct _ipsc_rr_t {
+    guint32  frame;         /* 0 when nothing is pending */
+    nstime_t time;
+    guint32  rpt_id;        /* requester */
+    ipsc_packet_data_t *packet_data;
+} ipsc_rr_t;
 
-    ipsc_item = proto_tree_add_item(tree, proto_ipsc, tvb, 0, -1, ENC_NA);
-    ipsc_tree = proto_item_add_subtree(ipsc_item, ett_ipsc);
+typedef struct _ipsc_link_t {
+    gboolean  up;
+    ipsc_rr_t pending[2][IPSC_RR_KINDS];    /* by direction of the request */
+    guint8    missed[2];    /* keepalives in a row left unanswered */
+} ipsc_link_t;
 
+static GHashTable *ipsc_active_calls = NULL;
+static guint32 ipsc_call_count = 0;
 
-    /* Type */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_type, tvb, 0, 1, ENC_BIG_ENDIAN);
-    /* SRC_ID */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_rpt_id, tvb, 1, 4, ENC_BIG_ENDIAN);
-    /* XCMP/XNL Length */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_xcmp_xnl_length_id, tvb, 5, 2, ENC_BIG_ENDIAN);
-    /* Keep Data Len */
-    data_len = tvb_get_ntohs(tvb, 5);
-    /* XCMP/XNL Data */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_xcmp_xnl_data_id, tvb, 7, data_len, ENC_BIG_ENDIAN);
-    /* Auth Digest */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_digest_id, tvb, 7 + data_len, 10, ENC_BIG_ENDIAN);
-}
+static GHashTable *ipsc_slot_usage = NULL;
+static nstime_t ipsc_first_time;
 
+static GHashTable *ipsc_rssi_series = NULL;
 
-void
-dissect_RPT_WAKE_UP(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree)
-{
-    proto_item *ipsc_item = NULL;
-    proto_tree *ipsc_tree = NULL;
+static GHashTable *ipsc_data_transfers = NULL;
+static GHashTable *ipsc_hc_contexts = NULL;
+static GHashTable *ipsc_auth_peers = NULL;      /* rpt_id -> key index + 1 */
+static GHashTable *ipsc_peer_caps = NULL;       /* rpt_id -> IPSC_PEER_CAPS_KNOWN | Service FLAGS byte 4 */
+static GHashTable *ipsc_peer_table = NULL;      /* rpt_id -> ipsc_peer_t */
+static GHashTable *ipsc_peer_lists = NULL;      /* master rpt_id -> ipsc_peer_list_t */
+static GHashTable *ipsc_xnl_pending = NULL;     /* conversation and rpt_id -> ipsc_xnl_pending_t */
+static GHashTable *ipsc_xcmp_transactions = NULL;
+static GHashTable *ipsc_emb_lcs = NULL;
 
-    ipsc_item = proto_tree_add_item(tree, proto_ipsc, tvb, 0, -1, ENC_NA);
-    ipsc_tree = proto_item_add_subtree(ipsc_item, ett_ipsc);
+static guint
+ipsc_call_hash(gconstpointer k)
+{
+    const ipsc_call_key_t *key = (const ipsc_call_key_t *)k;
 
-    /* Type */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_type, tvb, 0, 1, ENC_BIG_ENDIAN);
+    return key->rpt_id ^ (key->src_id << 7) ^ (key->dst_id << 1) ^ key->slot;
+}
 
-    /* SRC_ID */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_rpt_id, tvb, 1, 4, ENC_BIG_ENDIAN);
+static gboolean
+ipsc_call_equal(gconstpointer k1, gconstpointer k2)
+{
+    const ipsc_call_key_t *key1 = (const ipsc_call_key_t *)k1;
+    const ipsc_call_key_t *key2 = (const ipsc_call_key_t *)k2;
 
-    /* Auth Digest */
-    //proto_tree_add_item(ipsc_tree, hf_ipsc_digest_id, tvb, 14, 10, ENC_BIG_ENDIAN);
+    return (key1->rpt_id == key2->rpt_id &&
+            key1->src_id == key2->src_id &&
+            key1->dst_id == key2->dst_id &&
+            key1->slot == key2->slot);
 }
 
+static void
+ipsc_xnl_pending_free(gpointer data)
+{
+    ipsc_xnl_pending_t *pending = (ipsc_xnl_pending_t *)data;
 
+    g_free(pending->buf);
+    g_free(pending);
+}
 
-void
-dissect_long_messages(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree)
+static void
+ipsc_init_protocol(void)
 {
-    proto_item *ipsc_item = NULL;
-    proto_tree *ipsc_tree = NULL;
-    proto_item *ipsc_linking_item = NULL;
-    proto_tree *ipsc_linking_tree = NULL;
-    proto_item *ipsc_service_flags_item = NULL;
-    proto_tree *ipsc_service_flags_tree = NULL;
-    proto_item *ipsc_service_flags_byte3_item = NULL;
-    proto_tree *ipsc_service_flags_byte3_tree = NULL;
-    proto_item *ipsc_service_flags_byte4_item = NULL;
-    proto_tree *ipsc_service_flags_byte4_tree = NULL;
+    if (ipsc_active_calls)
+      g_hash_table_destroy(ipsc_active_calls);
 
-    ipsc_item = proto_tree_add_item(tree, proto_ipsc, tvb, 0, -1, ENC_NA);
-    ipsc_tree = proto_item_add_subtree(ipsc_item, ett_ipsc);
+    /* Keys and values are seasonal, nothing to free here */
+    ipsc_active_calls = g_hash_table_new(ipsc_call_hash, ipsc_call_equal);
+    ipsc_call_count = 0;
 
-    /* Type */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_type, tvb, 0, 1, ENC_BIG_ENDIAN);
+    if (ipsc_slot_usage)
+      g_hash_table_destroy(ipsc_slot_usage);
 
-    /* SRC_ID */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_rpt_id, tvb, 1, 4, ENC_BIG_ENDIAN);
+    /* The key lives in the usage */
+    ipsc_slot_usage = g_hash_table_new_full(ipsc_call_hash, ipsc_call_equal, NULL, g_free);
+    nstime_set_unset(&ipsc_first_time);
 
-    /* Linking */
-    ipsc_linking_item = proto_tree_add_item(ipsc_tree, hf_ipsc_linking_id, tvb, 5, 1, ENC_BIG_ENDIAN);
-    ipsc_linking_tree = proto_item_add_subtree(ipsc_linking_item, ett_ipsc);
-    /* Peer Opperation */
-    proto_tree_add_item(ipsc_linking_tree, hf_ipsc_linking_peer_op_id, tvb, 5, 1, ENC_BIG_ENDIAN);
-    /* Peer Mode */
-    proto_tree_add_item(ipsc_linking_tree, hf_ipsc_linking_peer_mode_id, tvb, 5, 1, ENC_BIG_ENDIAN);
-    /* IPSC Slot 1 */
-    proto_tree_add_item(ipsc_linking_tree, hf_ipsc_linking_ipsc_slot1_id, tvb, 5, 1, ENC_BIG_ENDIAN);
-    /* IPSC Slot 2 */
-    proto_tree_add_item(ipsc_linking_tree, hf_ipsc_linking_ipsc_slot2_id, tvb, 5, 1, ENC_BIG_ENDIAN);
+    if (ipsc_rssi_series)
+      g_hash_table_destroy(ipsc_rssi_series);
 
-    /* Service FLAGS */
-    ipsc_service_flags_item = proto_tree_add_item(ipsc_tree, hf_ipsc_service_flags_id, tvb, 6, 4, ENC_BIG_ENDIAN);
-    ipsc_service_flags_tree = proto_item_add_subtree(ipsc_service_flags_item, ett_ipsc);
-    /* Service FLAGS Byte 1 */
-    proto_tree_add_item(ipsc_service_flags_tree, hf_ipsc_service_flags_byte1_id, tvb, 6, 1, ENC_BIG_ENDIAN);
-    /* Service FLAGS Byte 2 */
-    proto_tree_add_item(ipsc_service_flags_tree, hf_ipsc_service_flags_byte2_id, tvb, 7, 1, ENC_BIG_ENDIAN);
-    /* Service FLAGS Byte 3 */
-    ipsc_service_flags_byte3_item = proto_tree_add_item(ipsc_service_flags_tree, hf_ipsc_service_flags_byte3_id, tvb, 8, 1, ENC_BIG_ENDIAN);
-    ipsc_service_flags_byte3_tree = proto_item_add_subtree(ipsc_service_flags_byte3_item, ett_ipsc);
-    /* Service FLAGS Byte 3 - RDAC bit */
-    proto_tree_add_item(ipsc_service_flags_byte3_tree, hf_ipsc_service_flags_byte3_rdac_id, tvb, 8, 1, ENC_BIG_ENDIAN);
-    /* Service FLAGS Byte 3 - Unknown bit */
-    proto_tree_add_item(ipsc_service_flags_byte3_tree, hf_ipsc_service_flags_byte3_unk1_id, tvb, 8, 1, ENC_BIG_ENDIAN);
-    /* Service FLAGS Byte 3 - 3rd Party App */
-    proto_tree_add_item(ipsc_service_flags_byte3_tree, hf_ipsc_service_flags_byte3_3rdpy_id, tvb, 8, 1, ENC_BIG_ENDIAN);
-    /* Service FLAGS Byte 3 - Unk2 */
-    proto_tree_add_item(ipsc_service_flags_byte3_tree, hf_ipsc_service_flags_byte3_unk2_id, tvb, 8, 1, ENC_BIG_ENDIAN);
-    /* Service FLAGS Byte 4 */
-    ipsc_service_flags_byte4_item = proto_tree_add_item(ipsc_service_flags_tree, hf_ipsc_service_flags_byte4_id, tvb, 9, 1, ENC_BIG_ENDIAN);
-    ipsc_service_flags_byte4_tree = proto_item_add_subtree(ipsc_service_flags_byte4_item, ett_ipsc);
-    /* Service FLAGS Byte 4 - XNL Connected */
-    proto_tree_add_item(ipsc_service_flags_byte4_tree, hf_ipsc_service_flags_byte4_xnl_conn_id, tvb, 9, 1, ENC_BIG_ENDIAN);
-    /* Service FLAGS Byte 4 - XNL Master Device */
-    proto_tree_add_item(ipsc_service_flags_byte4_tree, hf_ipsc_service_flags_byte4_xnl_master_id, tvb, 9, 1, ENC_BIG_ENDIAN);
-    /* Service FLAGS Byte 4 - XNL Slave Device */
-    proto_tree_add_item(ipsc_service_flags_byte4_tree, hf_ipsc_service_flags_byte4_xnl_slave_id, tvb, 9, 1, ENC_BIG_ENDIAN);
-    /* Service FLAGS Byte 4 - Authenticated packets */
-    proto_tree_add_item(ipsc_service_flags_byte4_tree, hf_ipsc_service_flags_byte4_auth_id, tvb, 9, 1, ENC_BIG_ENDIAN);
-    /* Service FLAGS Byte 4 - Voice calls supported */
-    proto_tree_add_item(ipsc_service_flags_byte4_tree, hf_ipsc_service_flags_byte4_voice_id, tvb, 9, 1, ENC_BIG_ENDIAN);
-    /* Service FLAGS Byte 4 - Data calls supported */
-    proto_tree_add_item(ipsc_service_flags_byte4_tree, hf_ipsc_service_flags_byte4_data_id, tvb, 9, 1, ENC_BIG_ENDIAN);
-    /* Service FLAGS Byte 4 - Unk2 */
-    proto_tree_add_item(ipsc_service_flags_byte4_tree, hf_ipsc_service_flags_byte4_unk2_id, tvb, 9, 1, ENC_BIG_ENDIAN);
-    /* Service FLAGS Byte 4 - Master */
-    proto_tree_add_item(ipsc_service_flags_byte4_tree, hf_ipsc_service_flags_byte4_master_id, tvb, 9, 1, ENC_BIG_ENDIAN);
+    /* The key lives in the series */
+    ipsc_rssi_series = g_hash_table_new_full(ipsc_call_hash, ipsc_call_equal, NULL, g_free);
 
-    /* Version */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_version_id, tvb, 10, 4, ENC_BIG_ENDIAN);
+    if (ipsc_data_transfers)
+      g_hash_table_destroy(ipsc_data_transfers);
 
-    /* Auth Digest */
-    proto_tree_add_item(ipsc_tree, hf_ipsc_digest_id, tvb, 14, 10, ENC_BIG_ENDIAN);
+    /* The key lives in the transfer */
+    ipsc_data_transfers = g_hash_table_new_full(ipsc_call_hash, ipsc_call_equal, NULL, g_free);
+
+    if (ipsc_hc_contexts)
+      g_hash_table_destroy(ipsc_hc_contexts);
+
+    /* Keys and values are seasonal */
+    ipsc_hc_contexts = g_hash_table_new(ipsc_call_hash, ipsc_call_equal);
+
+    if (ipsc_auth_peers)
+      g_hash_table_destroy(ipsc_auth_peers);
+
+    ipsc_auth_peers = g_hash_table_new(g_direct_hash, g_direct_equal);
+
+    if (ipsc_peer_caps)
+      g_hash_table_destroy(ipsc_peer_caps);
+
+    ipsc_peer_caps = g_hash_table_new(g_direct_hash, g_direct_equal);
+
+    if (ipsc_peer_table)
+      g_hash_table_destroy(ipsc_peer_table);
+
+    /* Entries are seasonal, frames point at them */
+    ipsc_peer_table = g_hash_table_new(g_direct_hash, g_direct_equal);
+
+    if (ipsc_peer_lists)
+      g_hash_table_destroy(ipsc_peer_lists);
+
+    ipsc_peer_lists = g_hash_table_new(g_direct_hash, g_direct_equal);
+
+    if (ipsc_xnl_pending)
+      g_hash_table_destroy(ipsc_xnl_pending);
+
+    /* The key lives in the pending packet */
+    ipsc_xnl_pending = g_hash_table_new_full(g_int64_hash, g_int64_equal, NULL, ipsc_xnl_pending_free);
+
+    if (ipsc_xcmp_transactions)
+      g_hash_table_destroy(ipsc_xcmp_transactions);
+
+    /* The key lives in the transaction, both are seasonal */
+    ipsc_xcmp_transactions = g_hash_table_new(g_int64_hash, g_int64_equal);
+
+    if (ipsc_emb_lcs)
+      g_hash_table_destroy(ipsc_emb_lcs);
+
+    /* The key lives in the embedded LC */
+    ipsc_emb_lcs = g_hash_table_new_full(ipsc_call_hash, ipsc_call_equal, NULL, g_free);
 }
 
+/*
+ * View of the whole packet for the wire decoder in ipsc-wire.h. The
+ * UDP payload is contiguous, so this does not copy.
+ */
 static void
-dissect_ipsc(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree)
+ipsc_wire_msg_tvb(tvbuff_t *tvb, ipsc_wire_msg_t *msg)
 {
-  /*
-     Clear the Info column so that, if we throw an exception, it
-     shows up as a short or malformed ARP frame. */
-  col_set_str(pinfo->cinfo, COL_PROTOCOL, "IPSC");
-  col_clear(pinfo->cinfo, COL_INFO);
+    guint len = tvb_length(tvb);
 
-  if (tree) {
-    int val;
+    ipsc_wire_msg(msg, len ? tvb_get_ptr(tvb, 0, len) : NULL, len);
+}
 
-    switch (val = tvb_get_guint8(tvb, 0))
-    {
-      case 0x61:
-        dissect_CALL_CTL_1(tvb, pinfo, tree);
-        break;
-      case 0x62:
-        dissect_CALL_CTL_2(tvb, pinfo, tree);
-        break;
-      case 0x63:
-        dissect_CALL_CTL_3(tvb, pinfo, tree);
-        break;
-      case 0x70:
-        dissect_XCMP_XNL(tvb, pinfo, tree);
-        break;
-      case 0x80:
-        dissect_GROUP_VOICE(tvb, pinfo, tree);
-        break;
-      case 0x84:
-        dissect_PVT_DATA(tvb, pinfo, tree);
-        break;
-      case 0x85:
-        dissect_RPT_WAKE_UP(tvb, pinfo, tree);
-        break;
+/*
+ * Peer capabilities
+ *
+ * Whether a peer appends an Auth Digest is announced in Service FLAGS
+ * byte 4 of its registration and keepalive messages. It is learned
+ * here on the first pass and recorded per frame, so the dissectors know
+ * whether a trailer exists instead of reading past the end of packets
+ * from networks that do not authenticate.
+ */
+static void
+ipsc_track_peer(tvbuff_t *tvb, const ipsc_info_t *ipsc_info, ipsc_packet_data_t *packet_data)
+{
+    ipsc_wire_msg_t msg;
+    ipsc_wire_reg_t reg;
+    guint caps;
 
+    ipsc_wire_msg_tvb(tvb, &msg);
+
+    switch (ipsc_info->opcode)
+    {
+      /* MASTER_REG_REQ, PEER_REG_REQ, MASTER/PEER_ALIVE_REQ/REPLY */
       case 0x90:
-      case 0x91:
       case 0x94:
-      case 0x95:
       case 0x96:
       case 0x97:
       case 0x98:
       case 0x99:
-        dissect_long_messages(tvb, pinfo, tree);
-        break;
-
-      case 0x92:
-        dissect_short_messages(tvb, pinfo, tree);
+        if (ipsc_wire_reg(&msg, &reg))
+        {
+          caps = IPSC_PEER_CAPS_KNOWN | ipsc_wire_reg_flags4(&reg);
+          g_hash_table_insert(ipsc_peer_caps, GUINT_TO_POINTER(ipsc_info->rpt_id), GUINT_TO_POINTER(caps));
+        }
         break;
 
       default:
         ;
     }
-  }
+
+    caps = GPOINTER_TO_UINT(g_hash_table_lookup(ipsc_peer_caps, GUINT_TO_POINTER(ipsc_info->rpt_id)));
+    if (!(caps & IPSC_PEER_CAPS_KNOWN))
+      packet_data->peer_auth = IPSC_PEER_AUTH_UNKNOWN;
+    else if (caps & 0x10)
+      packet_data->peer_auth = IPSC_PEER_AUTH_YES;
+    else
+      packet_data->peer_auth = IPSC_PEER_AUTH_NO;
 }
 
-void
-proto_register_ipsc(void)
+/*
+ * Header compression, SAP 2 (TCP/IP) and SAP 3 (UDP/IP)
+ *
+ * Compressed headers only make sense against state built up by earlier
+ * packets between the same two radios, so they are expanded on the
+ * first pass, in frame order, when the message is reassembled. The
+ * rebuilt IP packet is kept with the message for later passes.
+ *
+ * TCP/IP is RFC 1144 with the SLIP packet type encoding in the first
+ * octet. UDP/IP follows TS 102 361-3: IPv4 Identification, source and
+ * destination address identifiers, and port identifiers with optional
+ * explicit ports. Addresses of the radio network are built from the
+ * CAI network and the radio (or group) id of the Data Header.
+ */
+#define IPSC_HC_TCP_SLOTS           16
+#define IPSC_HC_MAX_HDR             60      /* IPv4 + TCP, no options */
+
+typedef struct _ipsc_hc_tcp_slot_t {
+    gboolean valid;
+    guint    hdr_len;           /* IP + TCP header */
+    guint    payload_len;       /* of the last packet, for the SPECIAL_x deltas */
+    guint8   hdr[IPSC_HC_MAX_HDR];
+} ipsc_hc_tcp_slot_t;
+
+/* Per source and destination radio */
+typedef struct _ipsc_hc_context_t {
+    ipsc_call_key_t key;
+    /* UDP/IP: last header built, reused while the identifiers stay the same */
+    gboolean udp_valid;
+    guint8   udp_ids[4];        /* SAID/DAID, SPID, DPID and group flag */
+    guint16  udp_ports[2];
+    guint8   udp_hdr[28];
+    /* TCP/IP */
+    guint8   tcp_last_conn;
+    ipsc_hc_tcp_slot_t tcp_slots[IPSC_HC_TCP_SLOTS];
+} ipsc_hc_context_t;
+
+/* TS 102 361-3 UDP port identifiers, 0 means the port follows explicitly */
+static const guint16 ipsc_hc_udp_ports[] = {
+    0,
+    5016,   /* 1 - UTF-16BE text message */
+    5017    /* 2 - Location Interface Protocol */
+};
+
+static void
+ipsc_hc_ip_checksum(guint8 *ip_hdr, guint hdr_len)
 {
-  static const value_string valstring_type[] = {
-    { 0x61, "CALL_CTL_1" },
-    { 0x62, "CALL_CTL_2" },
-    { 0x63, "CALL_CTL_3" },
-    { 0x70, "XCMP_XNL" },
-    { 0x80, "GROUP_VOICE" },
-    { 0x83, "GROUP_DATA" },
-    { 0x84, "PVT_DATA" },
-    { 0x85, "RPT_WAKE_UP" },
-    { 0x90, "MASTER_REG_REQ" },
-    { 0x91, "MASTER_REG_REPLY"},
-    { 0x92, "PEER_LIST_REQ"},
-    { 0x91, "PEER_LIST_REPLY"},
-    { 0x94, "PEER_REG_REQ"},
-    { 0x96, "MASTER_ALIVE_REQ"},
-    { 0x97, "MASTER_ALIVE_REPLY"},
-    { 0x98, "PEER_ALIVE_REQ"},
-    { 0x99, "PEER_ALIVE_REPLY"},
-    { 0x9a, "DE_REG_REQ"},
-    { 0x9b, "DE_REG_REPLY"},
-    { 0, "NULL"}
-  };
+    guint32 sum = 0;
+    guint i;
 
-  static const value_string valstring_linking_peer_op[] = {
-    { 0x00, "Unknown" },
-    { 0x01, "Peer Operational" },
-    { 0x02, "Unknown" },
-    { 0x03, "Unknown" },
-    { 0, NULL },
-  };
+    ip_hdr[10] = 0;
+    ip_hdr[11] = 0;
+    for (i = 0; i < hdr_len; i += 2)
+      sum += (ip_hdr[i] << 8) | ip_hdr[i + 1];
+    while (sum >> 16)
+      sum = (sum & 0xffff) + (sum >> 16);
+    sum = ~sum & 0xffff;
+    ip_hdr[10] = sum >> 8;
+    ip_hdr[11] = sum & 0xff;
+}
 
-  static const value_string valstring_linking_peer_mode[] = {
-    { 0x00, "No Radio" },
-    { 0x01, "Analog Radio" },
-    { 0x02, "Digital Radio" },
-    { 0x03, "Unknown" },
-    { 0, NULL },
-  };
+static guint32
+ipsc_hc_address(guint8 id, guint32 radio_id, gboolean group)
+{
+    switch (id)
+    {
+      /* Radio network, or the group address for group data */
+      case 0x0:
+        return ((group ? ipsc_cai_group_network : ipsc_cai_network) << 24) | (radio_id & 0xffffff);
+      /* USB/Ethernet interface network of the radio */
+      case 0x1:
+        return ((ipsc_cai_network + 1) << 24) | (radio_id & 0xffffff);
+      default:
+        return 0;
+    }
+}
 
-  static const value_string valstring_linking_ipsc_slot[] = {
-    { 0x00, "Unknown" },
-    { 0x01, "OFF" },
-    { 0x02, "ON" },
-    { 0x03, "Unknown" },
-    { 0, NULL },
-  };
+static guint8 *
+ipsc_hc_finish(const guint8 *hdr, guint hdr_len, const guint8 *payload, guint payload_len, guint *len)
+{
+    guint8 *ip_data;
 
-  static const true_false_string valstring_service_flags_rdac = {
-    "RDAC call",
-    "Not a RDAC call"
-  };
+    *len = hdr_len + payload_len;
+    ip_data = (guint8 *)se_alloc(*len);
+    memcpy(ip_data, hdr, hdr_len);
+    memcpy(ip_data + hdr_len, payload, payload_len);
 
-  static const true_false_string valstring_service_flags_rpt_call_mon = {
-    "1",
-    "0"
-  };
+    /* Total Length and header checksum */
+    ip_data[2] = *len >> 8;
+    ip_data[3] = *len & 0xff;
+    ipsc_hc_ip_checksum(ip_data, (ip_data[0] & 0x0f) * 4);
 
-  static const true_false_string valstring_one_zero = {
-    "1",
-    "0"
-  };
+    return ip_data;
+}
 
+static guint8
+ipsc_hc_decompress_udp(ipsc_hc_context_t *context, ipsc_data_pdu_t *pdu)
+{
+    const guint8 *cp = pdu->data;
+    const guint8 *end = pdu->data + pdu->len;
+    guint16 ip_id;
+    guint8 ids[4];
+    guint16 ports[2];
+    guint32 src, dst;
+    guint16 udp_len;
+    guint i;
 
-  static const true_false_string valstring_service_flags_3rdpy = {
-    "3rd Party Console App",
-    "Not a 3rd Party Console App"
-  };
+    if (end - cp < 5)
+      return IPSC_HC_TRUNCATED;
 
-  static const true_false_string valstring_service_flags_auth = {
-    "Yes",
-    "No"
-  };
+    /* IPv4 Identification, SAID/DAID, opcode bit and SPID, opcode bit and DPID */
+    ip_id = (cp[0] << 8) | cp[1];
+    ids[0] = cp[2];
+    ids[1] = cp[3] & 0x7f;
+    ids[2] = cp[4] & 0x7f;
+    ids[3] = pdu->group;
+    cp += 5;
 
-  static const true_false_string valstring_service_flags_voice = {
-    "Yes",
-    "No"
-  };
+    for (i = 0; i < 2; i++)
+    {
+      if (ids[1 + i] == 0)
+      {
+        if (end - cp < 2)
+          return IPSC_HC_TRUNCATED;
+        ports[i] = (cp[0] << 8) | cp[1];
+        cp += 2;
+      }
+      else if (ids[1 + i] < array_length(ipsc_hc_udp_ports))
+        ports[i] = ipsc_hc_udp_ports[ids[1 + i]];
+      else
+        return IPSC_HC_UNKNOWN_PORT_ID;
+    }
 
-  static const true_false_string valstring_service_flags_data = {
-    "Yes",
-    "No"
-  };
+    /* Build the IP and UDP header once per set of identifiers */
+    if (!context->udp_valid || memcmp(context->udp_ids, ids, sizeof(ids)) ||
+        context->udp_ports[0] != ports[0] || context->udp_ports[1] != ports[1])
+    {
+      guint8 *h = context->udp_hdr;
 
-  static const true_false_string valstring_service_flags_unk2 = {
-    "Yes",
-    "No"
-  };
+      src = ipsc_hc_address(ids[0] >> 4, pdu->src_id, FALSE);
+      dst = ipsc_hc_address(ids[0] & 0x0f, pdu->dst_id, pdu->group);
 
-  static const true_false_string valstring_service_flags_master = {
-    "Yes",
-    "No"
-  };
+      memset(h, 0, sizeof(context->udp_hdr));
+      h[0] = 0x45;
+      h[8] = 64;                /* TTL */
+      h[9] = 17;                /* UDP */
+      h[12] = src >> 24; h[13] = src >> 16; h[14] = src >> 8; h[15] = src;
+      h[16] = dst >> 24; h[17] = dst >> 16; h[18] = dst >> 8; h[19] = dst;
+      h[20] = ports[0] >> 8; h[21] = ports[0] & 0xff;
+      h[22] = ports[1] >> 8; h[23] = ports[1] & 0xff;
+      /* UDP checksum left 0, not computed */
 
-  static const value_string valstring_data_type[] = {
-    { 0x00, "PI header" },
-    { 0x01, "Voice LC Header" },
-    { 0x02, "Terminator with LC" },
-    { 0x03, "CSBK" },
-    { 0x04, "MBC Header" },
-    { 0x05, "MBC Continuation" },
-    { 0x06, "Data Header" },
-    { 0x07, "Rate 1/2 Data" },
-    { 0x08, "Rate 3/4 Data" },
-    { 0x09, "Idle" },
-    { 0x0a, "Rate 1 Data" },
-    { 0x0b, "Reserved" },
-    { 0x0c, "Reserved" },
-    { 0x0d, "Reserved" },
-    { 0x0e, "Reserved" },
-    { 0x0f, "Reserved" },
-    { 0, NULL },
-  };
+      memcpy(context->udp_ids, ids, sizeof(ids));
+      context->udp_ports[0] = ports[0];
+      context->udp_ports[1] = ports[1];
+      context->udp_valid = TRUE;
+    }
 
-  static const value_string valstring_data_packet_format[] = {
-    { 0x0, "Unified Data Transport (UTD)" },
-    { 0x1, "Response Packet" },
-    { 0x2, "Data packet with unconfirmed delivery" },
-    { 0x3, "Data packet with confirmed delivery" },
-    { 0xd, "Short Data: Defined" },
-    { 0xe, "Short Data: Raw or Status/Precoded " },
-    { 0xf, "Proprietary Data Packet" },
-    { 0, NULL },
-  };
+    /* Per packet fields */
+    context->udp_hdr[4] = ip_id >> 8;
+    context->udp_hdr[5] = ip_id & 0xff;
+    udp_len = 8 + (guint16)(end - cp);
+    context->udp_hdr[24] = udp_len >> 8;
+    context->udp_hdr[25] = udp_len & 0xff;
 
-  static const value_string valstring_service_access_point[] = {
-    { 0x0, "Unified Data Transport (UDT)" },
-    { 0x1, "Reserved" },
-    { 0x2, "TCP/IP header compression" },
-    { 0x3, "UDP/IP header compression" },
-    { 0x4, "IP based Packet data" },
-    { 0x5, "Address Resolution Protocol (ARP)" },
-    { 0x6, "Reserved" },
-    { 0x7, "Reserved" },
-    { 0x8, "Reserved" },
-    { 0x9, "Proprietary Packet data" },
-    { 0xa, "Short Data" },
-    { 0xb, "Reserved" },
-    { 0xc, "Reserved" },
-    { 0xd, "Reserved" },
-    { 0xe, "Reserved" },
-    { 0xf, "Reserved" },
-    { 0x0, NULL}
-  };
+    pdu->ip_data = ipsc_hc_finish(context->udp_hdr, 28, cp, (guint)(end - cp), &pdu->ip_len);
+
+    return IPSC_HC_OK;
+}
 
+/* RFC 1144 change mask */
+#define IPSC_HC_NEW_C       0x40
+#define IPSC_HC_NEW_I       0x20
+#define IPSC_HC_TCP_PUSH    0x10
+#define IPSC_HC_NEW_S       0x08
+#define IPSC_HC_NEW_A       0x04
+#define IPSC_HC_NEW_W       0x02
+#define IPSC_HC_NEW_U       0x01
+#define IPSC_HC_SPECIALS    (IPSC_HC_NEW_S|IPSC_HC_NEW_A|IPSC_HC_NEW_W|IPSC_HC_NEW_U)
+#define IPSC_HC_SPECIAL_I   (IPSC_HC_NEW_S|IPSC_HC_NEW_W|IPSC_HC_NEW_U)
+#define IPSC_HC_SPECIAL_D   IPSC_HC_SPECIALS
 
-  static hf_register_info hf[] = {
-    { &hf_ipsc_type, 
-      { "Type", "ipsc.type", FT_UINT8, BASE_HEX, VALS(valstring_type), 0x0, NULL, HFILL }
+/* A delta is one octet, or 0 followed by two octets */
+static gboolean
+ipsc_hc_decode_delta(const guint8 **cp, const guint8 *end, guint32 *delta)
+{
+    if (*cp >= end)
+      return FALSE;
+    if (**cp != 0)
+    {
+      *delta = *(*cp)++;
+      return TRUE;
+    }
+    if (end - *cp < 3)
+      return FALSE;
+    *delta = ((*cp)[1] << 8) | (*cp)[2];
+    *cp += 3;
+    return TRUE;
+}
+
+static void
+ipsc_hc_add16(guint8 *p, guint32 delta)
+{
+    guint16 v = ((p[0] << 8) | p[1]) + delta;
+
+    p[0] = v >> 8;
+    p[1] = v & 0xff;
+}
+
+static void
+ipsc_hc_add32(guint8 *p, guint32 delta)
+{
+    guint32 v = ((guint32)p[0] << 24 | p[1] << 16 | p[2] << 8 | p[3]) + delta;
+
+    p[0] = v >> 24;
+    p[1] = v >> 16;
+    p[2] = v >> 8;
+    p[3] = v & 0xff;
+}
+
+static guint8
+ipsc_hc_decompress_tcp(ipsc_hc_context_t *context, ipsc_data_pdu_t *pdu)
+{
+    const guint8 *cp = pdu->data;
+    const guint8 *end = pdu->data + pdu->len;
+    ipsc_hc_tcp_slot_t *slot;
+    guint8 *ip, *th;
+    guint8 changes;
+    guint ip_hlen;
+    guint32 delta;
+
+    if (cp >= end)
+      return IPSC_HC_TRUNCATED;
+
+    /* TYPE_IP, nothing to do */
+    if ((cp[0] & 0xf0) == 0x40)
+    {
+      pdu->ip_data = pdu->data;
+      pdu->ip_len = pdu->len;
+      return IPSC_HC_OK;
+    }
+
+    /* TYPE_UNCOMPRESSED_TCP, the protocol field carries the connection */
+    if ((cp[0] & 0xf0) == 0x70)
+    {
+      ip_hlen = (cp[0] & 0x0f) * 4;
+      if (pdu->len < ip_hlen + 20 || ip_hlen < 20)
+        return IPSC_HC_TRUNCATED;
+
+      context->tcp_last_conn = cp[9];
+      slot = &context->tcp_slots[context->tcp_last_conn % IPSC_HC_TCP_SLOTS];
+      slot->hdr_len = ip_hlen + (cp[ip_hlen + 12] >> 4) * 4;
+      if (slot->hdr_len > IPSC_HC_MAX_HDR || slot->hdr_len > pdu->len)
+        return IPSC_HC_TRUNCATED;
+
+      memcpy(slot->hdr, cp, slot->hdr_len);
+      slot->hdr[0] = (slot->hdr[0] & 0x0f) | 0x40;
+      slot->hdr[9] = 6;         /* TCP */
+      slot->payload_len = pdu->len - slot->hdr_len;
+      slot->valid = TRUE;
+
+      pdu->ip_data = ipsc_hc_finish(slot->hdr, slot->hdr_len, cp + slot->hdr_len, slot->payload_len, &pdu->ip_len);
+      return IPSC_HC_OK;
+    }
+
+    /* TYPE_COMPRESSED_TCP */
+    if (!(cp[0] & 0x80))
+      return IPSC_HC_NO_CONTEXT;
+
+    changes = *cp++;
+    if (changes & IPSC_HC_NEW_C)
+    {
+      if (cp >= end)
+        return IPSC_HC_TRUNCATED;
+      context->tcp_last_conn = *cp++;
+    }
+
+    slot = &context->tcp_slots[context->tcp_last_conn % IPSC_HC_TCP_SLOTS];
+    if (!slot->valid)
+      return IPSC_HC_NO_CONTEXT;
+
+    ip = slot->hdr;
+    ip_hlen = (ip[0] & 0x0f) * 4;
+    th = ip + ip_hlen;
+
+    /* TCP checksum is sent as is */
+    if (end - cp < 2)
+      return IPSC_HC_TRUNCATED;
+    th[16] = cp[0];
+    th[17] = cp[1];
+    cp += 2;
+
+    if (changes & IPSC_HC_TCP_PUSH)
+      th[13] |= 0x08;
+    else
+      th[13] &= ~0x08;
+
+    switch (changes & IPSC_HC_SPECIALS)
+    {
+      case IPSC_HC_SPECIAL_I:
+        ipsc_hc_add32(th + 8, slot->payload_len);
+        ipsc_hc_add32(th + 4, slot->payload_len);
+        break;
+
+      case IPSC_HC_SPECIAL_D:
+        ipsc_hc_add32(th + 4, slot->payload_len);
+        break;
+
+      default:
+        if (changes & IPSC_HC_NEW_U)
+        {
+          th[13] |= 0x20;
+          if (!ipsc_hc_decode_delta(&cp, end, &delta))
+            return IPSC_HC_TRUNCATED;
+          th[18] = delta >> 8;
+          th[19] = delta & 0xff;
+        }
+        else
+          th[13] &= ~0x20;
+        if (changes & IPSC_HC_NEW_W)
+        {
+          if (!ipsc_hc_decode_delta(&cp, end, &delta))
+            return IPSC_HC_TRUNCATED;
+          ipsc_hc_add16(th + 14, (guint32)(gint16)delta);
+        }
+        if (changes & IPSC_HC_NEW_A)
+        {
+          if (!ipsc_hc_decode_delta(&cp, end, &delta))
+            return IPSC_HC_TRUNCATED;
+          ipsc_hc_add32(th + 8, delta);
+        }
+        if (changes & IPSC_HC_NEW_S)
+        {
+          if (!ipsc_hc_decode_delta(&cp, end, &delta))
+            return IPSC_HC_TRUNCATED;
+          ipsc_hc_add32(th + 4, delta);
+        }
+    }
+
+    /* IPv4 Identification */
+    if (changes & IPSC_HC_NEW_I)
+    {
+      if (!ipsc_hc_decode_delta(&cp, end, &delta))
+        return IPSC_HC_TRUNCATED;
+      ipsc_hc_add16(ip + 4, delta);
+    }
+    else
+      ipsc_hc_add16(ip + 4, 1);
+
+    slot->payload_len = (guint)(end - cp);
+    pdu->ip_data = ipsc_hc_finish(slot->hdr, slot->hdr_len, cp, slot->payload_len, &pdu->ip_len);
+
+    return IPSC_HC_OK;
+}
+
+static void
+ipsc_hc_decompress(ipsc_data_pdu_t *pdu)
+{
+    ipsc_hc_context_t *context;
+    ipsc_call_key_t key;
+
+    memset(&key, 0, sizeof(key));
+    key.src_id = pdu->src_id;
+    key.dst_id = pdu->dst_id;
+
+    context = (ipsc_hc_context_t *)g_hash_table_lookup(ipsc_hc_contexts, &key);
+    if (!context)
+    {
+      context = se_new0(ipsc_hc_context_t);
+      context->key = key;
+      g_hash_table_insert(ipsc_hc_contexts, &context->key, context);
+    }
+
+    if (pdu->sap == 0x2)
+      pdu->hc_status = ipsc_hc_decompress_tcp(context, pdu);
+    else
+      pdu->hc_status = ipsc_hc_decompress_udp(context, pdu);
+}
+
+static gboolean
+ipsc_data_transfer_expired(gpointer key _U_, gpointer value, gpointer user_data)
+{
+    ipsc_data_transfer_t *transfer = (ipsc_data_transfer_t *)value;
+    const nstime_t *now = (const nstime_t *)user_data;
+
+    return (now->secs - transfer->last_time.secs > IPSC_DATA_TIMEOUT);
+}
+
+/*
+ * Feed a GROUP_DATA or PVT_DATA Data Header or data block into the
+ * reassembly. A burst forwarded raw goes in as the 96 bits decoded by
+ * ipsc_track_raw_burst(). Only called on the first pass; every read is
+ * length checked.
+ */
+static void
+ipsc_track_data(tvbuff_t *tvb, packet_info *pinfo, const ipsc_info_t *ipsc_info,
+                const ipsc_call_key_t *key, ipsc_packet_data_t *packet_data)
+{
+    ipsc_data_transfer_t *transfer;
+    ipsc_wire_msg_t msg;
+    ipsc_wire_call_t call;
+    ipsc_wire_data_hdr_t hdr;
+    const guint8 *payload;
+    size_t block_len;
+    gboolean raw;
+    guint8 dpf;
+
+    /* Data only follows when Length to Follow is set */
+    ipsc_wire_msg_tvb(tvb, &msg);
+    if (!ipsc_wire_call(&msg, &call) || !(payload = ipsc_wire_call_payload(&call, &block_len)))
+      return;
+
+    /* Raw burst: the decoded bits if it is BPTC, nothing to append if not */
+    raw = (block_len >= IPSC_RAW_BURST_LEN &&
+           ipsc_wire_get16(call.data + IPSC_CALL_OFF_DATA_SIZE) == IPSC_RAW_BURST_BITS);
+    if (packet_data->burst)
+    {
+      payload = packet_data->burst;
+      block_len = IPSC_BURST_LEN;
+    }
+
+    transfer = (ipsc_data_transfer_t *)g_hash_table_lookup(ipsc_data_transfers, key);
+
+    /* A stalled transfer is not continued by anything */
+    if (transfer && pinfo->fd->abs_ts.secs - transfer->last_time.secs > IPSC_DATA_TIMEOUT)
+    {
+      g_hash_table_remove(ipsc_data_transfers, key);
+      packet_data->data_flags |= IPSC_DATA_ABANDONED;
+      transfer = NULL;
+    }
+
+    switch (ipsc_info->data_type)
+    {
+      /* Data Header */
+      case IPSC_DATA_TYPE_DATA_HDR:
+      {
+        /* A corrupted header neither ends the running transfer nor starts one */
+        if (!ipsc_wire_data_hdr(payload, block_len, &hdr) || !ipsc_wire_data_hdr_crc_ok(&hdr))
+          return;
+
+        if (transfer)
+        {
+          g_hash_table_remove(ipsc_data_transfers, key);
+          packet_data->data_flags |= IPSC_DATA_ABANDONED;
+        }
+
+        /* Only unconfirmed and confirmed packet data carry blocks that way */
+        dpf = ipsc_wire_data_hdr_dpf(&hdr);
+        if ((dpf != 0x2 && dpf != 0x3) || ipsc_wire_data_hdr_blocks(&hdr) == 0)
+          return;
+
+        if (g_hash_table_size(ipsc_data_transfers) >= IPSC_DATA_MAX_PENDING)
+        {
+          g_hash_table_foreach_remove(ipsc_data_transfers, ipsc_data_transfer_expired, &pinfo->fd->abs_ts);
+          if (g_hash_table_size(ipsc_data_transfers) >= IPSC_DATA_MAX_PENDING)
+          {
+            packet_data->data_flags |= IPSC_DATA_TABLE_FULL;
+            return;
+          }
+        }
+
+        transfer = g_new0(ipsc_data_transfer_t, 1);
+        transfer->key = *key;
+        transfer->confirmed = (dpf == 0x3);
+        transfer->pad_octets = ipsc_wire_data_hdr_pad_octets(&hdr);
+        transfer->last_time = pinfo->fd->abs_ts;
+
+        transfer->pdu = se_new0(ipsc_data_pdu_t);
+        transfer->pdu->header_frame = pinfo->fd->num;
+        transfer->pdu->blocks = ipsc_wire_data_hdr_blocks(&hdr);
+        transfer->pdu->sap = ipsc_wire_data_hdr_sap(&hdr);
+        transfer->pdu->group = ipsc_wire_data_hdr_group(&hdr) ? TRUE : FALSE;
+        transfer->pdu->dst_id = ipsc_wire_data_hdr_dst_id(&hdr);
+        transfer->pdu->src_id = ipsc_wire_data_hdr_src_id(&hdr);
+
+        g_hash_table_insert(ipsc_data_transfers, &transfer->key, transfer);
+
+        packet_data->data_pdu = transfer->pdu;
+        packet_data->data_block = 0;
+      }; break;
+
+      /* Rate 1/2, Rate 3/4 and Rate 1 Data blocks */
+      case IPSC_DATA_TYPE_RATE_12:
+      case IPSC_DATA_TYPE_RATE_34:
+      case IPSC_DATA_TYPE_RATE_1:
+      {
+        if (!transfer)
+          return;
+
+        /* Trellis coded or uncorrectable, the PDU cannot be completed */
+        if (raw && (!packet_data->burst || packet_data->burst_errors < 0))
+        {
+          g_hash_table_remove(ipsc_data_transfers, key);
+          packet_data->data_flags |= IPSC_DATA_RAW_BLOCK;
+          return;
+        }
+
+        if (block_len > IPSC_DATA_MAX_BLOCK_LEN)
+          block_len = IPSC_DATA_MAX_BLOCK_LEN;
+
+        /* Serial number and CRC-9 of confirmed blocks are not user data */
+        if (transfer->confirmed && block_len >= 2)
+        {
+          payload += 2;
+          block_len -= 2;
+        }
+
+        memcpy(transfer->buf + transfer->len, payload, block_len);
+        transfer->len += block_len;
+        transfer->last_time = pinfo->fd->abs_ts;
+
+        packet_data->data_pdu = transfer->pdu;
+        packet_data->data_block = ++transfer->next_block;
+
+        if (transfer->next_block == transfer->pdu->blocks)
+        {
+          /* The last block ends with pad octets and the message CRC-32 */
+          if (transfer->len > (guint)transfer->pad_octets + 4)
+          {
+            transfer->pdu->len = transfer->len - transfer->pad_octets - 4;
+            transfer->pdu->data = (guint8 *)se_memdup(transfer->buf, transfer->pdu->len);
+          }
+          transfer->pdu->reassembled_in = pinfo->fd->num;
+
+          /* TCP/IP and UDP/IP header compression */
+          if (transfer->pdu->len && (transfer->pdu->sap == 0x2 || transfer->pdu->sap == 0x3))
+            ipsc_hc_decompress(transfer->pdu);
+
+          g_hash_table_remove(ipsc_data_transfers, key);
+        }
+      }; break;
+
+      default:
+        ;
+    }
+}
+
+/*
+ * Run one packet through the stream analysis. Only called on the
+ * first pass, in frame order.
+ */
+static void
+ipsc_analyse_stream(packet_info *pinfo, const ipsc_info_t *ipsc_info,
+                    ipsc_stream_t *stream, ipsc_packet_data_t *packet_data)
+{
+    gint16 seq_delta;
+    nstime_t arrival_delta;
+    gdouble transit_delta;
+
+    stream->received++;
+
+    if (!stream->seen)
+    {
+      stream->seen = TRUE;
+      stream->max_seq = ipsc_info->call_seq_no;
+      stream->window = 1;
+      stream->last_timestamp = ipsc_info->timestamp;
+      stream->last_arrival = pinfo->fd->abs_ts;
+      return;
+    }
+
+    seq_delta = (gint16)(ipsc_info->call_seq_no - stream->max_seq);
+
+    if (seq_delta > 0)
+    {
+      /* In order, possibly after a gap */
+      if (seq_delta > 1)
+      {
+        packet_data->stream_flags |= IPSC_STREAM_SEQ_GAP;
+        packet_data->lost = seq_delta - 1;
+        stream->lost += seq_delta - 1;
+      }
+
+      stream->window = (seq_delta < IPSC_SEQ_WINDOW) ? (stream->window << seq_delta) | 1 : 1;
+      stream->max_seq = ipsc_info->call_seq_no;
+
+      /* RFC 3550 interarrival jitter, in ms */
+      nstime_delta(&arrival_delta, &pinfo->fd->abs_ts, &stream->last_arrival);
+      packet_data->delta = nstime_to_msec(&arrival_delta);
+      transit_delta = packet_data->delta -
+          (gdouble)(guint32)(ipsc_info->timestamp - stream->last_timestamp) * 1000.0 / IPSC_TIMESTAMP_RATE;
+      if (transit_delta < 0)
+        transit_delta = -transit_delta;
+      stream->jitter += (transit_delta - stream->jitter) / 16.0;
+      if (stream->jitter > stream->max_jitter)
+        stream->max_jitter = stream->jitter;
+
+      stream->last_timestamp = ipsc_info->timestamp;
+      stream->last_arrival = pinfo->fd->abs_ts;
+    }
+    else if (seq_delta == 0 ||
+             (-seq_delta < IPSC_SEQ_WINDOW && (stream->window & (G_GUINT64_CONSTANT(1) << -seq_delta))))
+    {
+      packet_data->stream_flags |= IPSC_STREAM_DUPLICATE;
+      stream->duplicates++;
+    }
+    else if (-seq_delta < IPSC_SEQ_WINDOW)
+    {
+      /* Late, it was counted as lost when the gap was seen */
+      packet_data->stream_flags |= IPSC_STREAM_OUT_OF_ORDER;
+      stream->out_of_order++;
+      if (stream->lost)
+        stream->lost--;
+      stream->window |= G_GUINT64_CONSTANT(1) << -seq_delta;
+    }
+    else
+    {
+      /* Too far back to be late, the sender started over */
+      stream->max_seq = ipsc_info->call_seq_no;
+      stream->window = 1;
+      stream->last_timestamp = ipsc_info->timestamp;
+      stream->last_arrival = pinfo->fd->abs_ts;
+    }
+
+    packet_data->jitter = stream->jitter;
+}
+
+static void
+ipsc_track_airtime(packet_info *pinfo, const ipsc_info_t *ipsc_info, ipsc_packet_data_t *packet_data)
+{
+    ipsc_call_key_t key;
+    ipsc_slot_usage_t *usage;
+    nstime_t elapsed;
+    gdouble span, fit;
+    guint bursts, lost;
+
+    key.rpt_id = ipsc_info->rpt_id;
+    key.src_id = 0;
+    key.dst_id = 0;
+    key.slot = ipsc_info->slot;
+
+    usage = (ipsc_slot_usage_t *)g_hash_table_lookup(ipsc_slot_usage, &key);
+    if (!usage)
+    {
+      usage = g_new0(ipsc_slot_usage_t, 1);
+      usage->key = key;
+      g_hash_table_insert(ipsc_slot_usage, &usage->key, usage);
+    }
+
+    /*
+     * Late packets were already counted with the gap before them. The
+     * lost bursts had to fit in the time since the previous packet of
+     * the stream, which bounds a jump of the sequence number.
+     */
+    lost = packet_data->lost;
+    fit = packet_data->delta / (IPSC_BURST_TIME * 1000.0) + 0.5;
+    if (lost > fit)
+      lost = (guint)fit;
+
+    if (packet_data->stream_flags & (IPSC_STREAM_DUPLICATE | IPSC_STREAM_OUT_OF_ORDER))
+      bursts = 0;
+    else
+      bursts = 1 + lost;
+
+    usage->bursts += bursts;
+    if (packet_data->call_start)
+      usage->calls++;
+
+    packet_data->airtime = bursts * IPSC_BURST_TIME;
+    packet_data->slot_busy = usage->bursts * IPSC_BURST_TIME;
+    packet_data->slot_calls = usage->calls;
+
+    /* Up to the end of this burst, so a busy slot reads 100% and not more */
+    nstime_delta(&elapsed, &pinfo->fd->abs_ts, &ipsc_first_time);
+    span = nstime_to_sec(&elapsed) + IPSC_BURST_TIME;
+    packet_data->slot_utilization = (packet_data->slot_busy < span) ? 100.0 * packet_data->slot_busy / span : 100.0;
+}
+
+static void
+ipsc_track_rssi(packet_info *pinfo, const ipsc_info_t *ipsc_info, ipsc_packet_data_t *packet_data)
+{
+    ipsc_call_key_t key;
+    ipsc_rssi_series_t *series;
+    gint64 start;
+
+    if (!ipsc_info->has_rssi)
+      return;
+
+    key.rpt_id = ipsc_info->rpt_id;
+    key.src_id = ipsc_info->src_id;
+    key.dst_id = 0;
+    key.slot = ipsc_info->slot;
+
+    series = (ipsc_rssi_series_t *)g_hash_table_lookup(ipsc_rssi_series, &key);
+    if (!series)
+    {
+      series = g_new0(ipsc_rssi_series_t, 1);
+      series->key = key;
+      g_hash_table_insert(ipsc_rssi_series, &series->key, series);
+    }
+
+    start = ipsc_wire_rssi_bucket(pinfo->fd->abs_ts.secs, ipsc_rssi_interval ? ipsc_rssi_interval : 1);
+    if (!series->stats.count || series->stats.start != start)
+    {
+      memset(&series->stats, 0, sizeof(series->stats));
+      series->stats.start = start;
+    }
+
+    ipsc_wire_rssi_stats_add(&series->stats, ipsc_info->rssi);
+    packet_data->rssi = series->stats;
+}
+
+static void
+ipsc_track_link(packet_info *pinfo, const ipsc_info_t *ipsc_info, ipsc_packet_data_t *packet_data)
+{
+    conversation_t *conversation;
+    ipsc_link_t *link;
+    ipsc_rr_t *rr;
+    guint kind;
+    int dir;
+
+    if (ipsc_info->opcode < 0x90 || ipsc_info->opcode > 0x9b)
+      return;
+
+    kind = (ipsc_info->opcode - 0x90) >> 1;
+
+    conversation = find_or_create_conversation(pinfo);
+    link = (ipsc_link_t *)conversation_get_proto_data(conversation, proto_ipsc);
+    if (!link)
+    {
+      link = se_new0(ipsc_link_t);
+      conversation_add_proto_data(conversation, proto_ipsc, link);
+    }
+
+    /* Direction within the conversation, as TCP does it */
+    dir = CMP_ADDRESS(&pinfo->src, &pinfo->dst);
+    if (dir == 0)
+      dir = (pinfo->srcport > pinfo->destport) ? 1 : -1;
+    dir = (dir > 0) ? 1 : 0;
+
+    if (!(ipsc_info->opcode & 0x01))
+    {
+      /* Request */
+      rr = &link->pending[dir][kind];
+
+      if (rr->frame && (kind == IPSC_RR_MASTER_ALIVE || kind == IPSC_RR_PEER_ALIVE))
+      {
+        if (link->missed[dir] < G_MAXUINT8)
+          link->missed[dir]++;
+        packet_data->rr_unanswered = rr->frame;
+        packet_data->rr_missed = link->missed[dir];
+
+        if (link->missed[dir] == IPSC_PEER_MAX_MISSED && link->up)
+        {
+          link->up = FALSE;
+          packet_data->peer_event = IPSC_PEER_EVENT_LEAVE;
+        }
+      }
+
+      if (kind == IPSC_RR_DE_REG && link->up)
+      {
+        link->up = FALSE;
+        packet_data->peer_event = IPSC_PEER_EVENT_LEAVE;
+      }
+
+      rr->frame = pinfo->fd->num;
+      rr->time = pinfo->fd->abs_ts;
+      rr->rpt_id = ipsc_info->rpt_id;
+      rr->packet_data = packet_data;
+    }
+    else
+    {
+      /* Reply, to the request that went the other way */
+      rr = &link->pending[!dir][kind];
+      if (!rr->frame)
+        return;
+
+      packet_data->rr_frame = rr->frame;
+      nstime_delta(&packet_data->rr_time, &pinfo->fd->abs_ts, &rr->time);
+      packet_data->rr_rpt_id = rr->rpt_id;
+      rr->packet_data->rr_frame = pinfo->fd->num;
+      rr->frame = 0;
+      link->missed[!dir] = 0;
+
+      /* MASTER_REG, PEER_REG and the keepalives mean the peer is there */
+      if (!link->up && kind != IPSC_RR_PEER_LIST && kind != IPSC_RR_DE_REG)
+      {
+        link->up = TRUE;
+        packet_data->peer_event = IPSC_PEER_EVENT_JOIN;
+      }
+    }
+}
+
+static void
+ipsc_track_peer_list(tvbuff_t *tvb, packet_info *pinfo, const ipsc_info_t *ipsc_info,
+                     ipsc_packet_data_t *packet_data)
+{
+    ipsc_wire_msg_t msg;
+    ipsc_wire_peer_list_t list, old_list;
+    ipsc_peer_list_t *last;
+    ipsc_peer_t *peer;
+    const guint8 *e;
+    guint32 rpt_id, ip;
+    guint len;
+    size_t i;
+
+    ipsc_wire_msg_tvb(tvb, &msg);
+    if (!ipsc_wire_peer_list(&msg, &list))
+      return;
+
+    len = (guint)(list.count * IPSC_PEER_LEN);
+    last = (ipsc_peer_list_t *)g_hash_table_lookup(ipsc_peer_lists, GUINT_TO_POINTER(ipsc_info->rpt_id));
+
+    /* Nothing new, the usual case */
+    if (last && last->len == len && memcmp(last->entries, list.entries, len) == 0)
+    {
+      packet_data->peer_list_same_as = last->frame;
+      return;
+    }
+
+    /* Added or changed peers */
+    for (i = 0; i < list.count; i++)
+    {
+      e = ipsc_wire_peer(&list, i);
+      rpt_id = ipsc_wire_peer_rpt_id(e);
+      ip = g_htonl(ipsc_wire_peer_ip(e));
+
+      peer = (ipsc_peer_t *)g_hash_table_lookup(ipsc_peer_table, GUINT_TO_POINTER(rpt_id));
+      if (!peer || peer->master_id != ipsc_info->rpt_id || peer->ip != ip ||
+          peer->port != ipsc_wire_peer_port(e) || peer->linking != ipsc_wire_peer_linking(e))
+      {
+        peer = se_new0(ipsc_peer_t);
+        peer->rpt_id = rpt_id;
+        peer->master_id = ipsc_info->rpt_id;
+        peer->ip = ip;
+        peer->port = ipsc_wire_peer_port(e);
+        peer->linking = ipsc_wire_peer_linking(e);
+        peer->listed_in = pinfo->fd->num;
+        g_hash_table_insert(ipsc_peer_table, GUINT_TO_POINTER(rpt_id), peer);
+      }
+      peer->last_list = pinfo->fd->num;
+    }
+
+    if (!last)
+    {
+      last = se_new0(ipsc_peer_list_t);
+      g_hash_table_insert(ipsc_peer_lists, GUINT_TO_POINTER(ipsc_info->rpt_id), last);
+    }
+    else
+    {
+      /* Dropped peers, in the old list of this master and not in this one */
+      old_list.entries = last->entries;
+      old_list.count = last->len / IPSC_PEER_LEN;
+      for (i = 0; i < old_list.count; i++)
+      {
+        rpt_id = ipsc_wire_peer_rpt_id(ipsc_wire_peer(&old_list, i));
+        peer = (ipsc_peer_t *)g_hash_table_lookup(ipsc_peer_table, GUINT_TO_POINTER(rpt_id));
+        if (peer && peer->master_id == ipsc_info->rpt_id && peer->last_list != pinfo->fd->num)
+          g_hash_table_remove(ipsc_peer_table, GUINT_TO_POINTER(rpt_id));
+      }
+    }
+
+    last->frame = pinfo->fd->num;
+    last->len = len;
+    last->entries = (guint8 *)se_memdup(list.entries, len);
+}
+
+static void
+ipsc_track_xnl(tvbuff_t *tvb, packet_info *pinfo, const ipsc_info_t *ipsc_info,
+               ipsc_packet_data_t *packet_data)
+{
+    ipsc_xnl_pending_t *pending;
+    ipsc_xcmp_transaction_t *transaction;
+    ipsc_wire_xnl_t xnl;
+    const guint8 *data;
+    guint len;
+    guint16 opcode;
+    guint64 key;
+    guint64 pending_key;
+
+    if (ipsc_info->opcode != 0x70 || tvb_length(tvb) < IPSC_XNL_OFF_DATA)
+      return;
+
+    len = tvb_get_ntohs(tvb, IPSC_XNL_OFF_LENGTH);
+    if (len > tvb_length(tvb) - IPSC_XNL_OFF_DATA)
+      len = tvb_length(tvb) - IPSC_XNL_OFF_DATA;
+    data = tvb_get_ptr(tvb, IPSC_XNL_OFF_DATA, len);
+
+    /* The repeater sends the pieces one after the other on its conversation */
+    pending_key = (guint64)find_or_create_conversation(pinfo)->index << 32 | ipsc_info->rpt_id;
+    pending = (ipsc_xnl_pending_t *)g_hash_table_lookup(ipsc_xnl_pending, &pending_key);
+    if (pending && pinfo->fd->abs_ts.secs - pending->last_time.secs > IPSC_XNL_TIMEOUT)
+    {
+      g_hash_table_remove(ipsc_xnl_pending, &pending_key);
+      pending = NULL;
+    }
+
+    if (pending)
+    {
+      /* The next piece of an XNL packet */
+      if (len > pending->total - pending->len)
+        len = pending->total - pending->len;
+      memcpy(pending->buf + pending->len, data, len);
+      pending->len += len;
+      pending->last_time = pinfo->fd->abs_ts;
+
+      packet_data->xnl_pdu = pending->pdu;
+      packet_data->xnl_piece = (guint8)MIN(++pending->pdu->pieces, G_MAXUINT8);
+
+      if (pending->len < pending->total)
+        return;
+
+      /* Complete */
+      pending->pdu->data = (guint8 *)se_memdup(pending->buf, pending->total);
+      pending->pdu->len = pending->total;
+      pending->pdu->reassembled_in = pinfo->fd->num;
+      g_hash_table_remove(ipsc_xnl_pending, &pending_key);
+
+      data = packet_data->xnl_pdu->data;
+      len = packet_data->xnl_pdu->len;
+    }
+    else
+    {
+      if (!ipsc_wire_xnl(data, len, &xnl))
+        return;
+
+      /* The first piece of an XNL packet that does not fit */
+      if (ipsc_wire_xnl_total_len(&xnl) > len)
+      {
+        pending = g_new0(ipsc_xnl_pending_t, 1);
+        pending->key = pending_key;
+        pending->total = (guint)ipsc_wire_xnl_total_len(&xnl);
+        pending->buf = (guint8 *)g_malloc(pending->total);
+        memcpy(pending->buf, data, len);
+        pending->len = len;
+        pending->last_time = pinfo->fd->abs_ts;
+
+        pending->pdu = se_new0(ipsc_xnl_pdu_t);
+        pending->pdu->first_frame = pinfo->fd->num;
+        pending->pdu->pieces = 1;
+        g_hash_table_insert(ipsc_xnl_pending, &pending->key, pending);
+
+        packet_data->xnl_pdu = pending->pdu;
+        packet_data->xnl_piece = 1;
+        return;
+      }
+    }
+
+    /* XCMP request/reply matching, on the whole XNL packet */
+    if (!ipsc_wire_xnl(data, len, &xnl) || (opcode = ipsc_wire_xcmp_opcode(&xnl)) == 0)
+      return;
+
+    switch (opcode & IPSC_XCMP_TYPE_MASK)
+    {
+      case IPSC_XCMP_TYPE_REQUEST:
+        transaction = se_new0(ipsc_xcmp_transaction_t);
+        transaction->key = (guint64)ipsc_wire_xnl_src(&xnl) << 32 | (guint64)ipsc_wire_xnl_dst(&xnl) << 16 |
+                           ipsc_wire_xnl_trans_id(&xnl);
+        transaction->opcode = opcode;
+        transaction->request_frame = pinfo->fd->num;
+        transaction->request_time = pinfo->fd->abs_ts;
+        g_hash_table_insert(ipsc_xcmp_transactions, &transaction->key, transaction);
+        packet_data->xcmp = transaction;
+        break;
+
+      case IPSC_XCMP_TYPE_REPLY:
+        key = (guint64)ipsc_wire_xnl_dst(&xnl) << 32 | (guint64)ipsc_wire_xnl_src(&xnl) << 16 |
+              ipsc_wire_xnl_trans_id(&xnl);
+        transaction = (ipsc_xcmp_transaction_t *)g_hash_table_lookup(ipsc_xcmp_transactions, &key);
+        if (!transaction || transaction->reply_frame ||
+            (transaction->opcode & ~IPSC_XCMP_TYPE_MASK) != (opcode & ~IPSC_XCMP_TYPE_MASK))
+          return;
+
+        transaction->reply_frame = pinfo->fd->num;
+        g_hash_table_remove(ipsc_xcmp_transactions, &key);
+        packet_data->xcmp = transaction;
+        break;
+
+      default:
+        ;
+    }
+}
+
+/*
+ * Collect the embedded signalling of a voice burst, first pass only.
+ * A fragment out of place, after a lost burst or a first one missed,
+ * drops what was collected until the next first fragment.
+ */
+static void
+ipsc_track_emb_lc(tvbuff_t *tvb, packet_info *pinfo, const ipsc_info_t *ipsc_info,
+                  const ipsc_call_key_t *key, ipsc_packet_data_t *packet_data)
+{
+    ipsc_emb_lc_t *emb_lc;
+    ipsc_wire_msg_t msg;
+    ipsc_wire_call_t call;
+    ipsc_wire_voice_t voice;
+    guint8 lcss, burst;
+    int errors;
+
+    /* Nothing more to come once the call is over */
+    if (ipsc_info->data_type == 0x02)
+    {
+      g_hash_table_remove(ipsc_emb_lcs, key);
+      return;
+    }
+
+    if (!ipsc_info->is_voice)
+      return;
+
+    ipsc_wire_msg_tvb(tvb, &msg);
+    if (!ipsc_wire_call(&msg, &call) || !ipsc_wire_voice(&call, &voice) || !ipsc_wire_voice_has_emb(&voice))
+      return;
+
+    lcss = ipsc_wire_voice_emb_lcss(&voice);
+    burst = ipsc_wire_voice_burst(&voice);
+    emb_lc = (ipsc_emb_lc_t *)g_hash_table_lookup(ipsc_emb_lcs, key);
+
+    if (lcss == IPSC_EMB_LCSS_FIRST)
+    {
+      if (!emb_lc)
+      {
+        emb_lc = g_new0(ipsc_emb_lc_t, 1);
+        emb_lc->key = *key;
+        g_hash_table_insert(ipsc_emb_lcs, &emb_lc->key, emb_lc);
+      }
+      emb_lc->fragments = 0;
+      emb_lc->first_frame = pinfo->fd->num;
+    }
+    else if (!emb_lc || !emb_lc->fragments)
+      return;
+
+    /* B carries the first quarter, E the last */
+    if (lcss == IPSC_EMB_LCSS_SINGLE || burst != emb_lc->fragments + 1 ||
+        (lcss == IPSC_EMB_LCSS_LAST) != (burst == 4))
+    {
+      emb_lc->fragments = 0;
+      return;
+    }
+
+    memcpy(emb_lc->raw + 4 * emb_lc->fragments, voice.data + IPSC_VOICE_OFF_EMBEDDED, 4);
+    if (++emb_lc->fragments < 4)
+      return;
+
+    packet_data->emb_lc = (guint8 *)se_alloc(IPSC_EMB_LC_LEN);
+    packet_data->emb_lc_ok = ipsc_wire_emb_lc_decode(emb_lc->raw, packet_data->emb_lc, &errors);
+    packet_data->emb_lc_errors = (gint8)errors;
+    packet_data->emb_lc_first_frame = emb_lc->first_frame;
+    emb_lc->fragments = 0;
+}
+
+/*
+ * A burst forwarded as sent on the air is decoded here, once, and the
+ * summary, the data reassembly and the tree all read the result.
+ */
+static void
+ipsc_track_raw_burst(tvbuff_t *tvb, ipsc_packet_data_t *packet_data)
+{
+    ipsc_wire_msg_t msg;
+    ipsc_wire_call_t call;
+    const guint8 *raw;
+
+    ipsc_wire_msg_tvb(tvb, &msg);
+    if (!ipsc_wire_call(&msg, &call) || (raw = ipsc_wire_call_raw_burst(&call)) == NULL)
+      return;
+
+    packet_data->burst = (guint8 *)se_alloc(IPSC_BURST_LEN);
+    packet_data->slot_type_errors = (gint16)ipsc_wire_slot_type_decode(raw, &packet_data->slot_type);
+    packet_data->burst_errors = (gint16)ipsc_wire_bptc_decode(raw, packet_data->burst);
+}
+
+/*
+ * Authentication
+ *
+ * Authenticated peers append the first 10 octets of HMAC-SHA1 over the
+ * rest of the packet, keyed with the 20 octet network key. The HMAC
+ * inner state for every configured key is prepared once when the
+ * preferences are applied and copied per packet, so a check costs the
+ * hashing of the packet itself and nothing more. The key that matched
+ * last is remembered per repeater and tried first. Each packet is
+ * checked once, on the first pass, and the result kept with it.
+ */
+#define IPSC_AUTH_KEY_LEN       20
+
+static sha1_hmac_context *ipsc_auth_keys = NULL;
+static guint ipsc_auth_key_count = 0;
+
+static void
+ipsc_auth_prepare_keys(void)
+{
+    gchar **keys;
+    guint8 key[IPSC_AUTH_KEY_LEN];
+    guint i, j, len;
+    gboolean valid;
+
+    g_free(ipsc_auth_keys);
+    ipsc_auth_keys = NULL;
+    ipsc_auth_key_count = 0;
+
+    if (!ipsc_auth_keys_pref || !*ipsc_auth_keys_pref)
+      return;
+
+    keys = g_strsplit(ipsc_auth_keys_pref, ",", 0);
+    ipsc_auth_keys = g_new0(sha1_hmac_context, g_strv_length(keys));
+
+    for (i = 0; keys[i]; i++)
+    {
+      g_strstrip(keys[i]);
+      len = (guint)strlen(keys[i]);
+      if (len == 0 || len > 2 * IPSC_AUTH_KEY_LEN)
+        continue;
+
+      /* Hex string, right aligned as the peers pad short keys with zeros on the left */
+      memset(key, 0, sizeof(key));
+      valid = TRUE;
+      for (j = 0; j < len && valid; j++)
+      {
+        gchar c = keys[i][len - 1 - j];
+
+        valid = g_ascii_isxdigit(c);
+        if (valid)
+          key[IPSC_AUTH_KEY_LEN - 1 - j / 2] |= g_ascii_xdigit_value(c) << ((j & 1) ? 4 : 0);
+      }
+      if (!valid)
+        continue;
+
+      sha1_hmac_starts(&ipsc_auth_keys[ipsc_auth_key_count++], key, IPSC_AUTH_KEY_LEN);
+    }
+
+    g_strfreev(keys);
+}
+
+/*
+ * Returns the index of the key the digest at offset was made with,
+ * or -1 if none of the configured keys matches.
+ */
+static gint
+ipsc_auth_verify(tvbuff_t *tvb, gint offset)
+{
+    const guint8 *data;
+    guint8 digest[SHA1_DIGEST_LEN];
+    sha1_hmac_context ctx;
+    guint32 rpt_id;
+    guint first, i, n;
+
+    data = tvb_get_ptr(tvb, 0, offset + IPSC_AUTH_DIGEST_LEN);
+    rpt_id = (offset >= 5) ? tvb_get_ntohl(tvb, 1) : 0;
+
+    first = GPOINTER_TO_UINT(g_hash_table_lookup(ipsc_auth_peers, GUINT_TO_POINTER(rpt_id)));
+    first = first ? first - 1 : 0;
+
+    for (n = 0; n < ipsc_auth_key_count; n++)
+    {
+      i = (first + n) % ipsc_auth_key_count;
+
+      /* Start from the prepared inner state */
+      ctx = ipsc_auth_keys[i];
+      sha1_hmac_update(&ctx, data, offset);
+      sha1_hmac_finish(&ctx, digest);
+
+      if (memcmp(digest, data + offset, IPSC_AUTH_DIGEST_LEN) == 0)
+      {
+        if (i != first)
+          g_hash_table_insert(ipsc_auth_peers, GUINT_TO_POINTER(rpt_id), GUINT_TO_POINTER(i + 1));
+        return i;
+      }
+    }
+
+    return -1;
+}
+
+/*
+ * Check the digest after the body once, on the first pass, so the tree
+ * and the columns of the later passes cost no hashing at all.
+ */
+static void
+ipsc_track_digest(tvbuff_t *tvb, ipsc_packet_data_t *packet_data)
+{
+    ipsc_wire_msg_t msg;
+    size_t body_len;
+    int exact;
+    gint key;
+
+    if (!ipsc_auth_key_count || packet_data->peer_auth == IPSC_PEER_AUTH_NO)
+      return;
+
+    ipsc_wire_msg_tvb(tvb, &msg);
+    if (!(body_len = ipsc_wire_body_length(&msg, &exact)) || !exact || !ipsc_wire_digest(&msg, body_len))
+      return;
+
+    key = ipsc_auth_verify(tvb, (gint)body_len);
+    packet_data->digest = (key >= 0) ? IPSC_DIGEST_GOOD : IPSC_DIGEST_BAD;
+    packet_data->digest_key = (gint8)key;
+    packet_data->digest_offset = (guint32)body_len;
+}
+
+/*
+ * Talkgroup or private voice call, from the Full LC of the Voice LC
+ * Header or the embedded LC that opens it. Group when there is no LC
+ * to tell, GROUP_VOICE being the opcode.
+ */
+static gboolean
+ipsc_track_call_group(tvbuff_t *tvb, const ipsc_packet_data_t *packet_data)
+{
+    ipsc_wire_msg_t msg;
+    ipsc_wire_call_t call;
+    ipsc_wire_full_lc_t lc;
+    const guint8 *payload;
+    size_t len;
+
+    /* FLCO is in the first octet of both */
+    if (packet_data->emb_lc)
+      lc.data = packet_data->emb_lc;
+    else if (packet_data->burst)
+      lc.data = packet_data->burst;
+    else
+    {
+      ipsc_wire_msg_tvb(tvb, &msg);
+      if (!ipsc_wire_call(&msg, &call) || !(payload = ipsc_wire_call_payload(&call, &len)) ||
+          !ipsc_wire_full_lc(payload, len, &lc))
+        return TRUE;
+    }
+
+    return ipsc_wire_full_lc_flco(&lc) != IPSC_FLCO_UNIT_TO_UNIT_VOICE;
+}
+
+/*
+ * Build the per-packet data on the first pass, just fetch it after that.
+ */
+static ipsc_packet_data_t *
+ipsc_track_call(tvbuff_t *tvb, packet_info *pinfo, const ipsc_info_t *ipsc_info)
+{
+    ipsc_packet_data_t *packet_data;
+    ipsc_call_key_t key;
+    ipsc_call_t *call;
+
+    if (pinfo->fd->flags.visited)
+      return (ipsc_packet_data_t *)p_get_proto_data(pinfo->fd, proto_ipsc);
+
+    packet_data = se_new0(ipsc_packet_data_t);
+    p_add_proto_data(pinfo->fd, proto_ipsc, packet_data);
+
+    ipsc_track_peer(tvb, ipsc_info, packet_data);
+    ipsc_track_digest(tvb, packet_data);
+    ipsc_track_link(pinfo, ipsc_info, packet_data);
+    ipsc_track_peer_list(tvb, pinfo, ipsc_info, packet_data);
+    ipsc_track_xnl(tvb, pinfo, ipsc_info, packet_data);
+    packet_data->peer = (const ipsc_peer_t *)g_hash_table_lookup(ipsc_peer_table, GUINT_TO_POINTER(ipsc_info->rpt_id));
+
+    if (nstime_is_unset(&ipsc_first_time))
+      ipsc_first_time = pinfo->fd->abs_ts;
+
+    if (!ipsc_info->is_call)
+      return packet_data;
+
+    ipsc_track_rssi(pinfo, ipsc_info, packet_data);
+    ipsc_track_raw_burst(tvb, packet_data);
+
+    key.rpt_id = ipsc_info->rpt_id;
+    key.src_id = ipsc_info->src_id;
+    key.dst_id = ipsc_info->dst_id;
+    key.slot = ipsc_info->slot;
+
+    /* Data Header and the blocks that follow it */
+    if (ipsc_info->opcode == 0x83 || ipsc_info->opcode == 0x84)
+    {
+      ipsc_track_data(tvb, pinfo, ipsc_info, &key, packet_data);
+      if (ipsc_info->data_type == IPSC_DATA_TYPE_DATA_HDR && packet_data->data_pdu)
+        packet_data->call_start = TRUE;
+    }
+
+    /* Embedded LC of the voice bursts */
+    if (ipsc_info->opcode == 0x80)
+      ipsc_track_emb_lc(tvb, pinfo, ipsc_info, &key, packet_data);
+
+    call = (ipsc_call_t *)g_hash_table_lookup(ipsc_active_calls, &key);
+
+    /* A call that went quiet is over, even without its Terminator */
+    if (call && pinfo->fd->abs_ts.secs - call->last_time.secs > IPSC_CALL_TIMEOUT)
+    {
+      call->end_frame = call->last_frame;
+      call->end_time = call->last_time;
+      g_hash_table_remove(ipsc_active_calls, &call->key);
+      call = NULL;
+    }
+
+    /* Voice LC Header - a new call, even if the old one was never terminated, but not a repeated header */
+    if (ipsc_info->data_type == IPSC_DATA_TYPE_VOICE_LC_HDR &&
+        (!call || call->last_data_type != IPSC_DATA_TYPE_VOICE_LC_HDR))
+    {
+      if (call)
+        g_hash_table_remove(ipsc_active_calls, &call->key);
+
+      call = se_new0(ipsc_call_t);
+      call->key = key;
+      call->call_id = ++ipsc_call_count;
+      call->start_frame = pinfo->fd->num;
+      call->start_time = pinfo->fd->abs_ts;
+      call->group = ipsc_track_call_group(tvb, packet_data);
+      g_hash_table_insert(ipsc_active_calls, &call->key, call);
+      packet_data->call_start = TRUE;
+    }
+    /* Late entry - the first good embedded LC of a call whose header was missed */
+    else if (!call && packet_data->emb_lc_ok && packet_data->emb_lc_errors >= 0)
+    {
+      call = se_new0(ipsc_call_t);
+      call->key = key;
+      call->call_id = ++ipsc_call_count;
+      call->start_frame = pinfo->fd->num;
+      call->start_time = pinfo->fd->abs_ts;
+      call->late_entry = TRUE;
+      call->group = ipsc_track_call_group(tvb, packet_data);
+      g_hash_table_insert(ipsc_active_calls, &call->key, call);
+      packet_data->call_start = TRUE;
+    }
+
+    if (!call)
+    {
+      /* Data, CSBK and late entry voice are on the air all the same */
+      ipsc_track_airtime(pinfo, ipsc_info, packet_data);
+      return packet_data;
+    }
+
+    packet_data->call = call;
+    packet_data->packet_index = ++call->packet_count;
+    call->last_frame = pinfo->fd->num;
+    call->last_time = pinfo->fd->abs_ts;
+    call->last_data_type = ipsc_info->data_type;
+    ipsc_analyse_stream(pinfo, ipsc_info, &call->stream, packet_data);
+
+    /* Terminator with LC */
+    if (ipsc_info->data_type == 0x02)
+    {
+      call->end_frame = pinfo->fd->num;
+      call->end_time = pinfo->fd->abs_ts;
+      g_hash_table_remove(ipsc_active_calls, &call->key);
+    }
+
+    ipsc_track_airtime(pinfo, ipsc_info, packet_data);
+
+    return packet_data;
+}
+
+static void
+dissect_ipsc_digest(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree, gint offset)
+{
+    proto_item *digest_item = NULL;
+    proto_tree *digest_tree = NULL;
+    proto_item *item = NULL;
+    ipsc_packet_data_t *packet_data;
+    gint key;
+
+    /*
+     * Peers that do not authenticate send no trailer at all. Until the
+     * peer has told us, only take a digest that is actually there.
+     */
+    packet_data = (ipsc_packet_data_t *)p_get_proto_data(pinfo->fd, proto_ipsc);
+    if (packet_data && packet_data->peer_auth == IPSC_PEER_AUTH_NO)
+      return;
+    if ((!packet_data || packet_data->peer_auth == IPSC_PEER_AUTH_UNKNOWN) &&
+        !tvb_bytes_exist(tvb, offset, IPSC_AUTH_DIGEST_LEN))
+      return;
+
+    /* Auth Digest */
+    digest_item = proto_tree_add_item(tree, hf_ipsc_digest_id, tvb, offset, IPSC_AUTH_DIGEST_LEN, ENC_BIG_ENDIAN);
+
+    if (!ipsc_auth_key_count)
+      return;
+
+    digest_tree = proto_item_add_subtree(digest_item, ett_ipsc_digest);
+
+    /* As the first pass found it, unless it looked elsewhere */
+    if (packet_data && packet_data->digest != IPSC_DIGEST_UNCHECKED && packet_data->digest_offset == (guint32)offset)
+      key = (packet_data->digest == IPSC_DIGEST_GOOD) ? packet_data->digest_key : -1;
+    else
+      key = ipsc_auth_verify(tvb, offset);
+
+    if (key >= 0)
+    {
+      proto_item_append_text(digest_item, " [correct]");
+
+      item = proto_tree_add_boolean(digest_tree, hf_ipsc_digest_good_id, tvb, offset, IPSC_AUTH_DIGEST_LEN, TRUE);
+      PROTO_ITEM_SET_GENERATED(item);
+      item = proto_tree_add_boolean(digest_tree, hf_ipsc_digest_bad_id, tvb, offset, IPSC_AUTH_DIGEST_LEN, FALSE);
+      PROTO_ITEM_SET_GENERATED(item);
+      item = proto_tree_add_uint(digest_tree, hf_ipsc_digest_key_id, tvb, offset, IPSC_AUTH_DIGEST_LEN, key + 1);
+      PROTO_ITEM_SET_GENERATED(item);
+    }
+    else
+    {
+      proto_item_append_text(digest_item, " [incorrect]");
+
+      item = proto_tree_add_boolean(digest_tree, hf_ipsc_digest_good_id, tvb, offset, IPSC_AUTH_DIGEST_LEN, FALSE);
+      PROTO_ITEM_SET_GENERATED(item);
+      item = proto_tree_add_boolean(digest_tree, hf_ipsc_digest_bad_id, tvb, offset, IPSC_AUTH_DIGEST_LEN, TRUE);
+      PROTO_ITEM_SET_GENERATED(item);
+      expert_add_info_format(pinfo, item, PI_SECURITY, PI_WARN,
+                             "Auth Digest does not match any configured key");
+    }
+}
+
+/*
+ * Bits a FEC decoder corrected, or a warning on the decoded item if
+ * there were more errors than the code corrects.
+ */
+static void
+dissect_ipsc_fec_corrected(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree, proto_item *code_item,
+                           int hf_index, gint offset, gint length, int errors, const gchar *what)
+{
+    proto_item *item = NULL;
+
+    if (errors < 0)
+    {
+      expert_add_info_format(pinfo, code_item, PI_CHECKSUM, PI_WARN, "Uncorrectable errors in the %s", what);
+      return;
+    }
+
+    item = proto_tree_add_uint(tree, hf_index, tvb, offset, length, errors);
+    PROTO_ITEM_SET_GENERATED(item);
+    if (errors)
+      expert_add_info_format(pinfo, item, PI_CHECKSUM, PI_CHAT, "%d bit(s) corrected in the %s", errors, what);
+}
+
+/*
+ * Burst forwarded as sent on the air, under the Data item: the slot
+ * type through Golay(20,8) and the 96 bits through BPTC(196,96), as
+ * decoded on the first pass. Returns the corrected 96 bits for the
+ * fields that follow, NULL if the payload is not a raw burst.
+ */
+static tvbuff_t *
+dissect_ipsc_raw_burst(tvbuff_t *tvb, packet_info *pinfo, proto_item *data_item)
+{
+    proto_tree *fec_tree = NULL;
+    proto_item *slot_type_item = NULL;
+    proto_tree *slot_type_tree = NULL;
+    proto_item *info_item = NULL;
+    tvbuff_t *burst_tvb = NULL;
+    ipsc_packet_data_t *packet_data;
+    guint8 slot_type;
+
+    packet_data = (ipsc_packet_data_t *)p_get_proto_data(pinfo->fd, proto_ipsc);
+    if (!packet_data || !packet_data->burst)
+      return NULL;
+
+    fec_tree = proto_item_add_subtree(data_item, ett_ipsc_fec);
+
+    /* Slot Type, both halves */
+    slot_type = packet_data->slot_type;
+    slot_type_item = proto_tree_add_uint(fec_tree, hf_ipsc_burst_slot_type_id, tvb, IPSC_CALL_OFF_PAYLOAD + 12, 9, slot_type);
+    PROTO_ITEM_SET_GENERATED(slot_type_item);
+    slot_type_tree = proto_item_add_subtree(slot_type_item, ett_ipsc_fec);
+    proto_tree_add_uint(slot_type_tree, hf_ipsc_burst_slot_type_cc_id, tvb, IPSC_CALL_OFF_PAYLOAD + 12, 9, slot_type);
+    proto_tree_add_uint(slot_type_tree, hf_ipsc_burst_slot_type_data_type_id, tvb, IPSC_CALL_OFF_PAYLOAD + 12, 9, slot_type);
+    dissect_ipsc_fec_corrected(tvb, pinfo, slot_type_tree, slot_type_item, hf_ipsc_burst_slot_type_corrected_id,
+                               IPSC_CALL_OFF_PAYLOAD + 12, 9, packet_data->slot_type_errors, "slot type");
+
+    /* The 96 bits, in their own tvb */
+    burst_tvb = tvb_new_child_real_data(tvb, packet_data->burst, IPSC_BURST_LEN, IPSC_BURST_LEN);
+    add_new_data_source(pinfo, burst_tvb, "BPTC(196,96)");
+
+    info_item = proto_tree_add_item(fec_tree, hf_ipsc_burst_info_id, burst_tvb, 0, IPSC_BURST_LEN, ENC_NA);
+    PROTO_ITEM_SET_GENERATED(info_item);
+    dissect_ipsc_fec_corrected(tvb, pinfo, fec_tree, info_item, hf_ipsc_burst_bptc_corrected_id,
+                               IPSC_CALL_OFF_PAYLOAD, IPSC_RAW_BURST_LEN, packet_data->burst_errors, "BPTC(196,96) burst");
+
+    return burst_tvb;
+}
+
+/*
+ * CRC of a CSBK or Data Header at offset, checked against the mask of
+ * its data type, under the CRC item.
+ */
+static void
+dissect_ipsc_burst_crc(tvbuff_t *tvb, packet_info *pinfo, proto_item *crc_item, gint offset,
+                       guint16 mask, int hf_good, int hf_bad)
+{
+    proto_tree *crc_tree = NULL;
+    proto_item *item = NULL;
+    guint16 crc;
+    guint16 computed;
+
+    crc = tvb_get_ntohs(tvb, offset + IPSC_BURST_LEN - 2);
+    computed = ipsc_wire_burst_crc(tvb_get_ptr(tvb, offset, IPSC_BURST_LEN), mask);
+    crc_tree = proto_item_add_subtree(crc_item, ett_ipsc_crc);
+
+    if (crc == computed)
+    {
+      proto_item_append_text(crc_item, " [correct]");
+
+      item = proto_tree_add_boolean(crc_tree, hf_good, tvb, offset + IPSC_BURST_LEN - 2, 2, TRUE);
+      PROTO_ITEM_SET_GENERATED(item);
+      item = proto_tree_add_boolean(crc_tree, hf_bad, tvb, offset + IPSC_BURST_LEN - 2, 2, FALSE);
+      PROTO_ITEM_SET_GENERATED(item);
+    }
+    else
+    {
+      proto_item_append_text(crc_item, " [incorrect, should be 0x%04x]", computed);
+
+      item = proto_tree_add_boolean(crc_tree, hf_good, tvb, offset + IPSC_BURST_LEN - 2, 2, FALSE);
+      PROTO_ITEM_SET_GENERATED(item);
+      item = proto_tree_add_boolean(crc_tree, hf_bad, tvb, offset + IPSC_BURST_LEN - 2, 2, TRUE);
+      PROTO_ITEM_SET_GENERATED(item);
+      expert_add_info_format(pinfo, item, PI_CHECKSUM, PI_WARN, "Bad %s CRC",
+                             (mask == IPSC_CRC_MASK_CSBK) ? "CSBK" : "Data Header");
+    }
+}
+
+/*
+ * Where this Data Header or block sits in its transfer, and the
+ * reassembled user data on the frame that completed it.
+ */
+static void
+dissect_ipsc_data_reassembly(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree)
+{
+    ipsc_packet_data_t *packet_data;
+    ipsc_data_pdu_t *pdu;
+    proto_item *item = NULL;
+
+    packet_data = (ipsc_packet_data_t *)p_get_proto_data(pinfo->fd, proto_ipsc);
+    if (!packet_data)
+      return;
+
+    if (packet_data->data_flags & IPSC_DATA_ABANDONED)
+      expert_add_info_format(pinfo, NULL, PI_REASSEMBLE, PI_WARN,
+                             "Previous data transfer on this call was incomplete and has been dropped");
+    if (packet_data->data_flags & IPSC_DATA_TABLE_FULL)
+      expert_add_info_format(pinfo, NULL, PI_REASSEMBLE, PI_WARN,
+                             "Too many pending data transfers, this one is not reassembled");
+    if (packet_data->data_flags & IPSC_DATA_RAW_BLOCK)
+      expert_add_info_format(pinfo, NULL, PI_REASSEMBLE, PI_WARN,
+                             "Raw data block could not be decoded, data transfer dropped");
+
+    if (!(pdu = packet_data->data_pdu))
+      return;
+
+    if (packet_data->data_block)
+    {
+      /* Data Block n of Blocks to Follow */
+      item = proto_tree_add_uint(tree, hf_ipsc_data_block_id, tvb, 0, 0, packet_data->data_block);
+      PROTO_ITEM_SET_GENERATED(item);
+      item = proto_tree_add_uint(tree, hf_ipsc_data_blocks_id, tvb, 0, 0, pdu->blocks);
+      PROTO_ITEM_SET_GENERATED(item);
+      item = proto_tree_add_uint(tree, hf_ipsc_data_header_frame_id, tvb, 0, 0, pdu->header_frame);
+      PROTO_ITEM_SET_GENERATED(item);
+    }
+
+    if (!pdu->reassembled_in)
+    {
+      expert_add_info_format(pinfo, NULL, PI_REASSEMBLE, PI_NOTE,
+                             "Data transfer never completed");
+      return;
+    }
+
+    if (pdu->reassembled_in != pinfo->fd->num)
+    {
+      item = proto_tree_add_uint(tree, hf_ipsc_data_reassembled_in_id, tvb, 0, 0, pdu->reassembled_in);
+      PROTO_ITEM_SET_GENERATED(item);
+      return;
+    }
+
+    /* Last block, the message itself is handed on by dissect_ipsc_data_payload() */
+    item = proto_tree_add_uint(tree, hf_ipsc_data_reassembled_length_id, tvb, 0, 0, pdu->len);
+    PROTO_ITEM_SET_GENERATED(item);
+
+    if (pdu->hc_status != IPSC_HC_NONE)
+    {
+      item = proto_tree_add_uint(tree, hf_ipsc_data_hc_status_id, tvb, 0, 0, pdu->hc_status);
+      PROTO_ITEM_SET_GENERATED(item);
+      if (pdu->hc_status != IPSC_HC_OK)
+        expert_add_info_format(pinfo, item, PI_UNDECODED, PI_WARN, "Header decompression failed: %s",
+                               val_to_str_const(pdu->hc_status, valstring_hc_status, "Unknown"));
+    }
+}
+
+/*
+ * Hand a reassembled message to the dissector for its SAP. This runs
+ * with or without a tree, so IP taps and filters see the payload in a
+ * single pass. The tvb is a child over the reassembled buffer, nothing
+ * is copied again.
+ */
+static void
+dissect_ipsc_data_payload(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree,
+                          const ipsc_packet_data_t *packet_data)
+{
+    ipsc_data_pdu_t *pdu;
+    tvbuff_t *reassembled_tvb;
+
+    if (!packet_data || !(pdu = packet_data->data_pdu))
+      return;
+
+    if (pdu->reassembled_in != pinfo->fd->num || !pdu->len)
+      return;
+
+    reassembled_tvb = tvb_new_child_real_data(tvb, pdu->data, pdu->len, pdu->len);
+    add_new_data_source(pinfo, reassembled_tvb, "Reassembled IPSC Data");
+
+    switch (pdu->sap)
+    {
+      /* IP based Packet data */
+      case 0x4:
+        call_dissector(ip_handle, reassembled_tvb, pinfo, tree);
+        break;
+
+      /* TCP/IP and UDP/IP header compression */
+      case 0x2:
+      case 0x3:
+        if (pdu->hc_status == IPSC_HC_OK)
+        {
+          tvbuff_t *ip_tvb;
+
+          /* Uncompressed TYPE_IP needs no second copy */
+          if (pdu->ip_data == pdu->data)
+            ip_tvb = reassembled_tvb;
+          else
+          {
+            ip_tvb = tvb_new_child_real_data(tvb, pdu->ip_data, pdu->ip_len, pdu->ip_len);
+            add_new_data_source(pinfo, ip_tvb, "Decompressed IP Packet");
+          }
+          call_dissector(ip_handle, ip_tvb, pinfo, tree);
+        }
+        else
+          call_dissector(data_handle, reassembled_tvb, pinfo, tree);
+        break;
+
+      default:
+        call_dissector(data_handle, reassembled_tvb, pinfo, tree);
+    }
+}
+
+/*
+ * Generated call fields, added at the end of the GROUP_VOICE and
+ * PVT_DATA trees.
+ */
+static void
+dissect_ipsc_call_info(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree)
+{
+    ipsc_packet_data_t *packet_data;
+    ipsc_call_t *call;
+    proto_item *call_item = NULL;
+    proto_tree *call_tree = NULL;
+    proto_item *analysis_item = NULL;
+    proto_tree *analysis_tree = NULL;
+    proto_item *item = NULL;
+    nstime_t delta;
+
+    packet_data = (ipsc_packet_data_t *)p_get_proto_data(pinfo->fd, proto_ipsc);
+    if (!packet_data || !(call = packet_data->call))
+      return;
+
+    /* Call Id */
+    call_item = proto_tree_add_uint(tree, hf_ipsc_call_id, tvb, 0, 0, call->call_id);
+    PROTO_ITEM_SET_GENERATED(call_item);
+    call_tree = proto_item_add_subtree(call_item, ett_ipsc_call);
+
+    /* Call Start Frame */
+    item = proto_tree_add_uint(call_tree, hf_ipsc_call_start_frame_id, tvb, 0, 0, call->start_frame);
+    PROTO_ITEM_SET_GENERATED(item);
+
+    /* Packet Index */
+    item = proto_tree_add_uint(call_tree, hf_ipsc_call_packet_index_id, tvb, 0, 0, packet_data->packet_index);
+    PROTO_ITEM_SET_GENERATED(item);
+
+    /* Late Entry, the call was picked up from its embedded LC */
+    if (call->late_entry)
+    {
+      item = proto_tree_add_boolean(call_tree, hf_ipsc_call_late_entry_id, tvb, 0, 0, TRUE);
+      PROTO_ITEM_SET_GENERATED(item);
+    }
+
+    /* Time since the call started */
+    nstime_delta(&delta, &pinfo->fd->abs_ts, &call->start_time);
+    item = proto_tree_add_time(call_tree, hf_ipsc_call_time_id, tvb, 0, 0, &delta);
+    PROTO_ITEM_SET_GENERATED(item);
+
+    /* Call End Frame and Duration, once the Terminator has been seen or the call timed out */
+    if (call->end_frame)
+    {
+      item = proto_tree_add_uint(call_tree, hf_ipsc_call_end_frame_id, tvb, 0, 0, call->end_frame);
+      PROTO_ITEM_SET_GENERATED(item);
+
+      nstime_delta(&delta, &call->end_time, &call->start_time);
+      item = proto_tree_add_time(call_tree, hf_ipsc_call_duration_id, tvb, 0, 0, &delta);
+      PROTO_ITEM_SET_GENERATED(item);
+    }
+
+    /* Stream Analysis */
+    analysis_item = proto_tree_add_item(call_tree, hf_ipsc_analysis_id, tvb, 0, 0, ENC_NA);
+    PROTO_ITEM_SET_GENERATED(analysis_item);
+    analysis_tree = proto_item_add_subtree(analysis_item, ett_ipsc_analysis);
+
+    /* Delta and Jitter */
+    item = proto_tree_add_double(analysis_tree, hf_ipsc_analysis_delta_id, tvb, 0, 0, packet_data->delta);
+    PROTO_ITEM_SET_GENERATED(item);
+    item = proto_tree_add_double(analysis_tree, hf_ipsc_analysis_jitter_id, tvb, 0, 0, packet_data->jitter);
+    PROTO_ITEM_SET_GENERATED(item);
+
+    if (packet_data->stream_flags & IPSC_STREAM_SEQ_GAP)
+    {
+      item = proto_tree_add_uint(analysis_tree, hf_ipsc_analysis_lost_id, tvb, IPSC_CALL_OFF_CALL_SEQ_NO, 2, packet_data->lost);
+      PROTO_ITEM_SET_GENERATED(item);
+      expert_add_info_format(pinfo, item, PI_SEQUENCE, PI_WARN,
+                             "%u voice packet(s) lost before Call Seq No %u",
+                             packet_data->lost, tvb_get_ntohs(tvb, IPSC_CALL_OFF_CALL_SEQ_NO));
+    }
+    if (packet_data->stream_flags & IPSC_STREAM_DUPLICATE)
+    {
+      item = proto_tree_add_boolean(analysis_tree, hf_ipsc_analysis_duplicate_id, tvb, IPSC_CALL_OFF_CALL_SEQ_NO, 2, TRUE);
+      PROTO_ITEM_SET_GENERATED(item);
+      expert_add_info_format(pinfo, item, PI_SEQUENCE, PI_NOTE,
+                             "Duplicate Call Seq No %u", tvb_get_ntohs(tvb, IPSC_CALL_OFF_CALL_SEQ_NO));
+    }
+    if (packet_data->stream_flags & IPSC_STREAM_OUT_OF_ORDER)
+    {
+      item = proto_tree_add_boolean(analysis_tree, hf_ipsc_analysis_out_of_order_id, tvb, IPSC_CALL_OFF_CALL_SEQ_NO, 2, TRUE);
+      PROTO_ITEM_SET_GENERATED(item);
+      expert_add_info_format(pinfo, item, PI_SEQUENCE, PI_WARN,
+                             "Out of order Call Seq No %u", tvb_get_ntohs(tvb, IPSC_CALL_OFF_CALL_SEQ_NO));
+    }
+
+    /* Stream totals, complete once the first pass is done */
+    item = proto_tree_add_uint(analysis_tree, hf_ipsc_analysis_stream_received_id, tvb, 0, 0, call->stream.received);
+    PROTO_ITEM_SET_GENERATED(item);
+    item = proto_tree_add_uint(analysis_tree, hf_ipsc_analysis_stream_lost_id, tvb, 0, 0, call->stream.lost);
+    PROTO_ITEM_SET_GENERATED(item);
+    item = proto_tree_add_uint(analysis_tree, hf_ipsc_analysis_stream_duplicates_id, tvb, 0, 0, call->stream.duplicates);
+    PROTO_ITEM_SET_GENERATED(item);
+    item = proto_tree_add_uint(analysis_tree, hf_ipsc_analysis_stream_out_of_order_id, tvb, 0, 0, call->stream.out_of_order);
+    PROTO_ITEM_SET_GENERATED(item);
+    item = proto_tree_add_double(analysis_tree, hf_ipsc_analysis_stream_max_jitter_id, tvb, 0, 0, call->stream.max_jitter);
+    PROTO_ITEM_SET_GENERATED(item);
+}
+
+/*
+ * Airtime accounting for the repeater and timeslot of this frame, added
+ * to the GROUP_VOICE and PVT_DATA trees.
+ */
+static void
+dissect_ipsc_airtime(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree)
+{
+    ipsc_packet_data_t *packet_data;
+    proto_item *airtime_item = NULL;
+    proto_tree *airtime_tree = NULL;
+    proto_item *item = NULL;
+
+    packet_data = (ipsc_packet_data_t *)p_get_proto_data(pinfo->fd, proto_ipsc);
+    if (!packet_data || packet_data->slot_busy == 0)
+      return;
+
+    airtime_item = proto_tree_add_item(tree, hf_ipsc_airtime_id, tvb, 0, 0, ENC_NA);
+    PROTO_ITEM_SET_GENERATED(airtime_item);
+    airtime_tree = proto_item_add_subtree(airtime_item, ett_ipsc_airtime);
+
+    /* Timeslot */
+    item = proto_tree_add_uint(airtime_tree, hf_ipsc_airtime_slot_id, tvb, IPSC_CALL_OFF_CALL_CTRL_INFO, 1,
+                               (tvb_get_guint8(tvb, IPSC_CALL_OFF_CALL_CTRL_INFO) & IPSC_CALL_CTRL_INFO_SLOT2) ? 2 : 1);
+    PROTO_ITEM_SET_GENERATED(item);
+
+    /* Busy Time Added */
+    item = proto_tree_add_double(airtime_tree, hf_ipsc_airtime_added_id, tvb, 0, 0, packet_data->airtime);
+    PROTO_ITEM_SET_GENERATED(item);
+
+    /* Slot totals so far */
+    item = proto_tree_add_double(airtime_tree, hf_ipsc_airtime_slot_busy_id, tvb, 0, 0, packet_data->slot_busy);
+    PROTO_ITEM_SET_GENERATED(item);
+    item = proto_tree_add_double(airtime_tree, hf_ipsc_airtime_slot_utilization_id, tvb, 0, 0, packet_data->slot_utilization);
+    PROTO_ITEM_SET_GENERATED(item);
+    item = proto_tree_add_uint(airtime_tree, hf_ipsc_airtime_slot_calls_id, tvb, 0, 0, packet_data->slot_calls);
+    PROTO_ITEM_SET_GENERATED(item);
+}
+
+/*
+ * RSSI in dBm and the bucket of the repeater, timeslot and radio so
+ * far, added to the GROUP_VOICE and PVT_DATA trees.
+ */
+static void
+dissect_ipsc_rssi(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree)
+{
+    ipsc_packet_data_t *packet_data;
+    ipsc_wire_msg_t msg;
+    ipsc_wire_call_t call;
+    proto_item *rssi_item = NULL;
+    proto_tree *rssi_tree = NULL;
+    proto_item *item = NULL;
+    nstime_t start;
+    int dbm;
+
+    packet_data = (ipsc_packet_data_t *)p_get_proto_data(pinfo->fd, proto_ipsc);
+    ipsc_wire_msg_tvb(tvb, &msg);
+    if (!packet_data || !packet_data->rssi.count || !ipsc_wire_call(&msg, &call) || !ipsc_wire_call_rssi(&call, &dbm))
+      return;
+
+    rssi_item = proto_tree_add_item(tree, hf_ipsc_rssi_id, tvb, 0, 0, ENC_NA);
+    PROTO_ITEM_SET_GENERATED(rssi_item);
+    rssi_tree = proto_item_add_subtree(rssi_item, ett_ipsc_rssi);
+
+    /* RSSI Status and Threshold */
+    item = proto_tree_add_int(rssi_tree, hf_ipsc_rssi_dbm_id, tvb, IPSC_CALL_OFF_RSSI_STATUS, 1, dbm);
+    PROTO_ITEM_SET_GENERATED(item);
+    proto_item_append_text(rssi_item, ": %d dBm", dbm);
+    if (ipsc_wire_call_rssi_threshold(&call, &dbm))
+    {
+      item = proto_tree_add_int(rssi_tree, hf_ipsc_rssi_threshold_dbm_id, tvb, IPSC_CALL_OFF_RSSI_THRESHOLD, 1, dbm);
+      PROTO_ITEM_SET_GENERATED(item);
+    }
+
+    /* Bucket so far */
+    start.secs = (time_t)packet_data->rssi.start;
+    start.nsecs = 0;
+    item = proto_tree_add_time(rssi_tree, hf_ipsc_rssi_interval_start_id, tvb, 0, 0, &start);
+    PROTO_ITEM_SET_GENERATED(item);
+    item = proto_tree_add_uint(rssi_tree, hf_ipsc_rssi_interval_count_id, tvb, 0, 0, packet_data->rssi.count);
+    PROTO_ITEM_SET_GENERATED(item);
+    item = proto_tree_add_int(rssi_tree, hf_ipsc_rssi_interval_min_id, tvb, 0, 0, packet_data->rssi.min);
+    PROTO_ITEM_SET_GENERATED(item);
+    item = proto_tree_add_double(rssi_tree, hf_ipsc_rssi_interval_avg_id, tvb, 0, 0,
+                                 ipsc_wire_rssi_stats_avg(&packet_data->rssi));
+    PROTO_ITEM_SET_GENERATED(item);
+    item = proto_tree_add_int(rssi_tree, hf_ipsc_rssi_interval_max_id, tvb, 0, 0, packet_data->rssi.max);
+    PROTO_ITEM_SET_GENERATED(item);
+}
+
+/*
+ * Request/reply matching of the registration and keepalive messages,
+ * added to their trees.
+ */
+static void
+dissect_ipsc_rr(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree)
+{
+    ipsc_packet_data_t *packet_data;
+    proto_item *item = NULL;
+    guint32 peer;
+
+    packet_data = (ipsc_packet_data_t *)p_get_proto_data(pinfo->fd, proto_ipsc);
+    if (!packet_data)
+      return;
+
+    if (!(tvb_get_guint8(tvb, 0) & 0x01))
+    {
+      /* Request, Response In */
+      if (packet_data->rr_frame)
+      {
+        item = proto_tree_add_uint(tree, hf_ipsc_rr_response_in_id, tvb, 0, 0, packet_data->rr_frame);
+        PROTO_ITEM_SET_GENERATED(item);
+      }
+
+      /* The keepalive before this one got no reply */
+      if (packet_data->rr_unanswered)
+      {
+        item = proto_tree_add_uint(tree, hf_ipsc_rr_unanswered_id, tvb, 0, 0, packet_data->rr_unanswered);
+        PROTO_ITEM_SET_GENERATED(item);
+        item = proto_tree_add_uint(tree, hf_ipsc_rr_missed_id, tvb, 0, 0, packet_data->rr_missed);
+        PROTO_ITEM_SET_GENERATED(item);
+        expert_add_info_format(pinfo, item, PI_SEQUENCE, PI_WARN,
+                               "No reply to the keepalive in frame %u (%u in a row)",
+                               packet_data->rr_unanswered, packet_data->rr_missed);
+      }
+      peer = tvb_get_ntohl(tvb, 1);
+    }
+    else
+    {
+      /* Reply, Response To and Round Trip Time */
+      if (packet_data->rr_frame)
+      {
+        item = proto_tree_add_uint(tree, hf_ipsc_rr_response_to_id, tvb, 0, 0, packet_data->rr_frame);
+        PROTO_ITEM_SET_GENERATED(item);
+        item = proto_tree_add_time(tree, hf_ipsc_rr_time_id, tvb, 0, 0, &packet_data->rr_time);
+        PROTO_ITEM_SET_GENERATED(item);
+      }
+      peer = packet_data->rr_rpt_id;
+    }
+
+    /* Peer Event, about the requester */
+    if (packet_data->peer_event != IPSC_PEER_EVENT_NONE)
+    {
+      item = proto_tree_add_uint(tree, hf_ipsc_rr_peer_event_id, tvb, 0, 0, packet_data->peer_event);
+      PROTO_ITEM_SET_GENERATED(item);
+      if (packet_data->peer_event == IPSC_PEER_EVENT_JOIN)
+        expert_add_info_format(pinfo, item, PI_SEQUENCE, PI_CHAT, "Peer %u joined", peer);
+      else
+        expert_add_info_format(pinfo, item, PI_SEQUENCE, PI_WARN, "Peer %u left", peer);
+    }
+}
+
+/*
+ * What the peer table knows about the Rpt Id of this frame, added at
+ * the end of every IPSC tree.
+ */
+static void
+dissect_ipsc_peer_info(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree)
+{
+    ipsc_packet_data_t *packet_data;
+    const ipsc_peer_t *peer;
+    proto_item *peer_item = NULL;
+    proto_tree *peer_tree = NULL;
+    proto_item *item = NULL;
+
+    packet_data = (ipsc_packet_data_t *)p_get_proto_data(pinfo->fd, proto_ipsc);
+    if (!packet_data || !(peer = packet_data->peer))
+      return;
+
+    peer_item = proto_tree_add_item(tree, hf_ipsc_peer_table_id, tvb, 0, 0, ENC_NA);
+    PROTO_ITEM_SET_GENERATED(peer_item);
+    proto_item_append_text(peer_item, ": %s:%u", ip_to_str((const guint8 *)&peer->ip), peer->port);
+    peer_tree = proto_item_add_subtree(peer_item, ett_ipsc_peer);
+
+    /* IP, Port and Linking as the master lists them */
+    item = proto_tree_add_ipv4(peer_tree, hf_ipsc_peer_table_ip_id, tvb, 0, 0, peer->ip);
+    PROTO_ITEM_SET_GENERATED(item);
+    item = proto_tree_add_uint(peer_tree, hf_ipsc_peer_table_port_id, tvb, 0, 0, peer->port);
+    PROTO_ITEM_SET_GENERATED(item);
+    item = proto_tree_add_uint(peer_tree, hf_ipsc_peer_table_linking_id, tvb, 0, 0, peer->linking);
+    PROTO_ITEM_SET_GENERATED(item);
+
+    /* Where it comes from */
+    item = proto_tree_add_uint(peer_tree, hf_ipsc_peer_table_master_id, tvb, 0, 0, peer->master_id);
+    PROTO_ITEM_SET_GENERATED(item);
+    item = proto_tree_add_uint(peer_tree, hf_ipsc_peer_table_listed_in_id, tvb, 0, 0, peer->listed_in);
+    PROTO_ITEM_SET_GENERATED(item);
+}
+
+/*
+ * Field layouts
+ *
+ * Most of the fixed part of a message is a run of plain big endian
+ * fields. Those are described as {hf, offset, length} tables, sorted
+ * by offset, and added by one walker that checks the bounds once for
+ * the whole run and then reads the values straight out of the packet.
+ * The type of each field is looked up once, at registration.
+ * The bit fields (linking, service flags, data header bytes) still
+ * get their subtrees by hand.
+ */
+typedef struct _ipsc_field_t {
+    int  *hf;
+    gint  offset;
+    gint  length;           /* 1 to 4 octets for the FT_UINT fields */
+    enum ftenum ftype;      /* of *hf, filled in at registration */
+} ipsc_field_t;
+
+/* A whole message: the fields, then the Auth Digest */
+typedef struct _ipsc_layout_t {
+    guint8              opcode;
+    const ipsc_field_t *fields;
+    guint               count;
+} ipsc_layout_t;
+
+/* GROUP_VOICE and PVT_DATA, cut at the count that fits the data type */
+static ipsc_field_t ipsc_call_fields[] = {
+    { &hf_ipsc_type,                         IPSC_OFF_OPCODE,                1 },
+    { &hf_ipsc_rpt_id,                       IPSC_OFF_RPT_ID,                4 },
+    { &hf_ipsc_seq_no_id,                    IPSC_CALL_OFF_SEQ_NO,           1 },
+    { &hf_ipsc_src_id,                       IPSC_CALL_OFF_SRC_ID,           3 },
+    { &hf_ipsc_dst_id,                       IPSC_CALL_OFF_DST_ID,           3 },
+    { &hf_ipsc_prio_v_d_id,                  IPSC_CALL_OFF_PRIO,             1 },
+    { &hf_ipsc_call_ctrl_id,                 IPSC_CALL_OFF_CALL_CTRL,        4 },
+    { &hf_ipsc_call_ctrl_info_id,            IPSC_CALL_OFF_CALL_CTRL_INFO,   1 },
+    { &hf_ipsc_call_ctrl_src_id,             IPSC_CALL_OFF_CALL_CTRL_SRC,    1 },
+    { &hf_ipsc_payload_type_id,              IPSC_CALL_OFF_PAYLOAD_TYPE,     1 },
+    { &hf_ipsc_call_seq_no_id,               IPSC_CALL_OFF_CALL_SEQ_NO,      2 },
+    { &hf_ipsc_timestamp_id,                 IPSC_CALL_OFF_TIMESTAMP,        4 },
+    { &hf_ipsc_sync_src_id,                  IPSC_CALL_OFF_SYNC_SRC,         4 },
+    { &hf_ipsc_data_type_voice_hdr_id,       IPSC_CALL_OFF_DATA_TYPE,        1 },
+    { &hf_ipsc_rssi_threshold_and_parity_id, IPSC_CALL_OFF_RSSI_THRESHOLD,   1 },
+    { &hf_ipsc_length_to_follow_id,          IPSC_CALL_OFF_LENGTH_TO_FOLLOW, 2 },
+    { &hf_ipsc_rssi_status_id,               IPSC_CALL_OFF_RSSI_STATUS,      1 },
+    { &hf_ipsc_slot_type_sync_id,            IPSC_CALL_OFF_SLOT_TYPE_SYNC,   1 },
+    { &hf_ipsc_data_size_id,                 IPSC_CALL_OFF_DATA_SIZE,        2 }
+};
+
+#define IPSC_CALL_HDR_FIELDS    14  /* up to Data Type Voice Hdr, 31 octets */
+#define IPSC_CALL_BURST_FIELDS  16  /* up to Length to Follow, 34 octets */
+#define IPSC_CALL_DATA_FIELDS   19  /* up to Data Size, 38 octets */
+
+static ipsc_field_t ipsc_short_fields[] = {
+    { &hf_ipsc_type,     0, 1 },
+    { &hf_ipsc_rpt_id,   1, 4 }
+};
+
+static ipsc_field_t ipsc_call_ctl_1_fields[] = {
+    { &hf_ipsc_type,     0, 1 },
+    { &hf_ipsc_rpt_id,   1, 4 },
+    { &hf_ipsc_rpt_id,   5, 4 },
+    { &hf_ipsc_unk1_id,  9, 17 }
+};
+
+static ipsc_field_t ipsc_call_ctl_2_fields[] = {
+    { &hf_ipsc_type,     0, 1 },
+    { &hf_ipsc_rpt_id,   1, 4 },
+    { &hf_ipsc_unk1_id,  5, 2 }
+};
+
+static ipsc_field_t ipsc_call_ctl_3_fields[] = {
+    { &hf_ipsc_type,     0, 1 },
+    { &hf_ipsc_rpt_id,   1, 4 },
+    { &hf_ipsc_unk1_id,  5, 1 }
+};
+
+static ipsc_field_t ipsc_xcmp_xnl_fields[] = {
+    { &hf_ipsc_type,                0, 1 },
+    { &hf_ipsc_rpt_id,              1, 4 },
+    { &hf_ipsc_xcmp_xnl_length_id,  5, 2 }
+};
+
+/* Opcodes that are nothing but a layout; a new one only needs a line here */
+static const ipsc_layout_t ipsc_layouts[] = {
+    { 0x61, ipsc_call_ctl_1_fields, array_length(ipsc_call_ctl_1_fields) },
+    { 0x62, ipsc_call_ctl_2_fields, array_length(ipsc_call_ctl_2_fields) },
+    { 0x63, ipsc_call_ctl_3_fields, array_length(ipsc_call_ctl_3_fields) },
+    { 0x92, ipsc_short_fields,      array_length(ipsc_short_fields) },
+    { 0x9a, ipsc_short_fields,      array_length(ipsc_short_fields) },
+    { 0x9b, ipsc_short_fields,      array_length(ipsc_short_fields) }
+};
+
+/* Direct index on the opcode, filled in at registration */
+static const ipsc_layout_t *ipsc_layout_by_opcode[256];
+
+/*
+ * CSBK, octets 2 to 9 by Feature Set Id and CSBKO, ETSI TS 102 361-2
+ * 7.1.1 and TS 102 361-4 7.1.1 for the channel grants. The Motorola
+ * ones are only named, their layout is not public. Offsets are from
+ * the start of the CSBK.
+ */
+typedef struct _ipsc_csbk_type_t {
+    guint8              fid;
+    guint8              csbko;
+    const gchar        *name;
+    const ipsc_field_t *fields;
+    guint               count;
+} ipsc_csbk_type_t;
+
+static const ipsc_field_t ipsc_csbk_unknown_fields[] = {
+    { &hf_ipsc_csbk_hdr_byte3_id,       2, 1 },
+    { &hf_ipsc_csbk_hdr_byte4_id,       3, 1 },
+    { &hf_ipsc_csbk_hdr_dst_id,         4, 3 },
+    { &hf_ipsc_csbk_hdr_src_id,         7, 3 }
+};
+
+static const ipsc_field_t ipsc_csbk_uu_req_fields[] = {
+    { &hf_ipsc_csbk_service_options_id, 2, 1 },
+    { &hf_ipsc_csbk_emergency_id,       2, 1 },
+    { &hf_ipsc_csbk_privacy_id,         2, 1 },
+    { &hf_ipsc_csbk_broadcast_id,       2, 1 },
+    { &hf_ipsc_csbk_ovcm_id,            2, 1 },
+    { &hf_ipsc_csbk_priority_id,        2, 1 },
+    { &hf_ipsc_csbk_hdr_dst_id,         4, 3 },
+    { &hf_ipsc_csbk_hdr_src_id,         7, 3 }
+};
+
+static const ipsc_field_t ipsc_csbk_uu_ans_fields[] = {
+    { &hf_ipsc_csbk_service_options_id, 2, 1 },
+    { &hf_ipsc_csbk_emergency_id,       2, 1 },
+    { &hf_ipsc_csbk_privacy_id,         2, 1 },
+    { &hf_ipsc_csbk_broadcast_id,       2, 1 },
+    { &hf_ipsc_csbk_ovcm_id,            2, 1 },
+    { &hf_ipsc_csbk_priority_id,        2, 1 },
+    { &hf_ipsc_csbk_answer_id,          3, 1 },
+    { &hf_ipsc_csbk_hdr_dst_id,         4, 3 },
+    { &hf_ipsc_csbk_hdr_src_id,         7, 3 }
+};
+
+static const ipsc_field_t ipsc_csbk_nack_fields[] = {
+    { &hf_ipsc_csbk_nack_info_id,       2, 1 },
+    { &hf_ipsc_csbk_nack_source_id,     2, 1 },
+    { &hf_ipsc_csbk_nack_service_id,    2, 1 },
+    { &hf_ipsc_csbk_nack_reason_id,     3, 1 },
+    { &hf_ipsc_csbk_hdr_dst_id,         4, 3 },
+    { &hf_ipsc_csbk_hdr_src_id,         7, 3 }
+};
+
+static const ipsc_field_t ipsc_csbk_addresses_fields[] = {
+    { &hf_ipsc_csbk_hdr_dst_id,         4, 3 },
+    { &hf_ipsc_csbk_hdr_src_id,         7, 3 }
+};
+
+static const ipsc_field_t ipsc_csbk_preamble_fields[] = {
+    { &hf_ipsc_csbk_preamble_data_id,   2, 1 },
+    { &hf_ipsc_csbk_preamble_group_id,  2, 1 },
+    { &hf_ipsc_csbk_preamble_blocks_id, 3, 1 },
+    { &hf_ipsc_csbk_hdr_dst_id,         4, 3 },
+    { &hf_ipsc_csbk_hdr_src_id,         7, 3 }
+};
+
+static const ipsc_field_t ipsc_csbk_grant_fields[] = {
+    { &hf_ipsc_csbk_grant_channel_id,   2, 2 },
+    { &hf_ipsc_csbk_grant_slot_id,      3, 1 },
+    { &hf_ipsc_csbk_grant_late_entry_id, 3, 1 },
+    { &hf_ipsc_csbk_grant_emergency_id, 3, 1 },
+    { &hf_ipsc_csbk_grant_offset_id,    3, 1 },
+    { &hf_ipsc_csbk_hdr_dst_id,         4, 3 },
+    { &hf_ipsc_csbk_hdr_src_id,         7, 3 }
+};
+
+static const ipsc_field_t ipsc_csbk_raw_fields[] = {
+    { &hf_ipsc_csbk_data_id,            2, 8 }
+};
+
+#define IPSC_CSBK_FIELDS(f)     f, array_length(f)
+
+/* A new CSBK only needs a line here */
+static const ipsc_csbk_type_t ipsc_csbk_types[] = {
+    { IPSC_CSBK_FID_STANDARD,     0x04, "UU_V_Req",             IPSC_CSBK_FIELDS(ipsc_csbk_uu_req_fields) },
+    { IPSC_CSBK_FID_STANDARD,     0x05, "UU_Ans_Rsp",           IPSC_CSBK_FIELDS(ipsc_csbk_uu_ans_fields) },
+    { IPSC_CSBK_FID_STANDARD,     0x07, "CT_CSBK",              IPSC_CSBK_FIELDS(ipsc_csbk_raw_fields) },
+    { IPSC_CSBK_FID_STANDARD,     0x26, "NACK_Rsp",             IPSC_CSBK_FIELDS(ipsc_csbk_nack_fields) },
+    { IPSC_CSBK_FID_STANDARD,     0x30, "PV_GRANT",             IPSC_CSBK_FIELDS(ipsc_csbk_grant_fields) },
+    { IPSC_CSBK_FID_STANDARD,     0x31, "TV_GRANT",             IPSC_CSBK_FIELDS(ipsc_csbk_grant_fields) },
+    { IPSC_CSBK_FID_STANDARD,     0x32, "BTV_GRANT",            IPSC_CSBK_FIELDS(ipsc_csbk_grant_fields) },
+    { IPSC_CSBK_FID_STANDARD,     0x33, "PD_GRANT",             IPSC_CSBK_FIELDS(ipsc_csbk_grant_fields) },
+    { IPSC_CSBK_FID_STANDARD,     0x34, "TD_GRANT",             IPSC_CSBK_FIELDS(ipsc_csbk_grant_fields) },
+    { IPSC_CSBK_FID_STANDARD,     0x38, "BS_Dwn_Act",           IPSC_CSBK_FIELDS(ipsc_csbk_addresses_fields) },
+    { IPSC_CSBK_FID_STANDARD,     0x3d, "Preamble",             IPSC_CSBK_FIELDS(ipsc_csbk_preamble_fields) },
+    { IPSC_CSBK_FID_CONNECT_PLUS, 0x01, "Connect Plus Neighbors",             IPSC_CSBK_FIELDS(ipsc_csbk_raw_fields) },
+    { IPSC_CSBK_FID_CONNECT_PLUS, 0x03, "Connect Plus Voice Channel Grant",   IPSC_CSBK_FIELDS(ipsc_csbk_raw_fields) },
+    { IPSC_CSBK_FID_CONNECT_PLUS, 0x06, "Connect Plus Data Channel Grant",    IPSC_CSBK_FIELDS(ipsc_csbk_raw_fields) },
+    { IPSC_CSBK_FID_CONNECT_PLUS, 0x0c, "Connect Plus Terminate Channel Grant", IPSC_CSBK_FIELDS(ipsc_csbk_raw_fields) },
+    { IPSC_CSBK_FID_MOTOROLA,     0x3b, "Capacity Plus Neighbors",            IPSC_CSBK_FIELDS(ipsc_csbk_raw_fields) },
+    { IPSC_CSBK_FID_MOTOROLA,     0x3e, "Capacity Plus Channel Status",       IPSC_CSBK_FIELDS(ipsc_csbk_raw_fields) }
+};
+
+#define IPSC_CSBK_FID_SETS      3   /* standard, Connect Plus, Motorola */
+
+/* Direct index on the CSBKO per Feature Set Id, filled in at registration */
+static const ipsc_csbk_type_t *ipsc_csbk_by_opcode[IPSC_CSBK_FID_SETS][64];
+
+/* Row of ipsc_csbk_by_opcode for a Feature Set Id, -1 if it has none */
+static gint
+ipsc_csbk_fid_set(guint8 fid)
+{
+    switch (fid)
+    {
+      case IPSC_CSBK_FID_STANDARD:
+        return 0;
+      case IPSC_CSBK_FID_CONNECT_PLUS:
+        return 1;
+      case IPSC_CSBK_FID_MOTOROLA:
+        return 2;
+      default:
+        return -1;
+    }
+}
+
+static const ipsc_csbk_type_t *
+ipsc_csbk_lookup(guint8 fid, guint8 csbko)
+{
+    gint set = ipsc_csbk_fid_set(fid);
+
+    return (set < 0) ? NULL : ipsc_csbk_by_opcode[set][csbko & 0x3f];
+}
+
+/*
+ * CSBK at offset, under the Data item: LB, PF and CSBKO, FID, the
+ * octets of its type and the CRC.
+ */
+static void
+dissect_ipsc_csbk(tvbuff_t *tvb, packet_info *pinfo, proto_item *data_item, gint offset)
+{
+    proto_tree *csbk_tree = NULL;
+    proto_item *byte1_item = NULL;
+    proto_tree *byte1_tree = NULL;
+    proto_item *crc_item = NULL;
+    const ipsc_csbk_type_t *type;
+    const ipsc_field_t *fields;
+    guint count, i;
+
+    type = ipsc_csbk_lookup(tvb_get_guint8(tvb, offset + 1), tvb_get_guint8(tvb, offset));
+    if (type)
+    {
+      fields = type->fields;
+      count = type->count;
+      proto_item_append_text(data_item, ", CSBK %s", type->name);
+    }
+    else
+    {
+      fields = ipsc_csbk_unknown_fields;
+      count = array_length(ipsc_csbk_unknown_fields);
+    }
+
+    csbk_tree = proto_item_add_subtree(data_item, ett_ipsc);
+
+    /* CSBK Hdr Byte 1 */
+    byte1_item = proto_tree_add_item(csbk_tree, hf_ipsc_csbk_hdr_byte1_id, tvb, offset, 1, ENC_BIG_ENDIAN);
+    byte1_tree = proto_item_add_subtree(byte1_item, ett_ipsc);
+    /* Byte 1 LB, PF and CSBKO */
+    proto_tree_add_item(byte1_tree, hf_ipsc_csbk_lb_id, tvb, offset, 1, ENC_BIG_ENDIAN);
+    proto_tree_add_item(byte1_tree, hf_ipsc_csbk_pf_id, tvb, offset, 1, ENC_BIG_ENDIAN);
+    proto_tree_add_item(byte1_tree, hf_ipsc_csbk_opcode_id, tvb, offset, 1, ENC_BIG_ENDIAN);
+    if (type)
+      proto_item_append_text(byte1_item, " (%s)", type->name);
+
+    /* CSBK Hdr FID */
+    proto_tree_add_item(csbk_tree, hf_ipsc_csbk_hdr_fid_id, tvb, offset + 1, 1, ENC_BIG_ENDIAN);
+
+    /* Octets 2 to 9 as the CSBKO has them */
+    for (i = 0; i < count; i++)
+      proto_tree_add_item(csbk_tree, *fields[i].hf, tvb, offset + fields[i].offset, fields[i].length, ENC_BIG_ENDIAN);
+
+    /* CSBK CRC */
+    crc_item = proto_tree_add_item(csbk_tree, hf_ipsc_csbk_hdr_crc_id, tvb, offset + 10, 2, ENC_BIG_ENDIAN);
+    dissect_ipsc_burst_crc(tvb, pinfo, crc_item, offset, IPSC_CRC_MASK_CSBK,
+                           hf_ipsc_csbk_hdr_crc_good_id, hf_ipsc_csbk_hdr_crc_bad_id);
+}
+
+/* The type of every field of a table, once the fields are registered */
+static void
+ipsc_fields_register(ipsc_field_t *fields, guint count)
+{
+    guint i;
+
+    for (i = 0; i < count; i++)
+      fields[i].ftype = proto_registrar_get_ftype(*fields[i].hf);
+}
+
+/* Octets covered by the first count fields */
+static gint
+ipsc_fields_length(const ipsc_field_t *fields, guint count)
+{
+    return fields[count - 1].offset + fields[count - 1].length;
+}
+
+/* Add the first count fields, returns the offset just past them */
+static gint
+dissect_ipsc_fields(tvbuff_t *tvb, proto_tree *tree, const ipsc_field_t *fields, guint count)
+{
+    gint length = ipsc_fields_length(fields, count);
+    const guint8 *ptr;
+    guint i;
+
+    /* The only bounds check, throws like the per field checks would */
+    ptr = tvb_get_ptr(tvb, 0, length);
+
+    for (i = 0; i < count; i++)
+    {
+      const ipsc_field_t *field = &fields[i];
+      const guint8 *p = ptr + field->offset;
+      guint32 value;
+
+      /* Integers straight from the packet, anything else the usual way */
+      switch (field->ftype)
+      {
+        case FT_UINT8:
+        case FT_UINT16:
+        case FT_UINT24:
+        case FT_UINT32:
+          switch (field->length)
+          {
+            case 1:  value = *p;          break;
+            case 2:  value = pntohs(p);   break;
+            case 3:  value = pntoh24(p);  break;
+            default: value = pntohl(p);   break;
+          }
+          proto_tree_add_uint(tree, *field->hf, tvb, field->offset, field->length, value);
+          break;
+        case FT_BYTES:
+          proto_tree_add_bytes(tree, *field->hf, tvb, field->offset, field->length, p);
+          break;
+        default:
+          proto_tree_add_item(tree, *field->hf, tvb, field->offset, field->length, ENC_BIG_ENDIAN);
+      }
+    }
+
+    return length;
+}
+
+static void
+dissect_ipsc_layout(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree, const ipsc_layout_t *layout)
+{
+    proto_item *ipsc_item = NULL;
+    proto_tree *ipsc_tree = NULL;
+
+    gint offset;
+
+    ipsc_item = proto_tree_add_item(tree, proto_ipsc, tvb, 0, -1, ENC_NA);
+    ipsc_tree = proto_item_add_subtree(ipsc_item, ett_ipsc);
+
+    /* Fields */
+    offset = dissect_ipsc_fields(tvb, ipsc_tree, layout->fields, layout->count);
+
+    /* Auth Digest */
+    dissect_ipsc_digest(tvb, pinfo, ipsc_tree, offset);
+    /* Request/reply matching, PEER_LIST and DE_REG */
+    if (layout->opcode >= 0x90)
+      dissect_ipsc_rr(tvb, pinfo, ipsc_tree);
+
+    /* Peer table */
+    dissect_ipsc_peer_info(tvb, pinfo, ipsc_tree);
+}
+
+void
+dissect_PVT_DATA(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree)
+{
+    proto_item *ipsc_item = NULL;
+    proto_tree *ipsc_tree = NULL;
+
+    guint16 length_to_follow = 0;
+
+    ipsc_item = proto_tree_add_item(tree, proto_ipsc, tvb, 0, -1, ENC_NA);
+    ipsc_tree = proto_item_add_subtree(ipsc_item, ett_ipsc);
+
+    /* Call header, RSSI Threshold and Parity, Length to Follow */
+    dissect_ipsc_fields(tvb, ipsc_tree, ipsc_call_fields, IPSC_CALL_BURST_FIELDS);
+
+    /* 
+     * Decide how the rest of data looks like
+     * based on length_to_follow
+     */
+    if ((length_to_follow = tvb_get_ntohs(tvb, IPSC_CALL_OFF_LENGTH_TO_FOLLOW)) != 0)
+    {
+
+      proto_item *ipsc_data_item = NULL;
+      proto_tree *ipsc_data_tree = NULL;
+      proto_item *crc_item = NULL;
+      tvbuff_t *burst_tvb = tvb;
+      tvbuff_t *raw_tvb = NULL;
+      gint burst_offset = IPSC_CALL_OFF_PAYLOAD;
+      /* Length to Follow counts RSSI Status, Slot Type Sync and Data Size as well */
+      gint payload_len = 2 * length_to_follow - (IPSC_CALL_DATA_LEN - IPSC_CALL_BURST_LEN);
+
+      guint data_type = 0;
+
+      /* RSSI Status, Slot Type Sync, Data Size - in words of 2bytes */
+      dissect_ipsc_fields(tvb, ipsc_tree, ipsc_call_fields + IPSC_CALL_BURST_FIELDS,
+                          IPSC_CALL_DATA_FIELDS - IPSC_CALL_BURST_FIELDS);
+      /* Data */
+      ipsc_data_item = proto_tree_add_item(ipsc_tree, hf_ipsc_data_id, tvb, IPSC_CALL_OFF_PAYLOAD, payload_len, ENC_BIG_ENDIAN);
+      /* Get Data Type */
+      data_type = tvb_get_guint8(tvb, IPSC_CALL_OFF_DATA_TYPE) & 0x0f;
+      /* Raw burst, the header is in its corrected bits */
+      if ((raw_tvb = dissect_ipsc_raw_burst(tvb, pinfo, ipsc_data_item)) != NULL)
+      {
+        burst_tvb = raw_tvb;
+        burst_offset = 0;
+      }
+
+      /* Header based on Data Type */
+      switch (data_type)
+      {
+        /* Data Type is CSBK header */
+        case IPSC_DATA_TYPE_CSBK:
+          dissect_ipsc_csbk(burst_tvb, pinfo, ipsc_data_item, burst_offset);
+          break;
+
+        /* If Data Type is Data Header */
+        case IPSC_DATA_TYPE_DATA_HDR:
+        {
+          proto_item *byte1_item = NULL;
+          proto_tree *byte1_tree = NULL;
+          proto_item *byte2_item = NULL;
+          proto_tree *byte2_tree = NULL;
+          proto_item *byte8_item = NULL;
+          proto_tree *byte8_tree = NULL;
+          proto_item *byte9_item = NULL;
+          proto_tree *byte9_tree = NULL;
+
+          /* Add subtree for Data Header */
+          ipsc_data_tree = proto_item_add_subtree(ipsc_data_item, ett_ipsc);
+
+          /* Data Hdr Byte 1 */
+          byte1_item = proto_tree_add_item(ipsc_data_tree, hf_ipsc_data_hdr_byte1_id, burst_tvb, burst_offset, 1, ENC_BIG_ENDIAN);
+          /* Add subtree for Byte 1 */
+          byte1_tree = proto_item_add_subtree(byte1_item, ett_ipsc);
+          /* Byte 1 G/I */
+          proto_tree_add_item(byte1_tree, hf_ipsc_data_hdr_byte1_gi_id, burst_tvb, burst_offset, 1, ENC_BIG_ENDIAN);
+          /* Byte 1 A */
+          proto_tree_add_item(byte1_tree, hf_ipsc_data_hdr_byte1_a_id, burst_tvb, burst_offset, 1, ENC_BIG_ENDIAN);
+          /* Byte 1 HC */
+          proto_tree_add_item(byte1_tree, hf_ipsc_data_hdr_byte1_hc_id, burst_tvb, burst_offset, 1, ENC_BIG_ENDIAN);
+          /* Byte 1 POCMSB */
+          proto_tree_add_item(byte1_tree, hf_ipsc_data_hdr_byte1_pocmsb_id, burst_tvb, burst_offset, 1, ENC_BIG_ENDIAN);
+          /* Byte 1 DPF */
+          proto_tree_add_item(byte1_tree, hf_ipsc_data_hdr_byte1_dpf_id, burst_tvb, burst_offset, 1, ENC_BIG_ENDIAN);
+
+          /* Data Hdr Byte 2 */
+          byte2_item = proto_tree_add_item(ipsc_data_tree, hf_ipsc_data_hdr_byte2_id, burst_tvb, burst_offset + 1, 1, ENC_BIG_ENDIAN);
+          /* Add subtree for Byte 2 */
+          byte2_tree = proto_item_add_subtree(byte2_item, ett_ipsc);
+          /* Byte 2 SAP */
+          proto_tree_add_item(byte2_tree, hf_ipsc_data_hdr_byte2_sap_id, burst_tvb, burst_offset + 1, 1, ENC_BIG_ENDIAN);
+          /* Byte 2 POC */
+          proto_tree_add_item(byte2_tree, hf_ipsc_data_hdr_byte2_poc_id, burst_tvb, burst_offset + 1, 1, ENC_BIG_ENDIAN);
+
+          /* Data Hdr Dst */
+          proto_tree_add_item(ipsc_data_tree, hf_ipsc_data_hdr_dst_id, burst_tvb, burst_offset + 2, 3, ENC_BIG_ENDIAN);
+          /* Data Hdr Src */
+          proto_tree_add_item(ipsc_data_tree, hf_ipsc_data_hdr_src_id, burst_tvb, burst_offset + 5, 3, ENC_BIG_ENDIAN);
+
+          /* Data Hdr Byte 8 */
+          byte8_item = proto_tree_add_item(ipsc_data_tree, hf_ipsc_data_hdr_byte8_id, burst_tvb, burst_offset + 8, 1, ENC_BIG_ENDIAN);
+          /* Add tree for Byte 8 */
+          byte8_tree = proto_item_add_subtree(byte8_item, ett_ipsc);
+          /* Byte 8 F */
+          proto_tree_add_item(byte8_tree, hf_ipsc_data_hdr_byte8_f_id, burst_tvb, burst_offset + 8, 1, ENC_BIG_ENDIAN);
+          /* Byte 8 BTF */
+          proto_tree_add_item(byte8_tree, hf_ipsc_data_hdr_byte8_btf_id, burst_tvb, burst_offset + 8, 1, ENC_BIG_ENDIAN);
+
+          /* Data Hdr Byte 9 */
+          byte9_item = proto_tree_add_item(ipsc_data_tree, hf_ipsc_data_hdr_byte9_id, burst_tvb, burst_offset + 9, 1, ENC_BIG_ENDIAN);
+          /* Add tree for Byte 9 */
+          byte9_tree = proto_item_add_subtree(byte9_item, ett_ipsc);
+
+          /* If Confirmed header */
+          if (tvb_get_guint8(burst_tvb, burst_offset) & 0x40)
+          {
+            /* Byte 9 S */
+            proto_tree_add_item(byte9_tree, hf_ipsc_data_hdr_byte9_s_id, burst_tvb, burst_offset + 9, 1, ENC_BIG_ENDIAN);
+            /* Byte 9 N(S) */
+            proto_tree_add_item(byte9_tree, hf_ipsc_data_hdr_byte9_ns_id, burst_tvb, burst_offset + 9, 1, ENC_BIG_ENDIAN);
+          }
+          else
+          {
+            /* Add data in the first nibble */
+            proto_tree_add_item(byte9_tree, hf_ipsc_data_hdr_byte9_nibble1_id, burst_tvb, burst_offset + 9, 1, ENC_BIG_ENDIAN);
+          }
+
+          /* Byte 9 FSN */
+          proto_tree_add_item(byte9_tree, hf_ipsc_data_hdr_byte9_fsn_id, burst_tvb, burst_offset + 9, 1, ENC_BIG_ENDIAN);
+
+          /* Data Hdr CRC */
+          crc_item = proto_tree_add_item(ipsc_data_tree, hf_ipsc_data_hdr_crc_id, burst_tvb, burst_offset + 10, 2, ENC_BIG_ENDIAN);
+          dissect_ipsc_burst_crc(burst_tvb, pinfo, crc_item, burst_offset, IPSC_CRC_MASK_DATA_HDR,
+                                 hf_ipsc_data_hdr_crc_good_id, hf_ipsc_data_hdr_crc_bad_id);
+
+          /* The blocks that follow are reassembled by dissect_ipsc_data_reassembly() */
+
+        }; break;
+
+        default:
+          break;
+      }
+
+      /* Data Header and data blocks */
+      dissect_ipsc_data_reassembly(tvb, pinfo, ipsc_tree);
+
+      /* Auth Digest */
+      dissect_ipsc_digest(tvb, pinfo, ipsc_tree, IPSC_CALL_OFF_PAYLOAD + payload_len);
+    }
+    else
+    {
+      /* Auth Digest */
+      dissect_ipsc_digest(tvb, pinfo, ipsc_tree, IPSC_CALL_BURST_LEN);
+    }
+
+    /* Call tracking */
+    dissect_ipsc_call_info(tvb, pinfo, ipsc_tree);
+
+    /* Airtime */
+    dissect_ipsc_airtime(tvb, pinfo, ipsc_tree);
+
+    /* RSSI */
+    dissect_ipsc_rssi(tvb, pinfo, ipsc_tree);
+
+    /* Peer table */
+    dissect_ipsc_peer_info(tvb, pinfo, ipsc_tree);
+}
+
+/*
+ * Embedded LC completed by this burst, in its own tvb: the same fields
+ * as the Full LC of the Voice LC Header, and how its checksum went.
+ */
+static void
+dissect_ipsc_emb_lc(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree, gint offset)
+{
+    ipsc_packet_data_t *packet_data;
+    tvbuff_t *lc_tvb = NULL;
+    proto_item *lc_item = NULL;
+    proto_tree *lc_tree = NULL;
+    proto_item *item = NULL;
+
+    packet_data = (ipsc_packet_data_t *)p_get_proto_data(pinfo->fd, proto_ipsc);
+    if (!packet_data || !packet_data->emb_lc)
+      return;
+
+    lc_tvb = tvb_new_child_real_data(tvb, packet_data->emb_lc, IPSC_EMB_LC_LEN, IPSC_EMB_LC_LEN);
+    add_new_data_source(pinfo, lc_tvb, "Embedded LC");
+
+    /* Embedded LC */
+    lc_item = proto_tree_add_item(tree, hf_ipsc_emb_lc_id, lc_tvb, 0, IPSC_EMB_LC_LEN, ENC_NA);
+    PROTO_ITEM_SET_GENERATED(lc_item);
+    lc_tree = proto_item_add_subtree(lc_item, ett_ipsc_voice);
+
+    /* Byte 1, FID, Service Options, Dst and Src */
+    proto_tree_add_item(lc_tree, hf_ipsc_full_lc_byte1_id, lc_tvb, 0, 1, ENC_BIG_ENDIAN);
+    proto_tree_add_item(lc_tree, hf_ipsc_full_lc_fid_id, lc_tvb, 1, 1, ENC_BIG_ENDIAN);
+    proto_tree_add_item(lc_tree, hf_ipsc_voice_pdu_service_options_id, lc_tvb, 2, 1, ENC_BIG_ENDIAN);
+    proto_tree_add_item(lc_tree, hf_ipsc_voice_pdu_dst_id, lc_tvb, 3, 3, ENC_BIG_ENDIAN);
+    proto_tree_add_item(lc_tree, hf_ipsc_voice_pdu_src_id, lc_tvb, 6, 3, ENC_BIG_ENDIAN);
+
+    /* Checksum */
+    item = proto_tree_add_boolean(lc_tree, hf_ipsc_emb_lc_checksum_good_id, tvb, offset, 4, packet_data->emb_lc_ok);
+    PROTO_ITEM_SET_GENERATED(item);
+    item = proto_tree_add_boolean(lc_tree, hf_ipsc_emb_lc_checksum_bad_id, tvb, offset, 4, !packet_data->emb_lc_ok);
+    PROTO_ITEM_SET_GENERATED(item);
+    if (!packet_data->emb_lc_ok)
+      expert_add_info_format(pinfo, item, PI_CHECKSUM, PI_WARN, "Bad Embedded LC checksum");
+
+    /* Hamming(16,11,4) rows and column parity */
+    dissect_ipsc_fec_corrected(tvb, pinfo, lc_tree, lc_item, hf_ipsc_emb_lc_corrected_id,
+                               offset, 4, packet_data->emb_lc_errors, "embedded LC");
+
+    /* First fragment */
+    item = proto_tree_add_uint(lc_tree, hf_ipsc_emb_lc_first_frame_id, tvb, 0, 0, packet_data->emb_lc_first_frame);
+    PROTO_ITEM_SET_GENERATED(item);
+}
+
+/*
+ * Voice burst under the Data item of a Rate 1 GROUP_VOICE: position in
+ * the superframe, the three AMBE+2 frames and, in B to E, the EMB and
+ * embedded signalling. All at fixed offsets in the frame tvb.
+ */
+static void
+dissect_ipsc_voice(tvbuff_t *tvb, packet_info *pinfo, proto_item *data_item)
+{
+    proto_tree *voice_tree = NULL;
+    proto_item *emb_item = NULL;
+    proto_tree *emb_tree = NULL;
+    proto_item *item = NULL;
+    ipsc_wire_msg_t msg;
+    ipsc_wire_call_t call;
+    ipsc_wire_voice_t voice;
+    guint16 emb;
+    gint offset;
+    guint i;
+    int errors;
+
+    ipsc_wire_msg_tvb(tvb, &msg);
+    if (!ipsc_wire_call(&msg, &call) || !ipsc_wire_voice(&call, &voice))
+      return;
+
+    offset = IPSC_CALL_OFF_PAYLOAD2;
+    proto_item_append_text(data_item, ", Voice Burst %c", 'A' + ipsc_wire_voice_burst(&voice));
+    voice_tree = proto_item_add_subtree(data_item, ett_ipsc_voice);
+
+    /* Burst position in the superframe */
+    proto_tree_add_item(voice_tree, hf_ipsc_voice_burst_id, tvb, offset + IPSC_VOICE_OFF_BURST, 1, ENC_BIG_ENDIAN);
+
+    /* AMBE+2 frames */
+    for (i = 0; i < IPSC_VOICE_AMBE_FRAMES; i++)
+    {
+      item = proto_tree_add_item(voice_tree, hf_ipsc_voice_ambe_id, tvb,
+                                 offset + IPSC_VOICE_OFF_AMBE + i * IPSC_VOICE_AMBE_FRAME_LEN,
+                                 IPSC_VOICE_AMBE_FRAME_LEN, ENC_NA);
+      proto_item_prepend_text(item, "%u ", i + 1);
+    }
+
+    if (!ipsc_wire_voice_has_emb(&voice))
+      return;
+
+    /* EMB: Colour Code, PI, LCSS and QR parity */
+    emb_item = proto_tree_add_item(voice_tree, hf_ipsc_voice_emb_id, tvb, offset + IPSC_VOICE_OFF_EMB, 2, ENC_BIG_ENDIAN);
+    emb_tree = proto_item_add_subtree(emb_item, ett_ipsc_voice);
+    proto_tree_add_item(emb_tree, hf_ipsc_voice_emb_cc_id, tvb, offset + IPSC_VOICE_OFF_EMB, 2, ENC_BIG_ENDIAN);
+    proto_tree_add_item(emb_tree, hf_ipsc_voice_emb_pi_id, tvb, offset + IPSC_VOICE_OFF_EMB, 2, ENC_BIG_ENDIAN);
+    proto_tree_add_item(emb_tree, hf_ipsc_voice_emb_lcss_id, tvb, offset + IPSC_VOICE_OFF_EMB, 2, ENC_BIG_ENDIAN);
+    proto_tree_add_item(emb_tree, hf_ipsc_voice_emb_parity_id, tvb, offset + IPSC_VOICE_OFF_EMB, 2, ENC_BIG_ENDIAN);
+    errors = ipsc_wire_voice_emb_decode(&voice, &emb);
+    if (errors > 0)
+      proto_item_append_text(emb_item, " (corrected 0x%04x)", emb);
+    dissect_ipsc_fec_corrected(tvb, pinfo, emb_tree, emb_item, hf_ipsc_voice_emb_corrected_id,
+                               offset + IPSC_VOICE_OFF_EMB, 2, errors, "EMB");
+
+    /* Embedded signalling, a quarter of the embedded LC */
+    proto_tree_add_item(voice_tree, hf_ipsc_voice_embedded_id, tvb, offset + IPSC_VOICE_OFF_EMBEDDED, 4, ENC_BIG_ENDIAN);
+
+    /* Embedded LC, on the last fragment */
+    dissect_ipsc_emb_lc(tvb, pinfo, voice_tree, offset + IPSC_VOICE_OFF_EMBEDDED);
+}
+
+void
+dissect_GROUP_VOICE(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree)
+{
+    proto_item *ipsc_item = NULL;
+    proto_tree *ipsc_tree = NULL;
+
+    proto_item *data_item = NULL;
+
+    guint16 length_to_follow = 0;
+    guint data_type = 0;
+
+    ipsc_item = proto_tree_add_item(tree, proto_ipsc, tvb, 0, -1, ENC_NA);
+    ipsc_tree = proto_item_add_subtree(ipsc_item, ett_ipsc);
+
+    /* Call header */
+    dissect_ipsc_fields(tvb, ipsc_tree, ipsc_call_fields, IPSC_CALL_HDR_FIELDS);
+    /* Get Data Type */
+    data_type = tvb_get_guint8(tvb, IPSC_CALL_OFF_DATA_TYPE) & 0x0f;
+
+    switch (data_type)
+    {
+      case IPSC_DATA_TYPE_VOICE_LC_HDR:
+        /* Voice LC Header */
+      case IPSC_DATA_TYPE_TERMINATOR_LC:
+      {
+        /* Voice LC Termination Header */
+
+        /* RSSI Threshold and Parity, Length to Follow */
+        dissect_ipsc_fields(tvb, ipsc_tree, ipsc_call_fields + IPSC_CALL_HDR_FIELDS,
+                            IPSC_CALL_BURST_FIELDS - IPSC_CALL_HDR_FIELDS);
+
+        /* 
+        * Decide how the rest of data looks like
+        * based on length_to_follow (words of 2 bytes each)
+        */
+        if ((length_to_follow = tvb_get_ntohs(tvb, IPSC_CALL_OFF_LENGTH_TO_FOLLOW)) != 0)
+        {
+          proto_item *ipsc_voice_item = NULL;
+          proto_tree *ipsc_voice_tree = NULL;
+          tvbuff_t *lc_tvb = tvb;
+          tvbuff_t *raw_tvb = NULL;
+          gint lc_offset = IPSC_CALL_OFF_PAYLOAD;
+          /* Length to Follow counts RSSI Status, Slot Type Sync and Data Size as well */
+          gint payload_len = 2 * length_to_follow - (IPSC_CALL_DATA_LEN - IPSC_CALL_BURST_LEN);
+
+          /* RSSI Status, Slot Type Sync, Data Size - in words of 2bytes */
+          dissect_ipsc_fields(tvb, ipsc_tree, ipsc_call_fields + IPSC_CALL_BURST_FIELDS,
+                              IPSC_CALL_DATA_FIELDS - IPSC_CALL_BURST_FIELDS);
+          /* Full LC / Voice PDU */
+          ipsc_voice_item = proto_tree_add_item(ipsc_tree, hf_ipsc_data_id, tvb, IPSC_CALL_OFF_PAYLOAD, payload_len, ENC_BIG_ENDIAN);
+          ipsc_voice_tree = proto_item_add_subtree(ipsc_voice_item, ett_ipsc);
+          /* Raw burst, the Full LC is in its corrected bits */
+          if ((raw_tvb = dissect_ipsc_raw_burst(tvb, pinfo, ipsc_voice_item)) != NULL)
+          {
+            lc_tvb = raw_tvb;
+            lc_offset = 0;
+          }
+          /* Voice PDU Byte 1 */ 
+          proto_tree_add_item(ipsc_voice_tree, hf_ipsc_full_lc_byte1_id, lc_tvb, lc_offset, 1, ENC_BIG_ENDIAN);
+          /* Voice PDU FID */
+          proto_tree_add_item(ipsc_voice_tree, hf_ipsc_full_lc_fid_id, lc_tvb, lc_offset + 1, 1, ENC_BIG_ENDIAN);
+          /* Voice PDU Service Options */
+          proto_tree_add_item(ipsc_voice_tree, hf_ipsc_voice_pdu_service_options_id, lc_tvb, lc_offset + 2, 1, ENC_BIG_ENDIAN);
+          /* Voice PDU Dst */
+          proto_tree_add_item(ipsc_voice_tree, hf_ipsc_voice_pdu_dst_id, lc_tvb, lc_offset + 3, 3, ENC_BIG_ENDIAN);
+          /* Voice PDU Rst */
+          proto_tree_add_item(ipsc_voice_tree, hf_ipsc_voice_pdu_src_id, lc_tvb, lc_offset + 6, 3, ENC_BIG_ENDIAN);
+
+          /* TODO - Add rest of bytes - Data? */
+
+          /* Auth Digest */
+          dissect_ipsc_digest(tvb, pinfo, ipsc_tree, IPSC_CALL_OFF_PAYLOAD + payload_len);
+        }
+
+      }; break;
+
+      case IPSC_DATA_TYPE_RATE_1:
+      {
+        /* Rate 1 data */
+
+        /* length to folow is in bytes */
+        length_to_follow = tvb_get_guint8(tvb, IPSC_CALL_OFF_LENGTH2);
+        /* Length to Follow */
+        proto_tree_add_item(ipsc_tree, hf_ipsc_length_to_follow2_id, tvb, IPSC_CALL_OFF_LENGTH2, 1, ENC_BIG_ENDIAN);
+        /* Data */
+        data_item = proto_tree_add_item(ipsc_tree, hf_ipsc_data_id, tvb, IPSC_CALL_OFF_PAYLOAD2, length_to_follow, ENC_BIG_ENDIAN);
+        /* Voice burst */
+        dissect_ipsc_voice(tvb, pinfo, data_item);
+        /* Auth Digest */
+        dissect_ipsc_digest(tvb, pinfo, ipsc_tree, IPSC_CALL_OFF_PAYLOAD2 + length_to_follow);
+
+      }; break;
+
+      default:
+      {
+        /* Auth Digest, right after the call header */
+        dissect_ipsc_digest(tvb, pinfo, ipsc_tree, IPSC_CALL_HDR_LEN);
+      }
+    }
+
+    /* Call tracking */
+    dissect_ipsc_call_info(tvb, pinfo, ipsc_tree);
+
+    /* Airtime */
+    dissect_ipsc_airtime(tvb, pinfo, ipsc_tree);
+
+    /* RSSI */
+    dissect_ipsc_rssi(tvb, pinfo, ipsc_tree);
+
+    /* Peer table */
+    dissect_ipsc_peer_info(tvb, pinfo, ipsc_tree);
+}
+
+void
+dissect_RPT_WAKE_UP(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree)
+{
+    proto_item *ipsc_item = NULL;
+    proto_tree *ipsc_tree = NULL;
+
+    ipsc_item = proto_tree_add_item(tree, proto_ipsc, tvb, 0, -1, ENC_NA);
+    ipsc_tree = proto_item_add_subtree(ipsc_item, ett_ipsc);
+
+    /* Type */
+    proto_tree_add_item(ipsc_tree, hf_ipsc_type, tvb, 0, 1, ENC_BIG_ENDIAN);
+
+    /* SRC_ID */
+    proto_tree_add_item(ipsc_tree, hf_ipsc_rpt_id, tvb, 1, 4, ENC_BIG_ENDIAN);
+
+    /* Auth Digest - layout of the rest is unknown, the digest is the trailer */
+    if (tvb_reported_length(tvb) >= 5 + IPSC_AUTH_DIGEST_LEN)
+      dissect_ipsc_digest(tvb, pinfo, ipsc_tree, tvb_reported_length(tvb) - IPSC_AUTH_DIGEST_LEN);
+
+    /* Peer table */
+    dissect_ipsc_peer_info(tvb, pinfo, ipsc_tree);
+}
+
+
+
+void
+dissect_PEER_LIST_REPLY(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree)
+{
+    proto_item *ipsc_item = NULL;
+    proto_tree *ipsc_tree = NULL;
+    proto_item *peer_item = NULL;
+    proto_tree *peer_tree = NULL;
+    proto_item *linking_item = NULL;
+    proto_tree *linking_tree = NULL;
+    proto_item *item = NULL;
+    ipsc_packet_data_t *packet_data;
+    gint offset, end;
+
+    ipsc_item = proto_tree_add_item(tree, proto_ipsc, tvb, 0, -1, ENC_NA);
+    ipsc_tree = proto_item_add_subtree(ipsc_item, ett_ipsc);
+
+    /* Type */
+    proto_tree_add_item(ipsc_tree, hf_ipsc_type, tvb, 0, 1, ENC_BIG_ENDIAN);
+
+    /* SRC_ID, the master */
+    proto_tree_add_item(ipsc_tree, hf_ipsc_rpt_id, tvb, 1, 4, ENC_BIG_ENDIAN);
+
+    /* Peer List Length, in octets */
+    proto_tree_add_item(ipsc_tree, hf_ipsc_peer_list_length_id, tvb, IPSC_PEER_LIST_OFF_LENGTH, 2, ENC_BIG_ENDIAN);
+
+    /* Same list as the last one of this master */
+    packet_data = (ipsc_packet_data_t *)p_get_proto_data(pinfo->fd, proto_ipsc);
+    if (packet_data && packet_data->peer_list_same_as)
+    {
+      item = proto_tree_add_uint(ipsc_tree, hf_ipsc_peer_list_same_as_id, tvb, 0, 0, packet_data->peer_list_same_as);
+      PROTO_ITEM_SET_GENERATED(item);
+    }
+
+    /* Peers */
+    offset = IPSC_PEER_LIST_OFF_ENTRIES;
+    end = offset + tvb_get_ntohs(tvb, IPSC_PEER_LIST_OFF_LENGTH);
+    for (; offset + IPSC_PEER_LEN <= end; offset += IPSC_PEER_LEN)
+    {
+      peer_item = proto_tree_add_item(ipsc_tree, hf_ipsc_peer_id, tvb, offset, IPSC_PEER_LEN, ENC_NA);
+      proto_item_append_text(peer_item, ": %u, %s:%u", tvb_get_ntohl(tvb, offset + IPSC_PEER_OFF_RPT_ID),
+                             tvb_ip_to_str(tvb, offset + IPSC_PEER_OFF_IP),
+                             tvb_get_ntohs(tvb, offset + IPSC_PEER_OFF_PORT));
+      peer_tree = proto_item_add_subtree(peer_item, ett_ipsc_peer);
+
+      /* Peer Rpt Id, IP and Port */
+      proto_tree_add_item(peer_tree, hf_ipsc_peer_rpt_id_id, tvb, offset + IPSC_PEER_OFF_RPT_ID, 4, ENC_BIG_ENDIAN);
+      proto_tree_add_item(peer_tree, hf_ipsc_peer_ip_id, tvb, offset + IPSC_PEER_OFF_IP, 4, ENC_BIG_ENDIAN);
+      proto_tree_add_item(peer_tree, hf_ipsc_peer_port_id, tvb, offset + IPSC_PEER_OFF_PORT, 2, ENC_BIG_ENDIAN);
+
+      /* Peer Linking, as in the registration messages */
+      linking_item = proto_tree_add_item(peer_tree, hf_ipsc_peer_linking_id, tvb, offset + IPSC_PEER_OFF_LINKING, 1, ENC_BIG_ENDIAN);
+      linking_tree = proto_item_add_subtree(linking_item, ett_ipsc);
+      proto_tree_add_item(linking_tree, hf_ipsc_linking_peer_op_id, tvb, offset + IPSC_PEER_OFF_LINKING, 1, ENC_BIG_ENDIAN);
+      proto_tree_add_item(linking_tree, hf_ipsc_linking_peer_mode_id, tvb, offset + IPSC_PEER_OFF_LINKING, 1, ENC_BIG_ENDIAN);
+      proto_tree_add_item(linking_tree, hf_ipsc_linking_ipsc_slot1_id, tvb, offset + IPSC_PEER_OFF_LINKING, 1, ENC_BIG_ENDIAN);
+      proto_tree_add_item(linking_tree, hf_ipsc_linking_ipsc_slot2_id, tvb, offset + IPSC_PEER_OFF_LINKING, 1, ENC_BIG_ENDIAN);
+    }
+
+    /* Auth Digest */
+    dissect_ipsc_digest(tvb, pinfo, ipsc_tree, end);
+
+    /* Request/reply matching */
+    dissect_ipsc_rr(tvb, pinfo, ipsc_tree);
+
+    /* Peer table */
+    dissect_ipsc_peer_info(tvb, pinfo, ipsc_tree);
+}
+
+/*
+ * XNL header and the XCMP message in it, on the XNL data of the frame or
+ * on the reassembled XNL packet. Request/reply matching is added to the
+ * XCMP part.
+ */
+static void
+dissect_ipsc_xnl(tvbuff_t *xnl_tvb, packet_info *pinfo, proto_tree *tree)
+{
+    ipsc_packet_data_t *packet_data;
+    ipsc_xcmp_transaction_t *transaction;
+    proto_item *xnl_item = NULL;
+    proto_tree *xnl_tree = NULL;
+    proto_item *item = NULL;
+    guint16 opcode;
+    gint payload_len;
+    nstime_t delta;
+
+    xnl_item = proto_tree_add_item(tree, hf_ipsc_xnl_id, xnl_tvb, 0, -1, ENC_NA);
+    xnl_tree = proto_item_add_subtree(xnl_item, ett_ipsc_xnl);
+
+    /* XNL Opcode, Protocol and Flags */
+    proto_tree_add_item(xnl_tree, hf_ipsc_xnl_opcode_id, xnl_tvb, IPSC_XNL_HDR_OFF_OPCODE, 2, ENC_BIG_ENDIAN);
+    proto_tree_add_item(xnl_tree, hf_ipsc_xnl_proto_id, xnl_tvb, IPSC_XNL_HDR_OFF_PROTO, 1, ENC_BIG_ENDIAN);
+    proto_tree_add_item(xnl_tree, hf_ipsc_xnl_flags_id, xnl_tvb, IPSC_XNL_HDR_OFF_FLAGS, 1, ENC_BIG_ENDIAN);
+
+    /* XNL Destination and Source Addresses */
+    proto_tree_add_item(xnl_tree, hf_ipsc_xnl_dst_id, xnl_tvb, IPSC_XNL_HDR_OFF_DST, 2, ENC_BIG_ENDIAN);
+    proto_tree_add_item(xnl_tree, hf_ipsc_xnl_src_id, xnl_tvb, IPSC_XNL_HDR_OFF_SRC, 2, ENC_BIG_ENDIAN);
+
+    /* Transaction Id and Payload Length */
+    proto_tree_add_item(xnl_tree, hf_ipsc_xnl_trans_id_id, xnl_tvb, IPSC_XNL_HDR_OFF_TRANS_ID, 2, ENC_BIG_ENDIAN);
+    proto_tree_add_item(xnl_tree, hf_ipsc_xnl_payload_len_id, xnl_tvb, IPSC_XNL_HDR_OFF_PAYLOAD_LEN, 2, ENC_BIG_ENDIAN);
+
+    proto_item_append_text(xnl_item, ": %s, %u -> %u",
+                           val_to_str_const(tvb_get_ntohs(xnl_tvb, IPSC_XNL_HDR_OFF_OPCODE), valstring_xnl_opcode, "Unknown"),
+                           tvb_get_ntohs(xnl_tvb, IPSC_XNL_HDR_OFF_SRC), tvb_get_ntohs(xnl_tvb, IPSC_XNL_HDR_OFF_DST));
+
+    payload_len = tvb_get_ntohs(xnl_tvb, IPSC_XNL_HDR_OFF_PAYLOAD_LEN);
+    if (tvb_get_ntohs(xnl_tvb, IPSC_XNL_HDR_OFF_OPCODE) != IPSC_XNL_OPCODE_DATA_MSG ||
+        tvb_get_guint8(xnl_tvb, IPSC_XNL_HDR_OFF_PROTO) != IPSC_XNL_PROTO_XCMP || payload_len < 2)
+    {
+      /* XNL Payload */
+      if (payload_len > 0)
+        proto_tree_add_item(xnl_tree, hf_ipsc_xcmp_data_id, xnl_tvb, IPSC_XNL_HDR_LEN, payload_len, ENC_NA);
+      return;
+    }
+
+    /* XCMP Opcode, its type and message */
+    opcode = tvb_get_ntohs(xnl_tvb, IPSC_XNL_HDR_LEN);
+    proto_tree_add_item(xnl_tree, hf_ipsc_xcmp_opcode_id, xnl_tvb, IPSC_XNL_HDR_LEN, 2, ENC_BIG_ENDIAN);
+    proto_tree_add_item(xnl_tree, hf_ipsc_xcmp_type_id, xnl_tvb, IPSC_XNL_HDR_LEN, 2, ENC_BIG_ENDIAN);
+    proto_tree_add_item(xnl_tree, hf_ipsc_xcmp_message_id, xnl_tvb, IPSC_XNL_HDR_LEN, 2, ENC_BIG_ENDIAN);
+    proto_item_append_text(xnl_item, ", XCMP %s %s",
+                           val_to_str_const(opcode & ~IPSC_XCMP_TYPE_MASK, valstring_xcmp_message, "Unknown"),
+                           val_to_str_const(opcode >> 12, valstring_xcmp_type, "Unknown"));
+
+    /* XCMP Data */
+    if (payload_len > 2)
+      proto_tree_add_item(xnl_tree, hf_ipsc_xcmp_data_id, xnl_tvb, IPSC_XNL_HDR_LEN + 2, payload_len - 2, ENC_NA);
+
+    packet_data = (ipsc_packet_data_t *)p_get_proto_data(pinfo->fd, proto_ipsc);
+    if (!packet_data || !(transaction = packet_data->xcmp))
+      return;
+
+    if (transaction->request_frame == pinfo->fd->num)
+    {
+      /* Request, Response In */
+      if (transaction->reply_frame)
+      {
+        item = proto_tree_add_uint(xnl_tree, hf_ipsc_xcmp_response_in_id, xnl_tvb, 0, 0, transaction->reply_frame);
+        PROTO_ITEM_SET_GENERATED(item);
+      }
+      else
+        expert_add_info_format(pinfo, xnl_item, PI_SEQUENCE, PI_NOTE, "XCMP request got no reply");
+    }
+    else
+    {
+      /* Reply, Response To and the time it took */
+      item = proto_tree_add_uint(xnl_tree, hf_ipsc_xcmp_response_to_id, xnl_tvb, 0, 0, transaction->request_frame);
+      PROTO_ITEM_SET_GENERATED(item);
+      nstime_delta(&delta, &pinfo->fd->abs_ts, &transaction->request_time);
+      item = proto_tree_add_time(xnl_tree, hf_ipsc_xcmp_time_id, xnl_tvb, 0, 0, &delta);
+      PROTO_ITEM_SET_GENERATED(item);
+    }
+}
+
+void
+dissect_XCMP_XNL(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree)
+{
+    proto_item *ipsc_item = NULL;
+    proto_tree *ipsc_tree = NULL;
+    proto_item *item = NULL;
+    ipsc_packet_data_t *packet_data;
+    ipsc_xnl_pdu_t *pdu = NULL;
+    tvbuff_t *xnl_tvb;
+    gint len;
+
+    ipsc_item = proto_tree_add_item(tree, proto_ipsc, tvb, 0, -1, ENC_NA);
+    ipsc_tree = proto_item_add_subtree(ipsc_item, ett_ipsc);
+
+    /* Type, SRC_ID and XCMP/XNL Length */
+    dissect_ipsc_fields(tvb, ipsc_tree, ipsc_xcmp_xnl_fields, array_length(ipsc_xcmp_xnl_fields));
+    len = tvb_get_ntohs(tvb, IPSC_XNL_OFF_LENGTH);
+
+    /* XCMP/XNL Data */
+    proto_tree_add_item(ipsc_tree, hf_ipsc_xcmp_xnl_data_id, tvb, IPSC_XNL_OFF_DATA, len, ENC_NA);
+
+    packet_data = (ipsc_packet_data_t *)p_get_proto_data(pinfo->fd, proto_ipsc);
+    if (packet_data)
+      pdu = packet_data->xnl_pdu;
+
+    if (!pdu)
+    {
+      /* A whole XNL packet */
+      if (len >= IPSC_XNL_HDR_LEN)
+      {
+        xnl_tvb = tvb_new_subset(tvb, IPSC_XNL_OFF_DATA, len, len);
+        dissect_ipsc_xnl(xnl_tvb, pinfo, ipsc_tree);
+      }
+    }
+    else
+    {
+      /* A piece of one */
+      item = proto_tree_add_uint(ipsc_tree, hf_ipsc_xnl_piece_id, tvb, 0, 0, packet_data->xnl_piece);
+      PROTO_ITEM_SET_GENERATED(item);
+      item = proto_tree_add_uint(ipsc_tree, hf_ipsc_xnl_first_frame_id, tvb, 0, 0, pdu->first_frame);
+      PROTO_ITEM_SET_GENERATED(item);
+
+      if (!pdu->reassembled_in)
+        expert_add_info_format(pinfo, item, PI_REASSEMBLE, PI_NOTE, "XNL packet never completed");
+      else if (pdu->reassembled_in != pinfo->fd->num)
+      {
+        item = proto_tree_add_uint(ipsc_tree, hf_ipsc_xnl_reassembled_in_id, tvb, 0, 0, pdu->reassembled_in);
+        PROTO_ITEM_SET_GENERATED(item);
+      }
+      else
+      {
+        xnl_tvb = tvb_new_child_real_data(tvb, pdu->data, pdu->len, pdu->len);
+        add_new_data_source(pinfo, xnl_tvb, "Reassembled XNL Packet");
+        dissect_ipsc_xnl(xnl_tvb, pinfo, ipsc_tree);
+      }
+    }
+
+    /* Auth Digest */
+    dissect_ipsc_digest(tvb, pinfo, ipsc_tree, IPSC_XNL_OFF_DATA + len);
+
+    /* Peer table */
+    dissect_ipsc_peer_info(tvb, pinfo, ipsc_tree);
+}
+
+void
+dissect_long_messages(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree)
+{
+    proto_item *ipsc_item = NULL;
+    proto_tree *ipsc_tree = NULL;
+    proto_item *ipsc_linking_item = NULL;
+    proto_tree *ipsc_linking_tree = NULL;
+    proto_item *ipsc_service_flags_item = NULL;
+    proto_tree *ipsc_service_flags_tree = NULL;
+    proto_item *ipsc_service_flags_byte3_item = NULL;
+    proto_tree *ipsc_service_flags_byte3_tree = NULL;
+    proto_item *ipsc_service_flags_byte4_item = NULL;
+    proto_tree *ipsc_service_flags_byte4_tree = NULL;
+
+    ipsc_item = proto_tree_add_item(tree, proto_ipsc, tvb, 0, -1, ENC_NA);
+    ipsc_tree = proto_item_add_subtree(ipsc_item, ett_ipsc);
+
+    /* Type */
+    proto_tree_add_item(ipsc_tree, hf_ipsc_type, tvb, 0, 1, ENC_BIG_ENDIAN);
+
+    /* SRC_ID */
+    proto_tree_add_item(ipsc_tree, hf_ipsc_rpt_id, tvb, 1, 4, ENC_BIG_ENDIAN);
+
+    /* Linking */
+    ipsc_linking_item = proto_tree_add_item(ipsc_tree, hf_ipsc_linking_id, tvb, 5, 1, ENC_BIG_ENDIAN);
+    ipsc_linking_tree = proto_item_add_subtree(ipsc_linking_item, ett_ipsc);
+    /* Peer Opperation */
+    proto_tree_add_item(ipsc_linking_tree, hf_ipsc_linking_peer_op_id, tvb, 5, 1, ENC_BIG_ENDIAN);
+    /* Peer Mode */
+    proto_tree_add_item(ipsc_linking_tree, hf_ipsc_linking_peer_mode_id, tvb, 5, 1, ENC_BIG_ENDIAN);
+    /* IPSC Slot 1 */
+    proto_tree_add_item(ipsc_linking_tree, hf_ipsc_linking_ipsc_slot1_id, tvb, 5, 1, ENC_BIG_ENDIAN);
+    /* IPSC Slot 2 */
+    proto_tree_add_item(ipsc_linking_tree, hf_ipsc_linking_ipsc_slot2_id, tvb, 5, 1, ENC_BIG_ENDIAN);
+
+    /* Service FLAGS */
+    ipsc_service_flags_item = proto_tree_add_item(ipsc_tree, hf_ipsc_service_flags_id, tvb, 6, 4, ENC_BIG_ENDIAN);
+    ipsc_service_flags_tree = proto_item_add_subtree(ipsc_service_flags_item, ett_ipsc);
+    /* Service FLAGS Byte 1 */
+    proto_tree_add_item(ipsc_service_flags_tree, hf_ipsc_service_flags_byte1_id, tvb, 6, 1, ENC_BIG_ENDIAN);
+    /* Service FLAGS Byte 2 */
+    proto_tree_add_item(ipsc_service_flags_tree, hf_ipsc_service_flags_byte2_id, tvb, 7, 1, ENC_BIG_ENDIAN);
+    /* Service FLAGS Byte 3 */
+    ipsc_service_flags_byte3_item = proto_tree_add_item(ipsc_service_flags_tree, hf_ipsc_service_flags_byte3_id, tvb, 8, 1, ENC_BIG_ENDIAN);
+    ipsc_service_flags_byte3_tree = proto_item_add_subtree(ipsc_service_flags_byte3_item, ett_ipsc);
+    /* Service FLAGS Byte 3 - RDAC bit */
+    proto_tree_add_item(ipsc_service_flags_byte3_tree, hf_ipsc_service_flags_byte3_rdac_id, tvb, 8, 1, ENC_BIG_ENDIAN);
+    /* Service FLAGS Byte 3 - Unknown bit */
+    proto_tree_add_item(ipsc_service_flags_byte3_tree, hf_ipsc_service_flags_byte3_unk1_id, tvb, 8, 1, ENC_BIG_ENDIAN);
+    /* Service FLAGS Byte 3 - 3rd Party App */
+    proto_tree_add_item(ipsc_service_flags_byte3_tree, hf_ipsc_service_flags_byte3_3rdpy_id, tvb, 8, 1, ENC_BIG_ENDIAN);
+    /* Service FLAGS Byte 3 - Unk2 */
+    proto_tree_add_item(ipsc_service_flags_byte3_tree, hf_ipsc_service_flags_byte3_unk2_id, tvb, 8, 1, ENC_BIG_ENDIAN);
+    /* Service FLAGS Byte 4 */
+    ipsc_service_flags_byte4_item = proto_tree_add_item(ipsc_service_flags_tree, hf_ipsc_service_flags_byte4_id, tvb, 9, 1, ENC_BIG_ENDIAN);
+    ipsc_service_flags_byte4_tree = proto_item_add_subtree(ipsc_service_flags_byte4_item, ett_ipsc);
+    /* Service FLAGS Byte 4 - XNL Connected */
+    proto_tree_add_item(ipsc_service_flags_byte4_tree, hf_ipsc_service_flags_byte4_xnl_conn_id, tvb, 9, 1, ENC_BIG_ENDIAN);
+    /* Service FLAGS Byte 4 - XNL Master Device */
+    proto_tree_add_item(ipsc_service_flags_byte4_tree, hf_ipsc_service_flags_byte4_xnl_master_id, tvb, 9, 1, ENC_BIG_ENDIAN);
+    /* Service FLAGS Byte 4 - XNL Slave Device */
+    proto_tree_add_item(ipsc_service_flags_byte4_tree, hf_ipsc_service_flags_byte4_xnl_slave_id, tvb, 9, 1, ENC_BIG_ENDIAN);
+    /* Service FLAGS Byte 4 - Authenticated packets */
+    proto_tree_add_item(ipsc_service_flags_byte4_tree, hf_ipsc_service_flags_byte4_auth_id, tvb, 9, 1, ENC_BIG_ENDIAN);
+    /* Service FLAGS Byte 4 - Voice calls supported */
+    proto_tree_add_item(ipsc_service_flags_byte4_tree, hf_ipsc_service_flags_byte4_voice_id, tvb, 9, 1, ENC_BIG_ENDIAN);
+    /* Service FLAGS Byte 4 - Data calls supported */
+    proto_tree_add_item(ipsc_service_flags_byte4_tree, hf_ipsc_service_flags_byte4_data_id, tvb, 9, 1, ENC_BIG_ENDIAN);
+    /* Service FLAGS Byte 4 - Unk2 */
+    proto_tree_add_item(ipsc_service_flags_byte4_tree, hf_ipsc_service_flags_byte4_unk2_id, tvb, 9, 1, ENC_BIG_ENDIAN);
+    /* Service FLAGS Byte 4 - Master */
+    proto_tree_add_item(ipsc_service_flags_byte4_tree, hf_ipsc_service_flags_byte4_master_id, tvb, 9, 1, ENC_BIG_ENDIAN);
+
+    /* Version */
+    proto_tree_add_item(ipsc_tree, hf_ipsc_version_id, tvb, 10, 4, ENC_BIG_ENDIAN);
+
+    /* Auth Digest */
+    dissect_ipsc_digest(tvb, pinfo, ipsc_tree, 14);
+
+    /* Request/reply matching */
+    dissect_ipsc_rr(tvb, pinfo, ipsc_tree);
+
+    /* Peer table */
+    dissect_ipsc_peer_info(tvb, pinfo, ipsc_tree);
+}
+
+/*
+ * Pull the fields needed for the Info column and the tap straight
+ * from the tvb, without building any tree. Every read is length
+ * checked so this never throws on short packets; fields that the
+ * opcode does not carry are left zero. The FEC of a raw burst is not
+ * run here but once on the first pass, see ipsc_track_raw_burst().
+ */
+static void
+dissect_ipsc_summary(tvbuff_t *tvb, ipsc_info_t *ipsc_info)
+{
+  ipsc_wire_msg_t msg;
+  ipsc_wire_call_t call;
+  ipsc_wire_reg_t reg;
+  ipsc_wire_csbk_t csbk;
+  ipsc_wire_voice_t voice;
+  const guint8 *payload;
+  size_t payload_len;
+  guint16 emb;
+  int errors;
+  int dbm;
+
+  ipsc_wire_msg_tvb(tvb, &msg);
+  if (msg.len < 1)
+    return;
+
+  /* Type */
+  ipsc_info->opcode = ipsc_wire_opcode(&msg);
+  ipsc_info->length = tvb_reported_length(tvb);
+
+  /* RPT_ID */
+  if (msg.len >= IPSC_SHORT_LEN)
+    ipsc_info->rpt_id = ipsc_wire_rpt_id(&msg);
+
+  /* Call header up to and including Data Type Voice Hdr */
+  if (ipsc_wire_call(&msg, &call))
+  {
+    ipsc_info->is_call = TRUE;
+    ipsc_info->src_id = ipsc_wire_call_src_id(&call);
+    ipsc_info->dst_id = ipsc_wire_call_dst_id(&call);
+    ipsc_info->slot = ipsc_wire_call_slot(&call);
+    ipsc_info->call_seq_no = ipsc_wire_call_call_seq_no(&call);
+    ipsc_info->timestamp = ipsc_wire_call_timestamp(&call);
+    ipsc_info->data_type = ipsc_wire_call_data_type(&call);
+    /* Until the call state or the Data Header says otherwise */
+    ipsc_info->group = (ipsc_info->opcode == 0x80 || ipsc_info->opcode == 0x83);
+    payload = ipsc_wire_call_payload(&call, &payload_len);
+
+    /* RSSI Status and Threshold in dBm */
+    if (ipsc_wire_call_rssi(&call, &dbm))
+    {
+      ipsc_info->has_rssi = TRUE;
+      ipsc_info->rssi = (gint16)dbm;
+      if (ipsc_wire_call_rssi_threshold(&call, &dbm))
+        ipsc_info->rssi_threshold = (gint16)dbm;
+    }
+
+    /* CSBKO and FID, to tell the preamble floods apart; a raw burst waits for its decode */
+    if (ipsc_info->data_type == IPSC_DATA_TYPE_CSBK && payload && !ipsc_wire_call_raw_burst(&call) &&
+        ipsc_wire_csbk(payload, payload_len, &csbk))
+    {
+      ipsc_info->csbko = ipsc_wire_csbk_csbko(&csbk);
+      ipsc_info->csbk_fid = ipsc_wire_csbk_fid(&csbk);
+    }
+
+    /* Voice burst position */
+    if (ipsc_wire_voice(&call, &voice))
+    {
+      ipsc_info->is_voice = TRUE;
+      ipsc_info->voice_burst = ipsc_wire_voice_burst(&voice);
+
+      /* QR(16,7,6) of the EMB */
+      if (ipsc_wire_voice_has_emb(&voice))
+      {
+        ipsc_info->fec_checked = TRUE;
+        if ((errors = ipsc_wire_voice_emb_decode(&voice, &emb)) < 0)
+          ipsc_info->fec_failed = TRUE;
+        else
+          ipsc_info->fec_corrected += errors;
+      }
+    }
+  }
+
+  /* Registration and keepalives, Linking and Service FLAGS byte 4 for the peer table */
+  if (ipsc_wire_reg(&msg, &reg))
+  {
+    ipsc_info->linking = ipsc_wire_reg_linking(&reg);
+    ipsc_info->service_flags4 = ipsc_wire_reg_flags4(&reg);
+  }
+}
+
+/* Name of the CSBK of a CSBK packet */
+static const gchar *
+ipsc_csbk_str(const ipsc_info_t *ipsc_info)
+{
+  const ipsc_csbk_type_t *type = ipsc_csbk_lookup(ipsc_info->csbk_fid, ipsc_info->csbko);
+
+  return type ? type->name : ep_strdup_printf("CSBKO 0x%02x FID 0x%02x", ipsc_info->csbko, ipsc_info->csbk_fid);
+}
+
+static void
+ipsc_set_info_column(packet_info *pinfo, const ipsc_info_t *ipsc_info)
+{
+  col_add_fstr(pinfo->cinfo, COL_INFO, "%s Rpt=%u",
+               val_to_str(ipsc_info->opcode, valstring_type, "Unknown (0x%02x)"),
+               ipsc_info->rpt_id);
+
+  if (ipsc_info->is_call)
+  {
+    col_append_fstr(pinfo->cinfo, COL_INFO, " Src=%u Dst=%u Seq=%u %s",
+                    ipsc_info->src_id, ipsc_info->dst_id, ipsc_info->call_seq_no,
+                    val_to_str_const(ipsc_info->data_type, valstring_data_type, "Unknown"));
+    if (ipsc_info->data_type == IPSC_DATA_TYPE_CSBK)
+      col_append_fstr(pinfo->cinfo, COL_INFO, " %s", ipsc_csbk_str(ipsc_info));
+    else if (ipsc_info->is_voice)
+      col_append_fstr(pinfo->cinfo, COL_INFO, " Voice %c", 'A' + ipsc_info->voice_burst);
+  }
+}
+
+static void
+dissect_ipsc(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree)
+{
+  ipsc_info_t *ipsc_info;
+  ipsc_packet_data_t *packet_data;
+  ipsc_wire_csbk_t csbk;
+
+  /*
+     Clear the Info column so that, if we throw an exception, it
+     shows up as a short or malformed ARP frame. */
+  col_set_str(pinfo->cinfo, COL_PROTOCOL, "IPSC");
+  col_clear(pinfo->cinfo, COL_INFO);
+
+  /*
+   * The summary is cheap and does not need a tree, so it is done
+   * on every pass; tshark without -V and the first pass only pay
+   * for these few loads.
+   */
+  ipsc_info = ep_new0(ipsc_info_t);
+  dissect_ipsc_summary(tvb, ipsc_info);
+
+  /* Per call state, attached to the frame on the first pass */
+  packet_data = ipsc_track_call(tvb, pinfo, ipsc_info);
+
+  /* Raw burst, from its decode on the first pass */
+  if (packet_data && packet_data->burst)
+  {
+    ipsc_info->fec_checked = TRUE;
+    if (packet_data->slot_type_errors < 0 || packet_data->burst_errors < 0)
+      ipsc_info->fec_failed = TRUE;
+    ipsc_info->fec_corrected += MAX(packet_data->slot_type_errors, 0) + MAX(packet_data->burst_errors, 0);
+
+    if (ipsc_info->data_type == IPSC_DATA_TYPE_CSBK && ipsc_wire_csbk(packet_data->burst, IPSC_BURST_LEN, &csbk))
+    {
+      ipsc_info->csbko = ipsc_wire_csbk_csbko(&csbk);
+      ipsc_info->csbk_fid = ipsc_wire_csbk_fid(&csbk);
+    }
+  }
+
+  ipsc_set_info_column(pinfo, ipsc_info);
+
+  if (packet_data && packet_data->call)
+  {
+    col_append_fstr(pinfo->cinfo, COL_INFO, " Call=%u", packet_data->call->call_id);
+
+    ipsc_info->call_id = packet_data->call->call_id;
+    ipsc_info->group = packet_data->call->group;
+    ipsc_info->stream_flags = packet_data->stream_flags;
+    ipsc_info->lost = packet_data->lost;
+    ipsc_info->jitter = packet_data->jitter;
+  }
+  if (packet_data)
+  {
+    ipsc_info->call_start = packet_data->call_start;
+    ipsc_info->airtime = packet_data->airtime;
+
+    if (packet_data->data_pdu)
+    {
+      ipsc_info->group = packet_data->data_pdu->group;
+      ipsc_info->data_last_block = (packet_data->data_block == packet_data->data_pdu->blocks);
+    }
+
+    if (packet_data->rr_rpt_id)
+    {
+      ipsc_info->request_rpt_id = packet_data->rr_rpt_id;
+      ipsc_info->rtt = nstime_to_msec(&packet_data->rr_time);
+    }
+    ipsc_info->missed = packet_data->rr_missed;
+    ipsc_info->peer_event = packet_data->peer_event;
+  }
+
+  tap_queue_packet(ipsc_tap, pinfo, ipsc_info);
+
+  if (tree) {
+    int val;
+
+    switch (val = tvb_get_guint8(tvb, 0))
+    {
+      case 0x80:
+        dissect_GROUP_VOICE(tvb, pinfo, tree);
+        break;
+      case 0x83:
+      case 0x84:
+        dissect_PVT_DATA(tvb, pinfo, tree);
+        break;
+      case 0x85:
+        dissect_RPT_WAKE_UP(tvb, pinfo, tree);
+        break;
+      case 0x70:
+        dissect_XCMP_XNL(tvb, pinfo, tree);
+        break;
+      case 0x93:
+        dissect_PEER_LIST_REPLY(tvb, pinfo, tree);
+        break;
+
+      case 0x90:
+      case 0x91:
+      case 0x94:
+      case 0x95:
+      case 0x96:
+      case 0x97:
+      case 0x98:
+      case 0x99:
+        dissect_long_messages(tvb, pinfo, tree);
+        break;
+
+      default:
+        if (ipsc_layout_by_opcode[val])
+          dissect_ipsc_layout(tvb, pinfo, tree, ipsc_layout_by_opcode[val]);
+    }
+  }
+
+  /* Reassembled data goes on to IP and friends, tree or not */
+  dissect_ipsc_data_payload(tvb, pinfo, tree, packet_data);
+}
+
+/*
+ * Heuristic for IPSC on ports that are not in the port range: the
+ * opcode must be known and the length must be exactly what the opcode
+ * says, with or without the 10 octet Auth Digest. Call packets also
+ * need a DMR data type and a Length to Follow or Rate 1 length that
+ * adds up, so RTP, which starts with 0x80 too, is not taken for
+ * GROUP_VOICE. That is a couple of compares for the UDP packets that
+ * are not IPSC.
+ */
+static gboolean
+dissect_ipsc_heur(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree, void *data _U_)
+{
+  ipsc_wire_msg_t msg;
+  size_t expected;
+  int exact;
+
+  if (!ipsc_try_heuristic || tvb_length(tvb) != tvb_reported_length(tvb))
+    return FALSE;
+
+  ipsc_wire_msg_tvb(tvb, &msg);
+  if (msg.len < IPSC_SHORT_LEN)
+    return FALSE;
+
+  /* Length without the Auth Digest */
+  expected = ipsc_wire_body_length(&msg, &exact);
+  if (!expected)
+    return FALSE;
+
+  /* RPT_WAKE_UP and cut packets have no exact length to check, leave them to the port range */
+  if (!exact || (msg.len != expected && msg.len != expected + IPSC_AUTH_DIGEST_LEN))
+    return FALSE;
+
+  dissect_ipsc(tvb, pinfo, tree);
+  return TRUE;
+}
+
+/*
+ * Statistics, tshark -z ipsc,tree
+ */
+static const gchar *st_str_opcodes = "Packets by Opcode";
+static const gchar *st_str_opcode_bytes = "Bytes by Opcode";
+static const gchar *st_str_repeaters = "Packets by Repeater";
+static const gchar *st_str_talkgroups = "Group Calls by Talkgroup";
+static const gchar *st_str_radios = "Calls by Radio Id";
+static const gchar *st_str_keepalives = "Keepalives by Repeater";
+static const gchar *st_str_airtime = "Airtime (ms) by Repeater";
+static const gchar *st_str_csbks = "CSBKs by Opcode";
+
+static int st_node_opcodes = -1;
+static int st_node_opcode_bytes = -1;
+static int st_node_repeaters = -1;
+static int st_node_talkgroups = -1;
+static int st_node_radios = -1;
+static int st_node_keepalives = -1;
+static int st_node_airtime = -1;
+static int st_node_csbks = -1;
+
+static void
+ipsc_stats_tree_init(stats_tree *st)
+{
+  st_node_opcodes = stats_tree_create_node(st, st_str_opcodes, 0, TRUE);
+  st_node_opcode_bytes = stats_tree_create_node(st, st_str_opcode_bytes, 0, TRUE);
+  st_node_repeaters = stats_tree_create_node(st, st_str_repeaters, 0, TRUE);
+  st_node_talkgroups = stats_tree_create_node(st, st_str_talkgroups, 0, TRUE);
+  st_node_radios = stats_tree_create_node(st, st_str_radios, 0, TRUE);
+  st_node_keepalives = stats_tree_create_node(st, st_str_keepalives, 0, TRUE);
+  st_node_airtime = stats_tree_create_node(st, st_str_airtime, 0, TRUE);
+  st_node_csbks = stats_tree_create_node(st, st_str_csbks, 0, TRUE);
+}
+
+static int
+ipsc_stats_tree_packet(stats_tree *st, packet_info *pinfo _U_, epan_dissect_t *edt _U_, const void *p)
+{
+  const ipsc_info_t *ipsc_info = (const ipsc_info_t *)p;
+  const gchar *opcode_str;
+  int rpt_node;
+  int airtime_ms;
+
+  opcode_str = val_to_str(ipsc_info->opcode, valstring_type, "Unknown (0x%02x)");
+
+  /* Opcode, packets and bytes */
+  tick_stat_node(st, st_str_opcodes, 0, FALSE);
+  tick_stat_node(st, opcode_str, st_node_opcodes, FALSE);
+  increase_stat_node(st, st_str_opcode_bytes, 0, FALSE, ipsc_info->length);
+  increase_stat_node(st, opcode_str, st_node_opcode_bytes, FALSE, ipsc_info->length);
+
+  /* Repeater, split by timeslot for call traffic */
+  tick_stat_node(st, st_str_repeaters, 0, FALSE);
+  rpt_node = tick_stat_node(st, ep_strdup_printf("%u", ipsc_info->rpt_id), st_node_repeaters, TRUE);
+  if (ipsc_info->is_call)
+    tick_stat_node(st, ipsc_info->slot == 2 ? "Slot 2" : "Slot 1", rpt_node, FALSE);
+
+  if (ipsc_info->is_call)
+  {
+    /* Talkgroups only exist for group calls, the rest is radio to radio */
+    if (ipsc_info->opcode == 0x80 || ipsc_info->opcode == 0x83)
+    {
+      tick_stat_node(st, st_str_talkgroups, 0, FALSE);
+      tick_stat_node(st, ep_strdup_printf("%u", ipsc_info->dst_id), st_node_talkgroups, FALSE);
+    }
+
+    tick_stat_node(st, st_str_radios, 0, FALSE);
+    tick_stat_node(st, ep_strdup_printf("%u", ipsc_info->src_id), st_node_radios, FALSE);
+
+    if (ipsc_info->data_type == IPSC_DATA_TYPE_CSBK)
+    {
+      tick_stat_node(st, st_str_csbks, 0, FALSE);
+      tick_stat_node(st, ipsc_csbk_str(ipsc_info), st_node_csbks, FALSE);
+    }
+  }
+
+  /* MASTER_ALIVE_REQ/REPLY and PEER_ALIVE_REQ/REPLY, the rate column is the keepalive rate */
+  if (ipsc_info->opcode >= 0x96 && ipsc_info->opcode <= 0x99)
+  {
+    tick_stat_node(st, st_str_keepalives, 0, FALSE);
+    rpt_node = tick_stat_node(st, ep_strdup_printf("%u", ipsc_info->rpt_id), st_node_keepalives, TRUE);
+    tick_stat_node(st, opcode_str, rpt_node, FALSE);
+  }
+
+  /* Slot busy time, in ms as the counts are integers */
+  if (ipsc_info->airtime > 0)
+  {
+    airtime_ms = (int)(ipsc_info->airtime * 1000.0 + 0.5);
+    increase_stat_node(st, st_str_airtime, 0, FALSE, airtime_ms);
+    rpt_node = increase_stat_node(st, ep_strdup_printf("%u", ipsc_info->rpt_id), st_node_airtime, TRUE, airtime_ms);
+    increase_stat_node(st, ipsc_info->slot == 2 ? "Slot 2" : "Slot 1", rpt_node, FALSE, airtime_ms);
+  }
+
+  return 1;
+}
+
+void
+proto_register_ipsc(void)
+{
+  module_t *ipsc_module;
+  guint i;
+
+  static const value_string valstring_linking_peer_op[] = {
+    { 0x00, "Unknown" },
+    { 0x01, "Peer Operational" },
+    { 0x02, "Unknown" },
+    { 0x03, "Unknown" },
+    { 0, NULL },
+  };
+
+  static const value_string valstring_linking_peer_mode[] = {
+    { 0x00, "No Radio" },
+    { 0x01, "Analog Radio" },
+    { 0x02, "Digital Radio" },
+    { 0x03, "Unknown" },
+    { 0, NULL },
+  };
+
+  static const value_string valstring_linking_ipsc_slot[] = {
+    { 0x00, "Unknown" },
+    { 0x01, "OFF" },
+    { 0x02, "ON" },
+    { 0x03, "Unknown" },
+    { 0, NULL },
+  };
+
+  static const true_false_string valstring_service_flags_rdac = {
+    "RDAC call",
+    "Not a RDAC call"
+  };
+
+  static const true_false_string valstring_service_flags_rpt_call_mon = {
+    "1",
+    "0"
+  };
+
+  static const true_false_string valstring_one_zero = {
+    "1",
+    "0"
+  };
+
+
+  static const true_false_string valstring_service_flags_3rdpy = {
+    "3rd Party Console App",
+    "Not a 3rd Party Console App"
+  };
+
+  static const true_false_string valstring_service_flags_auth = {
+    "Yes",
+    "No"
+  };
+
+  static const true_false_string valstring_service_flags_voice = {
+    "Yes",
+    "No"
+  };
+
+  static const true_false_string valstring_service_flags_data = {
+    "Yes",
+    "No"
+  };
+
+  static const true_false_string valstring_service_flags_unk2 = {
+    "Yes",
+    "No"
+  };
+
+  static const true_false_string valstring_service_flags_master = {
+    "Yes",
+    "No"
+  };
+
+
+  static const value_string valstring_data_packet_format[] = {
+    { 0x0, "Unified Data Transport (UTD)" },
+    { 0x1, "Response Packet" },
+    { 0x2, "Data packet with unconfirmed delivery" },
+    { 0x3, "Data packet with confirmed delivery" },
+    { 0xd, "Short Data: Defined" },
+    { 0xe, "Short Data: Raw or Status/Precoded " },
+    { 0xf, "Proprietary Data Packet" },
+    { 0, NULL },
+  };
+
+  static const value_string valstring_service_access_point[] = {
+    { 0x0, "Unified Data Transport (UDT)" },
+    { 0x1, "Reserved" },
+    { 0x2, "TCP/IP header compression" },
+    { 0x3, "UDP/IP header compression" },
+    { 0x4, "IP based Packet data" },
+    { 0x5, "Address Resolution Protocol (ARP)" },
+    { 0x6, "Reserved" },
+    { 0x7, "Reserved" },
+    { 0x8, "Reserved" },
+    { 0x9, "Proprietary Packet data" },
+    { 0xa, "Short Data" },
+    { 0xb, "Reserved" },
+    { 0xc, "Reserved" },
+    { 0xd, "Reserved" },
+    { 0xe, "Reserved" },
+    { 0xf, "Reserved" },
+    { 0x0, NULL}
+  };
+
+
+  static hf_register_info hf[] = {
+    { &hf_ipsc_type, 
+      { "Type", "ipsc.type", FT_UINT8, BASE_HEX, VALS(valstring_type), 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_rpt_id, 
+      { "Rpt Id", "ipsc.src_id", FT_UINT32, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_linking_id, 
+      { "Linking", "ipsc.linking", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_linking_peer_op_id, 
+      { "Peer Op", "ipsc.linking.peer_op", FT_UINT8, BASE_HEX, VALS(valstring_linking_peer_op), 0xc0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_linking_peer_mode_id, 
+      { "Peer Mode", "ipsc.linking.peer_mode", FT_UINT8, BASE_HEX, VALS(valstring_linking_peer_mode), 0x30, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_linking_ipsc_slot1_id, 
+      { "IPSC Slot 1", "ipsc.linking.ipsc_slot1", FT_UINT8, BASE_HEX, VALS(valstring_linking_ipsc_slot), 0x0c, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_linking_ipsc_slot2_id, 
+      { "IPSC Slot 2", "ipsc.linking.ipsc_slot2", FT_UINT8, BASE_HEX, VALS(valstring_linking_ipsc_slot), 0x03, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_service_flags_id, 
+      { "Service FLAGS", "ipsc.service_flags", FT_UINT32, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_service_flags_byte1_id, 
+      { "BYTE 1", "ipsc.service_flags.byte1", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_service_flags_byte2_id, 
+      { "BYTE 2", "ipsc.service_flags.byte2", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_service_flags_byte3_id, 
+      { "BYTE 3", "ipsc.service_flags.byte3", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_service_flags_byte3_rdac_id, 
+      { "CSBK message", "ipsc.service_flags.byte3.csbk", FT_BOOLEAN, 8, NULL, 0x80, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_service_flags_byte3_unk1_id, 
+      { "Repeater call monitoring", "ipsc.service_flags.byte3.rpt_call_mon", FT_BOOLEAN, 8, TFS(&valstring_service_flags_rpt_call_mon), 0x40, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_service_flags_byte3_3rdpy_id, 
+      { "3rd Party", "ipsc.service_flags.byte3.3rdpy", FT_BOOLEAN, 8, TFS(&valstring_service_flags_3rdpy), 0x20, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_service_flags_byte3_unk2_id, 
+      { "Unk2", "ipsc.service_flags.byte3.3rdpy", FT_UINT8, BASE_HEX, NULL, 0x1f, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_service_flags_byte4_id, 
+      { "BYTE 4", "ipsc.service_flags.byte4", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_service_flags_byte4_xnl_conn_id, 
+      { "XNL connected", "ipsc.service_flags.byte4.xnl_conn", FT_BOOLEAN, 8, NULL, 0x80, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_service_flags_byte4_xnl_master_id, 
+      { "XNL Master Device", "ipsc.service_flags.byte4.xnl_master", FT_BOOLEAN, 8, NULL, 0x40, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_service_flags_byte4_xnl_slave_id, 
+      { "XNL Slave Device", "ipsc.service_flags.byte4.xnl_slave", FT_BOOLEAN, 8, NULL, 0x20, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_service_flags_byte4_auth_id, 
+      { "Authenticated packets", "ipsc.service_flags.byte4.auth", FT_BOOLEAN, 8, TFS(&valstring_service_flags_auth), 0x10, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_service_flags_byte4_voice_id, 
+      { "Voice enabled", "ipsc.service_flags.byte4.voice", FT_BOOLEAN, 8, TFS(&valstring_service_flags_voice), 0x08, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_service_flags_byte4_data_id, 
+      { "Data enabled", "ipsc.service_flags.byte4.data", FT_BOOLEAN, 8, TFS(&valstring_service_flags_data), 0x04, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_service_flags_byte4_unk2_id, 
+      { "Unk 2", "ipsc.service_flags.byte4.unk2", FT_BOOLEAN, 8, TFS(&valstring_service_flags_unk2), 0x02, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_service_flags_byte4_master_id, 
+      { "Master", "ipsc.service_flags.byte4.master", FT_BOOLEAN, 8, TFS(&valstring_service_flags_master), 0x01, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_version_id, 
+      { "Version", "ipsc.version", FT_UINT32, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_seq_no_id, 
+      { "Seq No", "ipsc.seq_no", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_src_id, 
+      { "Src Id", "ipsc.src_id", FT_UINT24, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_dst_id, 
+      { "Dst Id", "ipsc.dst_id", FT_UINT24, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_prio_v_d_id, 
+      { "Priority Voice/Data", "ipsc.prio_v_d", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_call_ctrl_id, 
+      { "Call Ctrl", "ipsc.call_ctrl", FT_UINT32, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_call_ctrl_info_id, 
+      { "Call Ctrl Info", "ipsc.call_ctrl_info", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_call_ctrl_src_id, 
+      { "Call Ctrl Src", "ipsc.call_ctrl_src", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_payload_type_id, 
+      { "Payload Type", "ipsc.payload_type", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_call_seq_no_id, 
+      { "Call Seq No", "ipsc.call_seq_no", FT_UINT16, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_timestamp_id, 
+      { "Timestamp", "ipsc.timestamp", FT_UINT32, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_sync_src_id, 
+      { "Sync Src", "ipsc.sync_src", FT_UINT32, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_data_type_voice_hdr_id, 
+      { "Data Type Voice Hdr", "ipsc.data_type_voice_hdr", FT_UINT8, BASE_HEX, VALS(valstring_data_type), 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_rssi_threshold_and_parity_id, 
+      { "RSSI Threshold and Parity", "ipsc.rssi_threshold_and_parity", FT_UINT8, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_length_to_follow_id, 
+      { "Length to Follow - in 2byte words", "ipsc.length_to_follow", FT_UINT16, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_length_to_follow2_id, 
+      { "Length to Follow 2 - in bytes", "ipsc.length_to_follow2", FT_UINT8, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_rssi_status_id, 
+      { "RSSI Status", "ipsc.rssi_status", FT_UINT8, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_slot_type_sync_id, 
+      { "Slot Type Sync", "ipsc.slot_type_sync", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_data_size_id, 
+      { "Data Size", "ipsc.data_size", FT_UINT16, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_data_id, 
+      { "Data", "ipsc.data", FT_BYTES, BASE_NONE, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_data_hdr_byte1_id, 
+      { "Data Hdr Byte 1", "ipsc.data_hdr_byte1", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_data_hdr_byte1_gi_id, 
+      { "Group / Individual call", "ipsc.data_hdr.byte1_gi", FT_BOOLEAN, 8, NULL, 0x80, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_data_hdr_byte1_a_id, 
+      { "Acknowledge requested", "ipsc.data_hdr.byte1_a", FT_BOOLEAN, 8, NULL, 0x40, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_data_hdr_byte1_hc_id, 
+      { "Header Compression (HC)", "ipsc.data_hdr.byte1_hc", FT_BOOLEAN, 8, NULL, 0x20, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_data_hdr_byte1_pocmsb_id, 
+      { "Packet Octet Count(POC) MSB", "ipsc.data_hdr.byte1_pocmsb", FT_BOOLEAN, 8, NULL, 0x10, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_data_hdr_byte1_dpf_id, 
+      { "Data Packet Format (DPF)", "ipsc.data_hdr.byte1_dpf", FT_UINT8, BASE_HEX, VALS(valstring_data_packet_format), 0x0f, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_data_hdr_byte2_id, 
+      { "Data Hdr Byte 2", "ipsc.data_hdr_byte2", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_data_hdr_byte2_sap_id, 
+      { "Service Access Point (SAP)", "ipsc.data_hdr.byte2_sap", FT_UINT8, BASE_HEX, VALS(valstring_service_access_point), 0xf0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_data_hdr_byte2_poc_id, 
+      { "Packet Octet Count (POC)", "ipsc.data_hdr.byte2_poc", FT_UINT8, BASE_DEC, NULL, 0x0f, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_data_hdr_dst_id, 
+      { "Data Hdr Dst", "ipsc.data_hdr_dst", FT_UINT24, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_data_hdr_src_id, 
+      { "Data Hdr Src", "ipsc.data_hdr_src", FT_UINT24, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_data_hdr_byte8_id, 
+      { "Data Hdr Byte 8", "ipsc.data_hdr_byte8", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_data_hdr_byte8_f_id, 
+      { "Full Message Flag (F)", "ipsc.data_hdr.byte8_f", FT_BOOLEAN, 8, NULL, 0x80, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_data_hdr_byte8_btf_id, 
+      { "Blocks to Follow (BF)", "ipsc.data_hdr.byte8_btf", FT_UINT8, BASE_DEC, NULL, 0x7f, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_data_hdr_byte9_id, 
+      { "Data Hdr Byte 9", "ipsc.data_hdr_byte9", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_data_hdr_byte9_s_id, 
+      { "Re-Synchronize flag (S)", "ipsc.data_hdr_byte9_s", FT_BOOLEAN, 8, NULL, 0x80, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_data_hdr_byte9_ns_id, 
+      { "Send sequence Number N(S)", "ipsc.data_hdr_byte9_ns", FT_UINT8, BASE_DEC, NULL, 0x70, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_data_hdr_byte9_fsn_id, 
+      { "Fragment Sequence Number (FSN)", "ipsc.data_hdr_byte9_fsn", FT_UINT8, BASE_DEC, NULL, 0x0f, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_data_hdr_byte9_nibble1_id, 
+      { "Nibble1", "ipsc.data_hdr_byte9_nibble1", FT_UINT8, BASE_DEC, NULL, 0xf0, NULL, HFILL }
+    }
+
+    ,
+    { &hf_ipsc_data_hdr_crc_id, 
+      { "Data Hdr CRC", "ipsc.data_hdr_crc", FT_UINT16, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_data_hdr_crc_good_id, 
+      { "Good", "ipsc.data_hdr_crc_good", FT_BOOLEAN, BASE_NONE, NULL, 0x0, "True: CRC matches the Data Header", HFILL }
+    }
+    ,
+    { &hf_ipsc_data_hdr_crc_bad_id, 
+      { "Bad", "ipsc.data_hdr_crc_bad", FT_BOOLEAN, BASE_NONE, NULL, 0x0, "True: CRC does not match the Data Header", HFILL }
+    }
+    ,
+    { &hf_ipsc_csbk_hdr_byte1_id, 
+      { "CSBK Hdr Byte 1", "ipsc.csbk_hdr_byte1", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_csbk_hdr_fid_id, 
+      { "CSBK Hdr FID", "ipsc.csbk_hdr_fid", FT_UINT8, BASE_HEX, VALS(valstring_csbk_fid), 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_csbk_hdr_byte3_id, 
+      { "CSBK Hdr Byte 3", "ipsc.csbk_hdr_byte3", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_csbk_hdr_byte4_id, 
+      { "CSBK Hdr Byte 4", "ipsc.csbk_hdr_byte4", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_csbk_hdr_dst_id, 
+      { "CSBK Hdr Dst", "ipsc.csbk_hdr_dst", FT_UINT24, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_csbk_hdr_src_id, 
+      { "CSBK Hdr Src", "ipsc.csbk_hdr_src", FT_UINT24, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_csbk_hdr_crc_id, 
+      { "CSBK Hdr CRC", "ipsc.csbk_hdr_crc", FT_UINT16, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_csbk_lb_id, 
+      { "Last Block", "ipsc.csbk.lb", FT_BOOLEAN, 8, NULL, 0x80, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_csbk_pf_id, 
+      { "Protect Flag", "ipsc.csbk.pf", FT_BOOLEAN, 8, NULL, 0x40, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_csbk_opcode_id, 
+      { "CSBKO", "ipsc.csbk.opcode", FT_UINT8, BASE_HEX, NULL, 0x3f, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_csbk_service_options_id, 
+      { "Service Options", "ipsc.csbk.service_options", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_csbk_emergency_id, 
+      { "Emergency", "ipsc.csbk.emergency", FT_BOOLEAN, 8, NULL, 0x80, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_csbk_privacy_id, 
+      { "Privacy", "ipsc.csbk.privacy", FT_BOOLEAN, 8, NULL, 0x40, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_csbk_broadcast_id, 
+      { "Broadcast", "ipsc.csbk.broadcast", FT_BOOLEAN, 8, NULL, 0x08, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_csbk_ovcm_id, 
+      { "Open Voice Call Mode", "ipsc.csbk.ovcm", FT_BOOLEAN, 8, NULL, 0x04, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_csbk_priority_id, 
+      { "Priority", "ipsc.csbk.priority", FT_UINT8, BASE_DEC, NULL, 0x03, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_csbk_answer_id, 
+      { "Answer Response", "ipsc.csbk.answer", FT_UINT8, BASE_HEX, VALS(valstring_csbk_answer), 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_csbk_nack_info_id, 
+      { "Additional Info", "ipsc.csbk.nack_info", FT_BOOLEAN, 8, NULL, 0x80, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_csbk_nack_source_id, 
+      { "Source Type", "ipsc.csbk.nack_source", FT_UINT8, BASE_DEC, VALS(valstring_csbk_nack_source), 0x40, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_csbk_nack_service_id, 
+      { "Service Type", "ipsc.csbk.nack_service", FT_UINT8, BASE_HEX, NULL, 0x3f, "CSBKO of the refused service", HFILL }
+    }
+    ,
+    { &hf_ipsc_csbk_nack_reason_id, 
+      { "Reason Code", "ipsc.csbk.nack_reason", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_csbk_preamble_data_id, 
+      { "Content", "ipsc.csbk.preamble_content", FT_BOOLEAN, 8, TFS(&tfs_csbk_preamble_content), 0x80, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_csbk_preamble_group_id, 
+      { "Destination", "ipsc.csbk.preamble_group", FT_BOOLEAN, 8, TFS(&tfs_csbk_group), 0x40, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_csbk_preamble_blocks_id, 
+      { "CSBK Blocks to Follow", "ipsc.csbk.preamble_blocks", FT_UINT8, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_csbk_grant_channel_id, 
+      { "Logical Physical Channel", "ipsc.csbk.grant_channel", FT_UINT16, BASE_DEC, NULL, 0xfff0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_csbk_grant_slot_id, 
+      { "Logical Slot", "ipsc.csbk.grant_slot", FT_UINT8, BASE_DEC, VALS(valstring_csbk_grant_slot), 0x08, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_csbk_grant_late_entry_id, 
+      { "Late Entry", "ipsc.csbk.grant_late_entry", FT_BOOLEAN, 8, NULL, 0x04, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_rpt_id, 
-      { "Rpt Id", "ipsc.src_id", FT_UINT32, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_csbk_grant_emergency_id, 
+      { "Emergency", "ipsc.csbk.grant_emergency", FT_BOOLEAN, 8, NULL, 0x02, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_linking_id, 
-      { "Linking", "ipsc.linking", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_csbk_grant_offset_id, 
+      { "Offset", "ipsc.csbk.grant_offset", FT_BOOLEAN, 8, NULL, 0x01, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_linking_peer_op_id, 
-      { "Peer Op", "ipsc.linking.peer_op", FT_UINT8, BASE_HEX, VALS(valstring_linking_peer_op), 0xc0, NULL, HFILL }
+    { &hf_ipsc_csbk_data_id, 
+      { "CSBK Data", "ipsc.csbk.data", FT_BYTES, BASE_NONE, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_linking_peer_mode_id, 
-      { "Peer Mode", "ipsc.linking.peer_mode", FT_UINT8, BASE_HEX, VALS(valstring_linking_peer_mode), 0x30, NULL, HFILL }
+    { &hf_ipsc_csbk_hdr_crc_good_id, 
+      { "Good", "ipsc.csbk_hdr_crc_good", FT_BOOLEAN, BASE_NONE, NULL, 0x0, "True: CRC matches the CSBK", HFILL }
     }
     ,
-    { &hf_ipsc_linking_ipsc_slot1_id, 
-      { "IPSC Slot 1", "ipsc.linking.ipsc_slot1", FT_UINT8, BASE_HEX, VALS(valstring_linking_ipsc_slot), 0x0c, NULL, HFILL }
+    { &hf_ipsc_csbk_hdr_crc_bad_id, 
+      { "Bad", "ipsc.csbk_hdr_crc_bad", FT_BOOLEAN, BASE_NONE, NULL, 0x0, "True: CRC does not match the CSBK", HFILL }
     }
     ,
-    { &hf_ipsc_linking_ipsc_slot2_id, 
-      { "IPSC Slot 2", "ipsc.linking.ipsc_slot2", FT_UINT8, BASE_HEX, VALS(valstring_linking_ipsc_slot), 0x03, NULL, HFILL }
+    { &hf_ipsc_full_lc_byte1_id, 
+      { "Full LC Byte 1", "ipsc.full_lc_byte1", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_service_flags_id, 
-      { "Service FLAGS", "ipsc.service_flags", FT_UINT32, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_full_lc_fid_id, 
+      { "Full LC FID", "ipsc.full_lc_fid", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_service_flags_byte1_id, 
-      { "BYTE 1", "ipsc.service_flags.byte1", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_voice_pdu_service_options_id, 
+      { "Voice PDU Service Options", "ipsc.voice_pdu_service_options", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_service_flags_byte2_id, 
-      { "BYTE 2", "ipsc.service_flags.byte2", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_voice_pdu_dst_id, 
+      { "Voice PDU Dst", "ipsc.voice_pdu_dst", FT_UINT24, BASE_DEC, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_service_flags_byte3_id, 
-      { "BYTE 3", "ipsc.service_flags.byte3", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_voice_pdu_src_id, 
+      { "Voice PDU Src", "ipsc.voice_pdu_src", FT_UINT24, BASE_DEC, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_service_flags_byte3_rdac_id, 
-      { "CSBK message", "ipsc.service_flags.byte3.csbk", FT_BOOLEAN, 8, NULL, 0x80, NULL, HFILL }
+    { &hf_ipsc_voice_burst_id, 
+      { "Voice Burst", "ipsc.voice.burst", FT_UINT8, BASE_DEC, VALS(valstring_voice_burst), 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_service_flags_byte3_unk1_id, 
-      { "Repeater call monitoring", "ipsc.service_flags.byte3.rpt_call_mon", FT_BOOLEAN, 8, TFS(&valstring_service_flags_rpt_call_mon), 0x40, NULL, HFILL }
+    { &hf_ipsc_voice_ambe_id, 
+      { "AMBE+2 Frame", "ipsc.voice.ambe", FT_BYTES, BASE_NONE, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_service_flags_byte3_3rdpy_id, 
-      { "3rd Party", "ipsc.service_flags.byte3.3rdpy", FT_BOOLEAN, 8, TFS(&valstring_service_flags_3rdpy), 0x20, NULL, HFILL }
+    { &hf_ipsc_voice_emb_id, 
+      { "EMB", "ipsc.voice.emb", FT_UINT16, BASE_HEX, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_service_flags_byte3_unk2_id, 
-      { "Unk2", "ipsc.service_flags.byte3.3rdpy", FT_UINT8, BASE_HEX, NULL, 0x1f, NULL, HFILL }
+    { &hf_ipsc_voice_emb_cc_id, 
+      { "Colour Code", "ipsc.voice.emb_cc", FT_UINT16, BASE_DEC, NULL, 0xf000, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_service_flags_byte4_id, 
-      { "BYTE 4", "ipsc.service_flags.byte4", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_voice_emb_pi_id, 
+      { "Privacy Indicator", "ipsc.voice.emb_pi", FT_BOOLEAN, 16, NULL, 0x0800, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_service_flags_byte4_xnl_conn_id, 
-      { "XNL connected", "ipsc.service_flags.byte4.xnl_conn", FT_BOOLEAN, 8, NULL, 0x80, NULL, HFILL }
+    { &hf_ipsc_voice_emb_lcss_id, 
+      { "LCSS", "ipsc.voice.emb_lcss", FT_UINT16, BASE_DEC, VALS(valstring_voice_lcss), 0x0600, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_service_flags_byte4_xnl_master_id, 
-      { "XNL Master Device", "ipsc.service_flags.byte4.xnl_master", FT_BOOLEAN, 8, NULL, 0x40, NULL, HFILL }
+    { &hf_ipsc_voice_emb_parity_id, 
+      { "QR Parity", "ipsc.voice.emb_parity", FT_UINT16, BASE_HEX, NULL, 0x01ff, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_service_flags_byte4_xnl_slave_id, 
-      { "XNL Slave Device", "ipsc.service_flags.byte4.xnl_slave", FT_BOOLEAN, 8, NULL, 0x20, NULL, HFILL }
+    { &hf_ipsc_voice_embedded_id, 
+      { "Embedded Signalling", "ipsc.voice.embedded", FT_UINT32, BASE_HEX, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_service_flags_byte4_auth_id, 
-      { "Authenticated packets", "ipsc.service_flags.byte4.auth", FT_BOOLEAN, 8, TFS(&valstring_service_flags_auth), 0x10, NULL, HFILL }
+    { &hf_ipsc_voice_emb_corrected_id, 
+      { "Bits Corrected", "ipsc.voice.emb_corrected", FT_UINT8, BASE_DEC, NULL, 0x0, "Bits QR(16,7,6) corrected in the EMB", HFILL }
     }
     ,
-    { &hf_ipsc_service_flags_byte4_voice_id, 
-      { "Voice enabled", "ipsc.service_flags.byte4.voice", FT_BOOLEAN, 8, TFS(&valstring_service_flags_voice), 0x08, NULL, HFILL }
+    { &hf_ipsc_emb_lc_id, 
+      { "Embedded LC", "ipsc.emb_lc", FT_BYTES, BASE_NONE, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_service_flags_byte4_data_id, 
-      { "Data enabled", "ipsc.service_flags.byte4.data", FT_BOOLEAN, 8, TFS(&valstring_service_flags_data), 0x04, NULL, HFILL }
+    { &hf_ipsc_emb_lc_checksum_good_id, 
+      { "Good", "ipsc.emb_lc.checksum_good", FT_BOOLEAN, BASE_NONE, NULL, 0x0, "True: checksum matches the embedded LC", HFILL }
     }
     ,
-    { &hf_ipsc_service_flags_byte4_unk2_id, 
-      { "Unk 2", "ipsc.service_flags.byte4.unk2", FT_BOOLEAN, 8, TFS(&valstring_service_flags_unk2), 0x02, NULL, HFILL }
+    { &hf_ipsc_emb_lc_checksum_bad_id, 
+      { "Bad", "ipsc.emb_lc.checksum_bad", FT_BOOLEAN, BASE_NONE, NULL, 0x0, "True: checksum does not match the embedded LC", HFILL }
     }
     ,
-    { &hf_ipsc_service_flags_byte4_master_id, 
-      { "Master", "ipsc.service_flags.byte4.master", FT_BOOLEAN, 8, TFS(&valstring_service_flags_master), 0x01, NULL, HFILL }
+    { &hf_ipsc_emb_lc_first_frame_id, 
+      { "First Fragment in Frame", "ipsc.emb_lc.first_frame", FT_FRAMENUM, BASE_NONE, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_version_id, 
-      { "Version", "ipsc.version", FT_UINT32, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_emb_lc_corrected_id, 
+      { "Bits Corrected", "ipsc.emb_lc.corrected", FT_UINT8, BASE_DEC, NULL, 0x0, "Bits Hamming(16,11,4) corrected in the embedded LC", HFILL }
     }
     ,
-    { &hf_ipsc_seq_no_id, 
-      { "Seq No", "ipsc.seq_no", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_burst_slot_type_id, 
+      { "Slot Type", "ipsc.burst.slot_type", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_src_id, 
-      { "Src Id", "ipsc.src_id", FT_UINT24, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_burst_slot_type_cc_id, 
+      { "Colour Code", "ipsc.burst.slot_type_cc", FT_UINT8, BASE_DEC, NULL, 0xf0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_dst_id, 
-      { "Dst Id", "ipsc.dst_id", FT_UINT24, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_burst_slot_type_data_type_id, 
+      { "Data Type", "ipsc.burst.slot_type_data_type", FT_UINT8, BASE_HEX, VALS(valstring_data_type), 0x0f, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_prio_v_d_id, 
-      { "Priority Voice/Data", "ipsc.prio_v_d", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_burst_slot_type_corrected_id, 
+      { "Bits Corrected", "ipsc.burst.slot_type_corrected", FT_UINT8, BASE_DEC, NULL, 0x0, "Bits Golay(20,8) corrected in the slot type", HFILL }
     }
     ,
-    { &hf_ipsc_call_ctrl_id, 
-      { "Call Ctrl", "ipsc.call_ctrl", FT_UINT32, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_burst_info_id, 
+      { "Burst Data", "ipsc.burst.info", FT_BYTES, BASE_NONE, NULL, 0x0, "The 96 bits of BPTC(196,96), corrected", HFILL }
     }
     ,
-    { &hf_ipsc_call_ctrl_info_id, 
-      { "Call Ctrl Info", "ipsc.call_ctrl_info", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_burst_bptc_corrected_id, 
+      { "Bits Corrected", "ipsc.burst.bptc_corrected", FT_UINT8, BASE_DEC, NULL, 0x0, "Bits BPTC(196,96) corrected in the burst", HFILL }
     }
     ,
-    { &hf_ipsc_call_ctrl_src_id, 
-      { "Call Ctrl Src", "ipsc.call_ctrl_src", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_digest_id, 
+      { "Auth Digest", "ipsc.digest", FT_BYTES, BASE_NONE, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_payload_type_id, 
-      { "Payload Type", "ipsc.payload_type", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_digest_good_id, 
+      { "Good", "ipsc.digest_good", FT_BOOLEAN, BASE_NONE, NULL, 0x0, "True: digest matches a configured key", HFILL }
     }
     ,
-    { &hf_ipsc_call_seq_no_id, 
-      { "Call Seq No", "ipsc.call_seq_no", FT_UINT16, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_digest_bad_id, 
+      { "Bad", "ipsc.digest_bad", FT_BOOLEAN, BASE_NONE, NULL, 0x0, "True: digest does not match any configured key", HFILL }
     }
     ,
-    { &hf_ipsc_timestamp_id, 
-      { "Timestamp", "ipsc.timestamp", FT_UINT32, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_digest_key_id, 
+      { "Matching Key", "ipsc.digest_key", FT_UINT8, BASE_DEC, NULL, 0x0, "Position of the matching key in the preference", HFILL }
     }
     ,
-    { &hf_ipsc_sync_src_id, 
-      { "Sync Src", "ipsc.sync_src", FT_UINT32, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_xcmp_xnl_length_id, 
+      { "XCMP/XNL Length", "ipsc.xcmp_xnl_length", FT_UINT16, BASE_DEC, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_data_type_voice_hdr_id, 
-      { "Data Type Voice Hdr", "ipsc.data_type_voice_hdr", FT_UINT8, BASE_HEX, VALS(valstring_data_type), 0x0, NULL, HFILL }
+    { &hf_ipsc_xcmp_xnl_data_id, 
+      { "XCMP/XNL Data", "ipsc.xcmp_xnl_data", FT_BYTES, BASE_NONE, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_rssi_threshold_and_parity_id, 
-      { "RSSI Threshold and Parity", "ipsc.rssi_threshold_and_parity", FT_UINT8, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_xnl_id, 
+      { "XNL", "ipsc.xnl", FT_NONE, BASE_NONE, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_length_to_follow_id, 
-      { "Length to Follow - in 2byte words", "ipsc.length_to_follow", FT_UINT16, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_xnl_opcode_id, 
+      { "XNL Opcode", "ipsc.xnl.opcode", FT_UINT16, BASE_HEX, VALS(valstring_xnl_opcode), 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_length_to_follow2_id, 
-      { "Length to Follow 2 - in bytes", "ipsc.length_to_follow2", FT_UINT8, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_xnl_proto_id, 
+      { "XNL Protocol", "ipsc.xnl.proto", FT_UINT8, BASE_HEX, VALS(valstring_xnl_proto), 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_rssi_status_id, 
-      { "RSSI Status", "ipsc.rssi_status", FT_UINT8, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_xnl_flags_id, 
+      { "XNL Flags", "ipsc.xnl.flags", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_slot_type_sync_id, 
-      { "Slot Type Sync", "ipsc.slot_type_sync", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_xnl_dst_id, 
+      { "XNL Destination", "ipsc.xnl.dst", FT_UINT16, BASE_DEC, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_data_size_id, 
-      { "Data Size", "ipsc.data_size", FT_UINT16, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_xnl_src_id, 
+      { "XNL Source", "ipsc.xnl.src", FT_UINT16, BASE_DEC, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_data_id, 
-      { "Data", "ipsc.data", FT_BYTES, BASE_NONE, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_xnl_trans_id_id, 
+      { "XNL Transaction Id", "ipsc.xnl.transaction_id", FT_UINT16, BASE_HEX, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_data_hdr_byte1_id, 
-      { "Data Hdr Byte 1", "ipsc.data_hdr_byte1", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_xnl_payload_len_id, 
+      { "XNL Payload Length", "ipsc.xnl.length", FT_UINT16, BASE_DEC, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_data_hdr_byte1_gi_id, 
-      { "Group / Individual call", "ipsc.data_hdr.byte1_gi", FT_BOOLEAN, 8, NULL, 0x80, NULL, HFILL }
+    { &hf_ipsc_xnl_piece_id, 
+      { "XNL Piece", "ipsc.xnl.piece", FT_UINT8, BASE_DEC, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_data_hdr_byte1_a_id, 
-      { "Acknowledge requested", "ipsc.data_hdr.byte1_a", FT_BOOLEAN, 8, NULL, 0x40, NULL, HFILL }
+    { &hf_ipsc_xnl_first_frame_id, 
+      { "XNL First Piece In", "ipsc.xnl.first_frame", FT_FRAMENUM, BASE_NONE, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_data_hdr_byte1_hc_id, 
-      { "Header Compression (HC)", "ipsc.data_hdr.byte1_hc", FT_BOOLEAN, 8, NULL, 0x20, NULL, HFILL }
+    { &hf_ipsc_xnl_reassembled_in_id, 
+      { "XNL Reassembled In", "ipsc.xnl.reassembled_in", FT_FRAMENUM, BASE_NONE, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_data_hdr_byte1_pocmsb_id, 
-      { "Packet Octet Count(POC) MSB", "ipsc.data_hdr.byte1_pocmsb", FT_BOOLEAN, 8, NULL, 0x10, NULL, HFILL }
+    { &hf_ipsc_xcmp_opcode_id, 
+      { "XCMP Opcode", "ipsc.xcmp.opcode", FT_UINT16, BASE_HEX, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_data_hdr_byte1_dpf_id, 
-      { "Data Packet Format (DPF)", "ipsc.data_hdr.byte1_dpf", FT_UINT8, BASE_HEX, VALS(valstring_data_packet_format), 0x0f, NULL, HFILL }
+    { &hf_ipsc_xcmp_type_id, 
+      { "XCMP Type", "ipsc.xcmp.type", FT_UINT16, BASE_HEX, VALS(valstring_xcmp_type), 0xf000, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_data_hdr_byte2_id, 
-      { "Data Hdr Byte 2", "ipsc.data_hdr_byte2", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_xcmp_message_id, 
+      { "XCMP Message", "ipsc.xcmp.message", FT_UINT16, BASE_HEX, VALS(valstring_xcmp_message), 0x0fff, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_data_hdr_byte2_sap_id, 
-      { "Service Access Point (SAP)", "ipsc.data_hdr.byte2_sap", FT_UINT8, BASE_HEX, VALS(valstring_service_access_point), 0xf0, NULL, HFILL }
+    { &hf_ipsc_xcmp_data_id, 
+      { "XCMP Data", "ipsc.xcmp.data", FT_BYTES, BASE_NONE, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_data_hdr_byte2_poc_id, 
-      { "Packet Octet Count (POC)", "ipsc.data_hdr.byte2_poc", FT_UINT8, BASE_DEC, NULL, 0x0f, NULL, HFILL }
+    { &hf_ipsc_xcmp_response_in_id, 
+      { "XCMP Response In", "ipsc.xcmp.response_in", FT_FRAMENUM, BASE_NONE, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_data_hdr_dst_id, 
-      { "Data Hdr Dst", "ipsc.data_hdr_dst", FT_UINT24, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_xcmp_response_to_id, 
+      { "XCMP Response To", "ipsc.xcmp.response_to", FT_FRAMENUM, BASE_NONE, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_data_hdr_src_id, 
-      { "Data Hdr Src", "ipsc.data_hdr_src", FT_UINT24, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_xcmp_time_id, 
+      { "XCMP Response Time", "ipsc.xcmp.time", FT_RELATIVE_TIME, BASE_NONE, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_data_hdr_byte8_id, 
-      { "Data Hdr Byte 8", "ipsc.data_hdr_byte8", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_unk1_id, 
+      { "Unk_1_Byte", "ipsc.unk1", FT_BYTES, BASE_NONE, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_data_hdr_byte8_f_id, 
-      { "Full Message Flag (F)", "ipsc.data_hdr.byte8_f", FT_BOOLEAN, 8, NULL, 0x80, NULL, HFILL }
+    { &hf_ipsc_call_id, 
+      { "Call Id", "ipsc.call.id", FT_UINT32, BASE_DEC, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_data_hdr_byte8_btf_id, 
-      { "Blocks to Follow (BF)", "ipsc.data_hdr.byte8_btf", FT_UINT8, BASE_DEC, NULL, 0x7f, NULL, HFILL }
+    { &hf_ipsc_call_start_frame_id, 
+      { "Call Start Frame", "ipsc.call.start_frame", FT_FRAMENUM, BASE_NONE, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_data_hdr_byte9_id, 
-      { "Data Hdr Byte 9", "ipsc.data_hdr_byte9", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_call_end_frame_id, 
+      { "Call End Frame", "ipsc.call.end_frame", FT_FRAMENUM, BASE_NONE, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_data_hdr_byte9_s_id, 
-      { "Re-Synchronize flag (S)", "ipsc.data_hdr_byte9_s", FT_BOOLEAN, 8, NULL, 0x80, NULL, HFILL }
+    { &hf_ipsc_call_duration_id, 
+      { "Call Duration", "ipsc.call.duration", FT_RELATIVE_TIME, BASE_NONE, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_data_hdr_byte9_ns_id, 
-      { "Send sequence Number N(S)", "ipsc.data_hdr_byte9_ns", FT_UINT8, BASE_DEC, NULL, 0x70, NULL, HFILL }
+    { &hf_ipsc_call_time_id, 
+      { "Time since Call Start", "ipsc.call.time", FT_RELATIVE_TIME, BASE_NONE, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_data_hdr_byte9_fsn_id, 
-      { "Fragment Sequence Number (FSN)", "ipsc.data_hdr_byte9_fsn", FT_UINT8, BASE_DEC, NULL, 0x0f, NULL, HFILL }
+    { &hf_ipsc_call_packet_index_id, 
+      { "Packet Index in Call", "ipsc.call.packet_index", FT_UINT32, BASE_DEC, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_data_hdr_byte9_nibble1_id, 
-      { "Nibble1", "ipsc.data_hdr_byte9_nibble1", FT_UINT8, BASE_DEC, NULL, 0xf0, NULL, HFILL }
+    { &hf_ipsc_call_late_entry_id, 
+      { "Late Entry", "ipsc.call.late_entry", FT_BOOLEAN, BASE_NONE, NULL, 0x0, "True: the call was picked up from its embedded LC", HFILL }
     }
-
     ,
-    { &hf_ipsc_data_hdr_crc_id, 
-      { "Data Hdr CRC", "ipsc.data_hdr_crc", FT_UINT16, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_data_block_id, 
+      { "Data Block", "ipsc.data.block", FT_UINT8, BASE_DEC, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_csbk_hdr_byte1_id, 
-      { "CSBK Hdr Byte 1", "ipsc.csbk_hdr_byte1", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_data_blocks_id, 
+      { "Data Blocks in Transfer", "ipsc.data.blocks", FT_UINT8, BASE_DEC, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_csbk_hdr_fid_id, 
-      { "CSBK Hdr FID", "ipsc.csbk_hdr_fid", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_data_header_frame_id, 
+      { "Data Header in Frame", "ipsc.data.header_frame", FT_FRAMENUM, BASE_NONE, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_csbk_hdr_byte3_id, 
-      { "CSBK Hdr Byte 3", "ipsc.csbk_hdr_byte3", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_data_reassembled_in_id, 
+      { "Reassembled in Frame", "ipsc.data.reassembled_in", FT_FRAMENUM, BASE_NONE, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_csbk_hdr_byte4_id, 
-      { "CSBK Hdr Byte 4", "ipsc.csbk_hdr_byte4", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_data_reassembled_length_id, 
+      { "Reassembled Length", "ipsc.data.reassembled.length", FT_UINT32, BASE_DEC, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_csbk_hdr_dst_id, 
-      { "CSBK Hdr Dst", "ipsc.csbk_hdr_dst", FT_UINT24, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_data_hc_status_id, 
+      { "Header Decompression", "ipsc.data.hc_status", FT_UINT8, BASE_DEC, VALS(valstring_hc_status), 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_csbk_hdr_src_id, 
-      { "CSBK Hdr Src", "ipsc.csbk_hdr_src", FT_UINT24, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_analysis_id, 
+      { "Stream Analysis", "ipsc.analysis", FT_NONE, BASE_NONE, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_csbk_hdr_crc_id, 
-      { "CSBK Hdr CRC", "ipsc.csbk_hdr_crc", FT_UINT16, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_analysis_delta_id, 
+      { "Delta (ms)", "ipsc.analysis.delta", FT_DOUBLE, BASE_NONE, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_full_lc_byte1_id, 
-      { "Full LC Byte 1", "ipsc.full_lc_byte1", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_analysis_jitter_id, 
+      { "Jitter (ms)", "ipsc.analysis.jitter", FT_DOUBLE, BASE_NONE, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_full_lc_fid_id, 
-      { "Full LC FID", "ipsc.full_lc_fid", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_analysis_lost_id, 
+      { "Lost before this packet", "ipsc.analysis.lost", FT_UINT16, BASE_DEC, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_voice_pdu_service_options_id, 
-      { "Voice PDU Service Options", "ipsc.voice_pdu_service_options", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_analysis_duplicate_id, 
+      { "Duplicate", "ipsc.analysis.duplicate", FT_BOOLEAN, BASE_NONE, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_voice_pdu_dst_id, 
-      { "Voice PDU Dst", "ipsc.voice_pdu_dst", FT_UINT24, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_analysis_out_of_order_id, 
+      { "Out of order", "ipsc.analysis.out_of_order", FT_BOOLEAN, BASE_NONE, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_voice_pdu_src_id, 
-      { "Voice PDU Src", "ipsc.voice_pdu_src", FT_UINT24, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_analysis_stream_received_id, 
+      { "Stream Packets Received", "ipsc.analysis.stream.received", FT_UINT32, BASE_DEC, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_digest_id, 
-      { "Auth Digest", "ipsc.digest", FT_BYTES, BASE_NONE, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_analysis_stream_lost_id, 
+      { "Stream Packets Lost", "ipsc.analysis.stream.lost", FT_UINT32, BASE_DEC, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_xcmp_xnl_length_id, 
-      { "XCMP/XNL Length", "ipsc.xcmp_xnl_length", FT_UINT16, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_analysis_stream_duplicates_id, 
+      { "Stream Duplicates", "ipsc.analysis.stream.duplicates", FT_UINT32, BASE_DEC, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_xcmp_xnl_data_id, 
-      { "XCMP/XNL Data", "ipsc.xcmp_xnl_data", FT_BYTES, BASE_NONE, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_analysis_stream_out_of_order_id, 
+      { "Stream Out of Order", "ipsc.analysis.stream.out_of_order", FT_UINT32, BASE_DEC, NULL, 0x0, NULL, HFILL }
     }
     ,
-    { &hf_ipsc_unk1_id, 
-      { "Unk_1_Byte", "ipsc.unk1", FT_BYTES, BASE_NONE, NULL, 0x0, NULL, HFILL }
+    { &hf_ipsc_analysis_stream_max_jitter_id, 
+      { "Stream Max Jitter (ms)", "ipsc.analysis.stream.max_jitter", FT_DOUBLE, BASE_NONE, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_airtime_id, 
+      { "Airtime", "ipsc.airtime", FT_NONE, BASE_NONE, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_airtime_slot_id, 
+      { "Timeslot", "ipsc.airtime.slot", FT_UINT8, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_airtime_added_id, 
+      { "Busy Time Added (s)", "ipsc.airtime.added", FT_DOUBLE, BASE_NONE, NULL, 0x0,
+        "Sum it in an I/O graph for the busy time per interval", HFILL }
+    }
+    ,
+    { &hf_ipsc_airtime_slot_busy_id, 
+      { "Slot Busy Time (s)", "ipsc.airtime.slot_busy", FT_DOUBLE, BASE_NONE, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_airtime_slot_utilization_id, 
+      { "Slot Utilization (%)", "ipsc.airtime.utilization", FT_DOUBLE, BASE_NONE, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_airtime_slot_calls_id, 
+      { "Calls on Slot", "ipsc.airtime.calls", FT_UINT32, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_rssi_id, 
+      { "RSSI", "ipsc.rssi", FT_NONE, BASE_NONE, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_rssi_dbm_id, 
+      { "RSSI (dBm)", "ipsc.rssi.dbm", FT_INT32, BASE_DEC, NULL, 0x0,
+        "RSSI Status in dBm; AVG, MIN and MAX of it in an I/O graph give the level per interval", HFILL }
+    }
+    ,
+    { &hf_ipsc_rssi_threshold_dbm_id, 
+      { "RSSI Threshold (dBm)", "ipsc.rssi.threshold", FT_INT32, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_rssi_interval_start_id, 
+      { "Interval Start", "ipsc.rssi.interval_start", FT_ABSOLUTE_TIME, ABSOLUTE_TIME_LOCAL, NULL, 0x0,
+        "Start of the RSSI interval of this repeater, timeslot and radio", HFILL }
+    }
+    ,
+    { &hf_ipsc_rssi_interval_count_id, 
+      { "Interval Samples", "ipsc.rssi.interval_count", FT_UINT32, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_rssi_interval_min_id, 
+      { "Interval Min (dBm)", "ipsc.rssi.interval_min", FT_INT32, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_rssi_interval_avg_id, 
+      { "Interval Avg (dBm)", "ipsc.rssi.interval_avg", FT_DOUBLE, BASE_NONE, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_rssi_interval_max_id, 
+      { "Interval Max (dBm)", "ipsc.rssi.interval_max", FT_INT32, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_rr_response_in_id, 
+      { "Response In", "ipsc.rr.response_in", FT_FRAMENUM, BASE_NONE, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_rr_response_to_id, 
+      { "Response To", "ipsc.rr.response_to", FT_FRAMENUM, BASE_NONE, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_rr_time_id, 
+      { "Round Trip Time", "ipsc.rr.time", FT_RELATIVE_TIME, BASE_NONE, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_rr_unanswered_id, 
+      { "Unanswered Keepalive", "ipsc.rr.unanswered", FT_FRAMENUM, BASE_NONE, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_rr_missed_id, 
+      { "Missed Keepalives in a Row", "ipsc.rr.missed", FT_UINT8, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_rr_peer_event_id, 
+      { "Peer Event", "ipsc.rr.peer_event", FT_UINT8, BASE_DEC, VALS(valstring_peer_event), 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_peer_list_length_id, 
+      { "Peer List Length", "ipsc.peer_list.length", FT_UINT16, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_peer_list_same_as_id, 
+      { "Same List As", "ipsc.peer_list.same_as", FT_FRAMENUM, BASE_NONE, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_peer_id, 
+      { "Peer", "ipsc.peer", FT_NONE, BASE_NONE, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_peer_rpt_id_id, 
+      { "Peer Rpt Id", "ipsc.peer.rpt_id", FT_UINT32, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_peer_ip_id, 
+      { "Peer IP", "ipsc.peer.ip", FT_IPv4, BASE_NONE, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_peer_port_id, 
+      { "Peer Port", "ipsc.peer.port", FT_UINT16, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_peer_linking_id, 
+      { "Peer Linking", "ipsc.peer.linking", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_peer_table_id, 
+      { "Listed Peer", "ipsc.peer_table", FT_NONE, BASE_NONE, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_peer_table_ip_id, 
+      { "Listed IP", "ipsc.peer_table.ip", FT_IPv4, BASE_NONE, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_peer_table_port_id, 
+      { "Listed Port", "ipsc.peer_table.port", FT_UINT16, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_peer_table_linking_id, 
+      { "Listed Linking", "ipsc.peer_table.linking", FT_UINT8, BASE_HEX, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_peer_table_master_id, 
+      { "Listed by Master", "ipsc.peer_table.master", FT_UINT32, BASE_DEC, NULL, 0x0, NULL, HFILL }
+    }
+    ,
+    { &hf_ipsc_peer_table_listed_in_id, 
+      { "Listed in Frame", "ipsc.peer_table.listed_in", FT_FRAMENUM, BASE_NONE, NULL, 0x0, NULL, HFILL }
     }
   };
 
   static gint *ett[] = {
-    &ett_ipsc
+    &ett_ipsc,
+    &ett_ipsc_call,
+    &ett_ipsc_analysis,
+    &ett_ipsc_airtime,
+    &ett_ipsc_rssi,
+    &ett_ipsc_peer,
+    &ett_ipsc_digest,
+    &ett_ipsc_xnl,
+    &ett_ipsc_crc,
+    &ett_ipsc_voice,
+    &ett_ipsc_fec
   };
 
   proto_ipsc = proto_register_protocol("MotoTrbo IP Site Connect",
@@ -1213,15 +5326,84 @@ proto_register_ipsc(void)
   proto_register_field_array(proto_ipsc, hf, array_length(hf));
   proto_register_subtree_array(ett, array_length(ett));
 
+  ipsc_module = prefs_register_protocol(proto_ipsc, proto_reg_handoff_ipsc);
+
+  range_convert_str(&global_ipsc_port_range, IPSC_DEFAULT_PORT_RANGE, 65535);
+  prefs_register_range_preference(ipsc_module, "udp.ports",
+                                  "UDP ports",
+                                  "UDP ports of IPSC masters and peers (default " IPSC_DEFAULT_PORT_RANGE ")",
+                                  &global_ipsc_port_range, 65535);
+  prefs_register_bool_preference(ipsc_module, "try_heuristic",
+                                 "Try to detect IPSC on other UDP ports",
+                                 "Check the opcode and length of UDP packets on ports outside the range above",
+                                 &ipsc_try_heuristic);
+  prefs_register_uint_preference(ipsc_module, "cai_network",
+                                 "CAI network",
+                                 "First octet of radio IP addresses, used to rebuild compressed UDP/IP headers",
+                                 10, &ipsc_cai_network);
+  prefs_register_uint_preference(ipsc_module, "cai_group_network",
+                                 "CAI group network",
+                                 "First octet of group IP addresses, used to rebuild compressed UDP/IP headers",
+                                 10, &ipsc_cai_group_network);
+  prefs_register_string_preference(ipsc_module, "auth_keys",
+                                   "Authentication keys",
+                                   "Comma separated list of hex network keys (up to 40 digits each) "
+                                   "used to verify the Auth Digest",
+                                   &ipsc_auth_keys_pref);
+  prefs_register_uint_preference(ipsc_module, "rssi_interval",
+                                 "RSSI interval (s)",
+                                 "Length of the RSSI min/avg/max buckets per repeater, timeslot and radio",
+                                 10, &ipsc_rssi_interval);
+
   register_dissector("ipsc", dissect_ipsc, proto_ipsc);
+
+  ipsc_tap = register_tap("ipsc");
+
+  register_init_routine(ipsc_init_protocol);
+
+  ipsc_fields_register(ipsc_call_fields, array_length(ipsc_call_fields));
+  ipsc_fields_register(ipsc_short_fields, array_length(ipsc_short_fields));
+  ipsc_fields_register(ipsc_call_ctl_1_fields, array_length(ipsc_call_ctl_1_fields));
+  ipsc_fields_register(ipsc_call_ctl_2_fields, array_length(ipsc_call_ctl_2_fields));
+  ipsc_fields_register(ipsc_call_ctl_3_fields, array_length(ipsc_call_ctl_3_fields));
+  ipsc_fields_register(ipsc_xcmp_xnl_fields, array_length(ipsc_xcmp_xnl_fields));
+
+  for (i = 0; i < array_length(ipsc_layouts); i++)
+    ipsc_layout_by_opcode[ipsc_layouts[i].opcode] = &ipsc_layouts[i];
+
+  for (i = 0; i < array_length(ipsc_csbk_types); i++)
+    ipsc_csbk_by_opcode[ipsc_csbk_fid_set(ipsc_csbk_types[i].fid)][ipsc_csbk_types[i].csbko] = &ipsc_csbk_types[i];
 }
 
 void
 proto_reg_handoff_ipsc(void)
 {
-  dissector_handle_t ipsc_handle;
+  static gboolean ipsc_initialized = FALSE;
+  static dissector_handle_t ipsc_handle;
+  static range_t *ipsc_port_range;
+
+  if (!ipsc_initialized)
+  {
+    ipsc_handle = find_dissector("ipsc");
+    ip_handle = find_dissector("ip");
+    data_handle = find_dissector("data");
+
+    heur_dissector_add("udp", dissect_ipsc_heur, proto_ipsc);
+
+    stats_tree_register("ipsc", "ipsc", "IPSC/Packet Counter", 0,
+                        ipsc_stats_tree_packet, ipsc_stats_tree_init, NULL);
+
+    ipsc_initialized = TRUE;
+  }
+  else
+  {
+    dissector_delete_uint_range("udp.port", ipsc_port_range, ipsc_handle);
+    g_free(ipsc_port_range);
+  }
 
-  ipsc_handle = find_dissector("ipsc");
+  ipsc_port_range = range_copy(global_ipsc_port_range);
+  dissector_add_uint_range("udp.port", ipsc_port_range, ipsc_handle);
 
-  dissector_add_uint("udp.port", 51001, ipsc_handle);
+  /* Also the preferences callback, the keys may have changed */
+  ipsc_auth_prepare_keys();
 }
@@ -26,4 +26,63 @@
 #ifndef __PACKET_IPSC_H__
 #define __PACKET_IPSC_H__
 
+/* ipsc_info_t stream_flags */
+#define IPSC_STREAM_SEQ_GAP         0x01
+#define IPSC_STREAM_DUPLICATE       0x02
+#define IPSC_STREAM_OUT_OF_ORDER    0x04
+
+/* ipsc_info_t peer_event, about the requester */
+#define IPSC_PEER_EVENT_NONE        0
+#define IPSC_PEER_EVENT_JOIN        1
+#define IPSC_PEER_EVENT_LEAVE       2
+
+/*
+ * Per packet summary handed to the "ipsc" tap. It is decoded
+ * without a tree, so it is available on every pass.
+ */
+typedef struct _ipsc_info_t {
+    guint8   opcode;
+    guint32  rpt_id;
+    guint32  length;        /* bytes of IPSC payload */
+    /* Only valid when is_call is set (GROUP_VOICE, GROUP_DATA, PVT_DATA) */
+    gboolean is_call;
+    guint32  src_id;
+    guint32  dst_id;
+    guint8   slot;          /* 1 or 2 */
+    guint16  call_seq_no;
+    guint32  timestamp;
+    guint8   data_type;
+    /* CSBK, only valid when data_type is 0x03 */
+    guint8   csbko;
+    guint8   csbk_fid;
+    /* Voice burst, a GROUP_VOICE of data type Rate 1 */
+    gboolean is_voice;
+    guint8   voice_burst;   /* 0 (A) to 5 (F) */
+    /* FEC of raw bursts and of the EMB of voice bursts B to E */
+    gboolean fec_checked;
+    guint16  fec_corrected; /* bits */
+    gboolean fec_failed;    /* more errors than a code corrects */
+    /* RSSI Status and Threshold, not on voice bursts */
+    gboolean has_rssi;
+    gint16   rssi;          /* dBm */
+    gint16   rssi_threshold;    /* dBm, 0 if not set */
+    /* Call tracking and stream analysis, call_id is 0 outside of a call */
+    guint32  call_id;
+    guint8   stream_flags;
+    guint16  lost;          /* packets missing right before this one */
+    gdouble  jitter;        /* ms */
+    /* Airtime accounting, also valid for call packets outside of a known call */
+    gdouble  airtime;       /* s of slot busy time this packet adds */
+    gboolean call_start;    /* opens a voice call or a data transfer */
+    gboolean group;         /* talkgroup call, from the Full LC or the Data Header */
+    gboolean data_last_block;   /* completes the data PDU of its Data Header */
+    /* Registration and keepalives (0x90 to 0x9b) */
+    guint8   linking;       /* 0x90, 0x91, 0x94 to 0x99 */
+    guint8   service_flags4;
+    guint32  request_rpt_id;    /* on a reply matched to its request, 0 otherwise */
+    gdouble  rtt;           /* ms, on a matched reply */
+    guint8   missed;        /* on a request, keepalives in a row left unanswered */
+    guint8   peer_event;    /* IPSC_PEER_EVENT_xxx */
+} ipsc_info_t;
+
 #endif /* packet-ipsc.h */
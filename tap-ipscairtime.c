@@ -0,0 +1,182 @@
+/* tap-ipscairtime.c
+ * IPSC airtime per repeater and timeslot for tshark, -z ipsc,airtime
+ *
+ * Wireshark - Network traffic analyzer
+ * By Gerald Combs <gerald@wireshark.org>
+ * Copyright 1998 Gerald Combs
+ *
+ * Copyright by Bogdan Diaconesc yo3iiu@yo3iiu.ro
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <glib.h>
+
+#include <epan/packet.h>
+#include <epan/tap.h>
+#include <epan/stat_cmd_args.h>
+#include <epan/dissectors/packet-ipsc.h>
+
+/* One line of the table, per repeater and timeslot */
+typedef struct _ipsc_slot_airtime_t {
+    guint64 key;            /* rpt_id << 8 | slot */
+    guint32 rpt_id;
+    guint8  slot;
+    guint32 calls;          /* voice calls and data transfers started */
+    guint32 packets;
+    gdouble busy;           /* s */
+} ipsc_slot_airtime_t;
+
+typedef struct _ipsc_airtime_t {
+    GHashTable *slots;      /* key -> ipsc_slot_airtime_t */
+    gboolean seen;
+    nstime_t first_time;
+    nstime_t last_time;
+} ipsc_airtime_t;
+
+static ipsc_airtime_t ipsc_airtime;
+
+static void
+ipsc_airtime_reset(void *arg)
+{
+    ipsc_airtime_t *tapinfo = (ipsc_airtime_t *)arg;
+
+    if (tapinfo->slots)
+      g_hash_table_destroy(tapinfo->slots);
+
+    /* The key lives in the line */
+    tapinfo->slots = g_hash_table_new_full(g_int64_hash, g_int64_equal, NULL, g_free);
+    tapinfo->seen = FALSE;
+}
+
+static int
+ipsc_airtime_packet(void *arg, packet_info *pinfo, epan_dissect_t *edt _U_, const void *data)
+{
+    ipsc_airtime_t *tapinfo = (ipsc_airtime_t *)arg;
+    const ipsc_info_t *ipsc_info = (const ipsc_info_t *)data;
+    ipsc_slot_airtime_t *line;
+    guint64 key;
+
+    /* The span covers all IPSC traffic, keepalives included */
+    if (!tapinfo->seen)
+    {
+      tapinfo->seen = TRUE;
+      tapinfo->first_time = pinfo->fd->abs_ts;
+    }
+    tapinfo->last_time = pinfo->fd->abs_ts;
+
+    if (!ipsc_info->is_call)
+      return 0;
+
+    key = ((guint64)ipsc_info->rpt_id << 8) | ipsc_info->slot;
+    line = (ipsc_slot_airtime_t *)g_hash_table_lookup(tapinfo->slots, &key);
+    if (!line)
+    {
+      line = g_new0(ipsc_slot_airtime_t, 1);
+      line->key = key;
+      line->rpt_id = ipsc_info->rpt_id;
+      line->slot = ipsc_info->slot;
+      g_hash_table_insert(tapinfo->slots, &line->key, line);
+    }
+
+    line->packets++;
+    line->busy += ipsc_info->airtime;
+    if (ipsc_info->call_start)
+      line->calls++;
+
+    return 0;
+}
+
+static gint
+ipsc_airtime_compare(gconstpointer a, gconstpointer b)
+{
+    const ipsc_slot_airtime_t *line_a = *(const ipsc_slot_airtime_t * const *)a;
+    const ipsc_slot_airtime_t *line_b = *(const ipsc_slot_airtime_t * const *)b;
+
+    if (line_a->key != line_b->key)
+      return (line_a->key < line_b->key) ? -1 : 1;
+    return 0;
+}
+
+static void
+ipsc_airtime_add_line(gpointer key _U_, gpointer value, gpointer user_data)
+{
+    g_ptr_array_add((GPtrArray *)user_data, value);
+}
+
+static void
+ipsc_airtime_draw(void *arg)
+{
+    ipsc_airtime_t *tapinfo = (ipsc_airtime_t *)arg;
+    ipsc_slot_airtime_t *line;
+    GPtrArray *lines;
+    nstime_t elapsed;
+    gdouble span = 0;
+    guint i;
+
+    if (tapinfo->seen)
+    {
+      nstime_delta(&elapsed, &tapinfo->last_time, &tapinfo->first_time);
+      span = nstime_to_sec(&elapsed);
+    }
+
+    lines = g_ptr_array_new();
+    g_hash_table_foreach(tapinfo->slots, ipsc_airtime_add_line, lines);
+    g_ptr_array_sort(lines, ipsc_airtime_compare);
+
+    printf("========================= IPSC Airtime ================================\n");
+    printf("Capture span: %.3f s\n", span);
+    printf("%10s %2s %7s %9s %12s %8s\n", "Rpt Id", "TS", "Calls", "Pkts", "Busy(s)", "Util(%)");
+
+    for (i = 0; i < lines->len; i++)
+    {
+      line = (ipsc_slot_airtime_t *)g_ptr_array_index(lines, i);
+
+      printf("%10u %2u %7u %9u %12.3f %8.2f\n",
+             line->rpt_id, line->slot, line->calls, line->packets, line->busy,
+             (span > 0 && line->busy < span) ? 100.0 * line->busy / span : (line->busy > 0 ? 100.0 : 0.0));
+    }
+    printf("=======================================================================\n");
+
+    g_ptr_array_free(lines, TRUE);
+}
+
+static void
+ipsc_airtime_init(const char *optarg _U_, void *userdata _U_)
+{
+    GString *err_p;
+
+    ipsc_airtime_reset(&ipsc_airtime);
+
+    err_p = register_tap_listener("ipsc", &ipsc_airtime, NULL, 0,
+                                  ipsc_airtime_reset, ipsc_airtime_packet, ipsc_airtime_draw);
+    if (err_p != NULL)
+    {
+      fprintf(stderr, "tshark: Couldn't register ipsc,airtime tap: %s\n", err_p->str);
+      g_string_free(err_p, TRUE);
+      exit(1);
+    }
+}
+
+void
+register_tap_listener_ipsc_airtime(void)
+{
+    register_stat_cmd_arg("ipsc,airtime", ipsc_airtime_init, NULL);
+}
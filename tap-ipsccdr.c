@@ -0,0 +1,302 @@
+/* tap-ipsccdr.c
+ * IPSC call detail records for tshark, -z ipsc,cdr[,csv|json]
+ *
+ * Wireshark - Network traffic analyzer
+ * By Gerald Combs <gerald@wireshark.org>
+ * Copyright 1998 Gerald Combs
+ *
+ * Copyright by Bogdan Diaconesc yo3iiu@yo3iiu.ro
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <glib.h>
+
+#include <epan/packet.h>
+#include <epan/tap.h>
+#include <epan/stat_cmd_args.h>
+#include <epan/dissectors/packet-ipsc.h>
+#include <epan/dissectors/ipsc-wire.h>
+
+/*
+ * A record per call: voice from GROUP_VOICE, data from GROUP_DATA and
+ * PVT_DATA, by repeater, timeslot, source and destination. A voice
+ * call ends with its Terminator with LC or with a new Voice LC Header
+ * after its bursts, a data call with the block that completes its
+ * PDU; any call also ends after IPSC_CDR_TIMEOUT seconds
+ * without a packet, checked once a second of capture time. A record
+ * is printed as it ends and then freed, so memory follows the calls
+ * on the air and not the length of the capture.
+ */
+#define IPSC_CDR_TIMEOUT    5       /* seconds */
+
+#define IPSC_CDR_CSV        0
+#define IPSC_CDR_JSON       1
+
+typedef struct _ipsc_cdr_key_t {
+    guint32 rpt_id;
+    guint32 src_id;
+    guint32 dst_id;
+    guint8  slot;
+    guint8  opcode;
+} ipsc_cdr_key_t;
+
+typedef struct _ipsc_cdr_call_t {
+    ipsc_cdr_key_t key;
+    guint32  call_id;       /* of the dissector, 0 if it did not track the call */
+    nstime_t start_time;
+    nstime_t end_time;      /* last packet */
+    guint32  packets;
+    guint32  lost;
+    guint8   last_data_type;
+    gboolean group;         /* as the dissector has it for the last packet */
+    ipsc_wire_rssi_stats_t rssi;
+} ipsc_cdr_call_t;
+
+typedef struct _ipsc_cdr_t {
+    int format;             /* IPSC_CDR_xxx */
+    GHashTable *calls;      /* ipsc_cdr_key_t -> ipsc_cdr_call_t, the calls still going */
+    time_t last_sweep;
+} ipsc_cdr_t;
+
+static ipsc_cdr_t ipsc_cdr;
+
+static guint
+ipsc_cdr_hash(gconstpointer k)
+{
+    const ipsc_cdr_key_t *key = (const ipsc_cdr_key_t *)k;
+
+    return key->rpt_id ^ (key->src_id << 7) ^ (key->dst_id << 1) ^ key->slot ^ ((guint)key->opcode << 24);
+}
+
+static gboolean
+ipsc_cdr_equal(gconstpointer k1, gconstpointer k2)
+{
+    const ipsc_cdr_key_t *key1 = (const ipsc_cdr_key_t *)k1;
+    const ipsc_cdr_key_t *key2 = (const ipsc_cdr_key_t *)k2;
+
+    return (key1->rpt_id == key2->rpt_id &&
+            key1->src_id == key2->src_id &&
+            key1->dst_id == key2->dst_id &&
+            key1->slot == key2->slot &&
+            key1->opcode == key2->opcode);
+}
+
+static void
+ipsc_cdr_reset(void *arg)
+{
+    ipsc_cdr_t *tapinfo = (ipsc_cdr_t *)arg;
+
+    if (tapinfo->calls)
+      g_hash_table_destroy(tapinfo->calls);
+
+    /* The key lives in the call */
+    tapinfo->calls = g_hash_table_new_full(ipsc_cdr_hash, ipsc_cdr_equal, NULL, g_free);
+    tapinfo->last_sweep = 0;
+}
+
+/* UTC, ISO 8601 with microseconds */
+static const gchar *
+ipsc_cdr_time_str(const nstime_t *t)
+{
+    gchar *buf = (gchar *)ep_alloc(32);
+    struct tm *tm;
+    size_t len;
+
+    tm = gmtime(&t->secs);
+    if (!tm || (len = strftime(buf, 32, "%Y-%m-%dT%H:%M:%S", tm)) == 0)
+      return ep_strdup_printf("%ld.%06d", (long)t->secs, t->nsecs / 1000);
+
+    g_snprintf(buf + len, (gulong)(32 - len), ".%06dZ", t->nsecs / 1000);
+    return buf;
+}
+
+static void
+ipsc_cdr_print(const ipsc_cdr_t *tapinfo, const ipsc_cdr_call_t *call, const gchar *reason)
+{
+    gboolean group = call->group;
+    gboolean voice = (call->key.opcode == 0x80);
+    nstime_t duration;
+    const gchar *rssi;
+
+    nstime_delta(&duration, &call->end_time, &call->start_time);
+
+    if (tapinfo->format == IPSC_CDR_JSON)
+    {
+      if (call->rssi.count)
+        rssi = ep_strdup_printf("{\"samples\":%u,\"min\":%d,\"avg\":%.1f,\"max\":%d}", call->rssi.count,
+                                call->rssi.min, ipsc_wire_rssi_stats_avg(&call->rssi), call->rssi.max);
+      else
+        rssi = "null";
+
+      printf("{\"call_id\":%u,\"start\":\"%s\",\"end\":\"%s\",\"duration\":%.3f,"
+             "\"rpt_id\":%u,\"slot\":%u,\"src_id\":%u,\"dst_id\":%u,\"type\":\"%s\",\"service\":\"%s\","
+             "\"packets\":%u,\"lost\":%u,\"rssi\":%s,\"end_reason\":\"%s\"}\n",
+             call->call_id, ipsc_cdr_time_str(&call->start_time), ipsc_cdr_time_str(&call->end_time),
+             nstime_to_sec(&duration), call->key.rpt_id, call->key.slot, call->key.src_id, call->key.dst_id,
+             group ? "group" : "private", voice ? "voice" : "data",
+             call->packets, call->lost, rssi, reason);
+    }
+    else
+    {
+      if (call->rssi.count)
+        rssi = ep_strdup_printf("%u,%d,%.1f,%d", call->rssi.count,
+                                call->rssi.min, ipsc_wire_rssi_stats_avg(&call->rssi), call->rssi.max);
+      else
+        rssi = "0,,,";
+
+      printf("%u,%s,%s,%.3f,%u,%u,%u,%u,%s,%s,%u,%u,%s,%s\n",
+             call->call_id, ipsc_cdr_time_str(&call->start_time), ipsc_cdr_time_str(&call->end_time),
+             nstime_to_sec(&duration), call->key.rpt_id, call->key.slot, call->key.src_id, call->key.dst_id,
+             group ? "group" : "private", voice ? "voice" : "data",
+             call->packets, call->lost, rssi, reason);
+    }
+}
+
+/* Ends the calls that went quiet, user_data is the capture time */
+static gboolean
+ipsc_cdr_expired(gpointer key _U_, gpointer value, gpointer user_data)
+{
+    const ipsc_cdr_call_t *call = (const ipsc_cdr_call_t *)value;
+    const nstime_t *now = (const nstime_t *)user_data;
+
+    if (now && now->secs - call->end_time.secs <= IPSC_CDR_TIMEOUT)
+      return FALSE;
+
+    ipsc_cdr_print(&ipsc_cdr, call, now ? "timeout" : "capture end");
+    return TRUE;
+}
+
+static int
+ipsc_cdr_packet(void *arg, packet_info *pinfo, epan_dissect_t *edt _U_, const void *data)
+{
+    ipsc_cdr_t *tapinfo = (ipsc_cdr_t *)arg;
+    const ipsc_info_t *ipsc_info = (const ipsc_info_t *)data;
+    ipsc_cdr_call_t *call;
+    ipsc_cdr_key_t key;
+
+    /* Once a second of capture time, whatever the traffic, keepalives included */
+    if (pinfo->fd->abs_ts.secs != tapinfo->last_sweep)
+    {
+      tapinfo->last_sweep = pinfo->fd->abs_ts.secs;
+      g_hash_table_foreach_remove(tapinfo->calls, ipsc_cdr_expired, &pinfo->fd->abs_ts);
+    }
+
+    if (!ipsc_info->is_call)
+      return 0;
+
+    memset(&key, 0, sizeof(key));
+    key.rpt_id = ipsc_info->rpt_id;
+    key.src_id = ipsc_info->src_id;
+    key.dst_id = ipsc_info->dst_id;
+    key.slot = ipsc_info->slot;
+    key.opcode = ipsc_info->opcode;
+
+    call = (ipsc_cdr_call_t *)g_hash_table_lookup(tapinfo->calls, &key);
+
+    /* A Voice LC Header after voice bursts starts a new call; repeated headers do not */
+    if (call && ipsc_info->opcode == 0x80 && ipsc_info->data_type == IPSC_DATA_TYPE_VOICE_LC_HDR &&
+        call->last_data_type != IPSC_DATA_TYPE_VOICE_LC_HDR)
+    {
+      ipsc_cdr_print(tapinfo, call, "new call");
+      g_hash_table_remove(tapinfo->calls, &key);
+      call = NULL;
+    }
+
+    if (!call)
+    {
+      call = g_new0(ipsc_cdr_call_t, 1);
+      call->key = key;
+      call->start_time = pinfo->fd->abs_ts;
+      g_hash_table_insert(tapinfo->calls, &call->key, call);
+    }
+
+    if (ipsc_info->call_id)
+      call->call_id = ipsc_info->call_id;
+    call->end_time = pinfo->fd->abs_ts;
+    call->packets++;
+    call->lost += ipsc_info->lost;
+    call->last_data_type = ipsc_info->data_type;
+    call->group = ipsc_info->group;
+    if (ipsc_info->has_rssi)
+      ipsc_wire_rssi_stats_add(&call->rssi, ipsc_info->rssi);
+
+    if (ipsc_info->opcode == 0x80 && ipsc_info->data_type == IPSC_DATA_TYPE_TERMINATOR_LC)
+    {
+      ipsc_cdr_print(tapinfo, call, "terminator");
+      g_hash_table_remove(tapinfo->calls, &key);
+    }
+    else if (ipsc_info->data_last_block)
+    {
+      ipsc_cdr_print(tapinfo, call, "last block");
+      g_hash_table_remove(tapinfo->calls, &key);
+    }
+
+    return 0;
+}
+
+static void
+ipsc_cdr_draw(void *arg)
+{
+    ipsc_cdr_t *tapinfo = (ipsc_cdr_t *)arg;
+
+    /* The calls still going when the capture ends */
+    g_hash_table_foreach_remove(tapinfo->calls, ipsc_cdr_expired, NULL);
+}
+
+static void
+ipsc_cdr_init(const char *optarg, void *userdata _U_)
+{
+    GString *err_p;
+
+    if (strcmp(optarg, "ipsc,cdr") == 0 || strcmp(optarg, "ipsc,cdr,csv") == 0)
+      ipsc_cdr.format = IPSC_CDR_CSV;
+    else if (strcmp(optarg, "ipsc,cdr,json") == 0)
+      ipsc_cdr.format = IPSC_CDR_JSON;
+    else
+    {
+      fprintf(stderr, "tshark: invalid \"-z ipsc,cdr[,csv|json]\" argument\n");
+      exit(1);
+    }
+
+    ipsc_cdr_reset(&ipsc_cdr);
+
+    err_p = register_tap_listener("ipsc", &ipsc_cdr, NULL, 0,
+                                  ipsc_cdr_reset, ipsc_cdr_packet, ipsc_cdr_draw);
+    if (err_p != NULL)
+    {
+      fprintf(stderr, "tshark: Couldn't register ipsc,cdr tap: %s\n", err_p->str);
+      g_string_free(err_p, TRUE);
+      exit(1);
+    }
+
+    /* Records come out while the capture is read */
+    if (ipsc_cdr.format == IPSC_CDR_CSV)
+      printf("call_id,start,end,duration,rpt_id,slot,src_id,dst_id,type,service,"
+             "packets,lost,rssi_samples,rssi_min,rssi_avg,rssi_max,end_reason\n");
+}
+
+void
+register_tap_listener_ipsc_cdr(void)
+{
+    register_stat_cmd_arg("ipsc,cdr", ipsc_cdr_init, NULL);
+}
@@ -0,0 +1,258 @@
+/* tap-ipscpeers.c
+ * IPSC peer topology, keepalive round trip times and peer events for tshark, -z ipsc,peers
+ *
+ * Wireshark - Network traffic analyzer
+ * By Gerald Combs <gerald@wireshark.org>
+ * Copyright 1998 Gerald Combs
+ *
+ * Copyright by Bogdan Diaconesc yo3iiu@yo3iiu.ro
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <glib.h>
+
+#include <epan/packet.h>
+#include <epan/tap.h>
+#include <epan/stat_cmd_args.h>
+#include <epan/dissectors/packet-ipsc.h>
+#include <epan/dissectors/ipsc-wire.h>
+
+/* One line of the table, per repeater */
+typedef struct _ipsc_peer_info_t {
+    guint32 rpt_id;
+    gchar  *address;        /* where it sends from, first seen */
+    guint32 port;
+    gboolean linking_known;
+    guint8  linking;        /* last seen */
+    guint8  service_flags4; /* last seen */
+    guint32 requests;       /* registrations and keepalives it sent */
+    guint32 replies;        /* replies it got back */
+    guint32 missed;         /* keepalives it sent that got no reply */
+    gdouble rtt_min;        /* ms */
+    gdouble rtt_max;        /* ms */
+    gdouble rtt_sum;        /* ms */
+    guint32 joins;
+    guint32 leaves;
+} ipsc_peer_info_t;
+
+typedef struct _ipsc_peers_t {
+    GHashTable *peers;      /* rpt_id -> ipsc_peer_info_t */
+    GString *events;        /* join and leave log, in capture order */
+} ipsc_peers_t;
+
+static ipsc_peers_t ipsc_peers;
+
+static void
+ipsc_peer_info_free(gpointer data)
+{
+    ipsc_peer_info_t *peer = (ipsc_peer_info_t *)data;
+
+    g_free(peer->address);
+    g_free(peer);
+}
+
+static void
+ipsc_peers_reset(void *arg)
+{
+    ipsc_peers_t *tapinfo = (ipsc_peers_t *)arg;
+
+    if (tapinfo->peers)
+      g_hash_table_destroy(tapinfo->peers);
+    if (tapinfo->events)
+      g_string_free(tapinfo->events, TRUE);
+
+    tapinfo->peers = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, ipsc_peer_info_free);
+    tapinfo->events = g_string_new("");
+}
+
+static ipsc_peer_info_t *
+ipsc_peers_lookup(ipsc_peers_t *tapinfo, guint32 rpt_id)
+{
+    ipsc_peer_info_t *peer;
+
+    peer = (ipsc_peer_info_t *)g_hash_table_lookup(tapinfo->peers, GUINT_TO_POINTER(rpt_id));
+    if (!peer)
+    {
+      peer = g_new0(ipsc_peer_info_t, 1);
+      peer->rpt_id = rpt_id;
+      g_hash_table_insert(tapinfo->peers, GUINT_TO_POINTER(rpt_id), peer);
+    }
+
+    return peer;
+}
+
+static int
+ipsc_peers_packet(void *arg, packet_info *pinfo, epan_dissect_t *edt _U_, const void *data)
+{
+    ipsc_peers_t *tapinfo = (ipsc_peers_t *)arg;
+    const ipsc_info_t *ipsc_info = (const ipsc_info_t *)data;
+    ipsc_peer_info_t *peer;
+    ipsc_peer_info_t *requester = NULL;
+
+    if (ipsc_info->opcode < 0x90 || ipsc_info->opcode > 0x9b)
+      return 0;
+
+    peer = ipsc_peers_lookup(tapinfo, ipsc_info->rpt_id);
+    if (!peer->address)
+    {
+      peer->address = g_strdup(ep_address_to_str(&pinfo->src));
+      peer->port = pinfo->srcport;
+    }
+
+    /* Registration and keepalives carry Linking and Service FLAGS, the peer mode */
+    if (ipsc_info->opcode != 0x92 && ipsc_info->opcode != 0x93 && ipsc_info->opcode < 0x9a)
+    {
+      peer->linking_known = TRUE;
+      peer->linking = ipsc_info->linking;
+      peer->service_flags4 = ipsc_info->service_flags4;
+    }
+
+    if (!(ipsc_info->opcode & 0x01))
+    {
+      peer->requests++;
+      if (ipsc_info->missed)
+        peer->missed++;
+    }
+    else if (ipsc_info->request_rpt_id)
+    {
+      /* Round trip time, for the side that asked */
+      requester = ipsc_peers_lookup(tapinfo, ipsc_info->request_rpt_id);
+      if (!requester->replies || ipsc_info->rtt < requester->rtt_min)
+        requester->rtt_min = ipsc_info->rtt;
+      if (!requester->replies || ipsc_info->rtt > requester->rtt_max)
+        requester->rtt_max = ipsc_info->rtt;
+      requester->rtt_sum += ipsc_info->rtt;
+      requester->replies++;
+    }
+
+    /* Events are about the requester */
+    if (ipsc_info->peer_event == IPSC_PEER_EVENT_JOIN && requester)
+    {
+      requester->joins++;
+      g_string_append_printf(tapinfo->events, "%8u %12.6f %10u joined %10u\n",
+                             pinfo->fd->num, nstime_to_sec(&pinfo->rel_ts),
+                             requester->rpt_id, ipsc_info->rpt_id);
+    }
+    else if (ipsc_info->peer_event == IPSC_PEER_EVENT_LEAVE)
+    {
+      peer->leaves++;
+      g_string_append_printf(tapinfo->events, "%8u %12.6f %10u left\n",
+                             pinfo->fd->num, nstime_to_sec(&pinfo->rel_ts), peer->rpt_id);
+    }
+
+    return 0;
+}
+
+static gint
+ipsc_peers_compare(gconstpointer a, gconstpointer b)
+{
+    const ipsc_peer_info_t *peer_a = *(const ipsc_peer_info_t * const *)a;
+    const ipsc_peer_info_t *peer_b = *(const ipsc_peer_info_t * const *)b;
+    gboolean master_a = (peer_a->service_flags4 & IPSC_FLAGS4_MASTER) != 0;
+    gboolean master_b = (peer_b->service_flags4 & IPSC_FLAGS4_MASTER) != 0;
+
+    /* The master first, then by Rpt Id */
+    if (master_a != master_b)
+      return master_a ? -1 : 1;
+    if (peer_a->rpt_id != peer_b->rpt_id)
+      return (peer_a->rpt_id < peer_b->rpt_id) ? -1 : 1;
+    return 0;
+}
+
+static void
+ipsc_peers_add_line(gpointer key _U_, gpointer value, gpointer user_data)
+{
+    g_ptr_array_add((GPtrArray *)user_data, value);
+}
+
+static const gchar *
+ipsc_peers_mode_str(const ipsc_peer_info_t *peer)
+{
+    static const gchar *radio[] = { "None", "Analog", "Digital", "?" };
+    static const gchar *slot[] = { "?", "off", "on", "?" };
+
+    if (!peer->linking_known)
+      return "-";
+
+    return ep_strdup_printf("%s TS1 %s TS2 %s", radio[(peer->linking >> 4) & 0x03],
+                            slot[(peer->linking >> 2) & 0x03], slot[peer->linking & 0x03]);
+}
+
+static void
+ipsc_peers_draw(void *arg)
+{
+    ipsc_peers_t *tapinfo = (ipsc_peers_t *)arg;
+    ipsc_peer_info_t *peer;
+    GPtrArray *lines;
+    guint i;
+
+    lines = g_ptr_array_new();
+    g_hash_table_foreach(tapinfo->peers, ipsc_peers_add_line, lines);
+    g_ptr_array_sort(lines, ipsc_peers_compare);
+
+    printf("============================== IPSC Peers ==============================\n");
+    printf("%10s %-21s %-6s %-22s %5s %5s %5s %8s %8s %8s %3s %3s\n",
+           "Rpt Id", "Address", "Role", "Mode", "Req", "Rep", "Miss",
+           "MinRTT", "AvgRTT", "MaxRTT", "Jn", "Lv");
+
+    for (i = 0; i < lines->len; i++)
+    {
+      peer = (ipsc_peer_info_t *)g_ptr_array_index(lines, i);
+
+      printf("%10u %-21s %-6s %-22s %5u %5u %5u %8.2f %8.2f %8.2f %3u %3u\n",
+             peer->rpt_id,
+             peer->address ? ep_strdup_printf("%s:%u", peer->address, peer->port) : "-",
+             (peer->service_flags4 & IPSC_FLAGS4_MASTER) ? "Master" : "Peer",
+             ipsc_peers_mode_str(peer),
+             peer->requests, peer->replies, peer->missed,
+             peer->rtt_min, peer->replies ? peer->rtt_sum / peer->replies : 0.0, peer->rtt_max,
+             peer->joins, peer->leaves);
+    }
+
+    printf("\nPeer events:\n%8s %12s %10s\n", "Frame", "Time", "Rpt Id");
+    printf("%s", tapinfo->events->str);
+    printf("========================================================================\n");
+
+    g_ptr_array_free(lines, TRUE);
+}
+
+static void
+ipsc_peers_init(const char *optarg _U_, void *userdata _U_)
+{
+    GString *err_p;
+
+    ipsc_peers_reset(&ipsc_peers);
+
+    err_p = register_tap_listener("ipsc", &ipsc_peers, NULL, 0,
+                                  ipsc_peers_reset, ipsc_peers_packet, ipsc_peers_draw);
+    if (err_p != NULL)
+    {
+      fprintf(stderr, "tshark: Couldn't register ipsc,peers tap: %s\n", err_p->str);
+      g_string_free(err_p, TRUE);
+      exit(1);
+    }
+}
+
+void
+register_tap_listener_ipsc_peers(void)
+{
+    register_stat_cmd_arg("ipsc,peers", ipsc_peers_init, NULL);
+}
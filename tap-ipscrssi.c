@@ -0,0 +1,217 @@
+/* tap-ipscrssi.c
+ * IPSC RSSI min/avg/max per repeater, timeslot, radio and interval for tshark, -z ipsc,rssi[,secs]
+ *
+ * Wireshark - Network traffic analyzer
+ * By Gerald Combs <gerald@wireshark.org>
+ * Copyright 1998 Gerald Combs
+ *
+ * Copyright by Bogdan Diaconesc yo3iiu@yo3iiu.ro
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <glib.h>
+
+#include <epan/packet.h>
+#include <epan/tap.h>
+#include <epan/stat_cmd_args.h>
+#include <epan/dissectors/packet-ipsc.h>
+#include <epan/dissectors/ipsc-wire.h>
+
+#define IPSC_RSSI_DEFAULT_INTERVAL  60
+
+/*
+ * One line per repeater, timeslot, radio and interval. Lines are
+ * printed as soon as the capture moves past their interval, so only
+ * the radios heard in the current interval are held, however long the
+ * capture; the output is in time order, ready for a heatmap.
+ */
+typedef struct _ipsc_rssi_line_t {
+    guint64 key;            /* rpt_id << 32 | slot << 24 | src_id */
+    guint32 rpt_id;
+    guint8  slot;
+    guint32 src_id;
+    ipsc_wire_rssi_stats_t stats;
+} ipsc_rssi_line_t;
+
+typedef struct _ipsc_rssi_t {
+    guint interval;         /* s */
+    GHashTable *lines;      /* key -> ipsc_rssi_line_t, the current interval */
+    gint64 current;         /* start of the current interval */
+    gboolean seen;
+} ipsc_rssi_t;
+
+static ipsc_rssi_t ipsc_rssi;
+
+static void
+ipsc_rssi_reset(void *arg)
+{
+    ipsc_rssi_t *tapinfo = (ipsc_rssi_t *)arg;
+
+    if (tapinfo->lines)
+      g_hash_table_destroy(tapinfo->lines);
+
+    /* The key lives in the line */
+    tapinfo->lines = g_hash_table_new_full(g_int64_hash, g_int64_equal, NULL, g_free);
+    tapinfo->seen = FALSE;
+}
+
+static gint
+ipsc_rssi_compare(gconstpointer a, gconstpointer b)
+{
+    const ipsc_rssi_line_t *line_a = *(const ipsc_rssi_line_t * const *)a;
+    const ipsc_rssi_line_t *line_b = *(const ipsc_rssi_line_t * const *)b;
+
+    if (line_a->key != line_b->key)
+      return (line_a->key < line_b->key) ? -1 : 1;
+    return 0;
+}
+
+static void
+ipsc_rssi_add_line(gpointer key _U_, gpointer value, gpointer user_data)
+{
+    g_ptr_array_add((GPtrArray *)user_data, value);
+}
+
+/* Print the lines of the current interval and start an empty one */
+static void
+ipsc_rssi_flush(ipsc_rssi_t *tapinfo)
+{
+    ipsc_rssi_line_t *line;
+    GPtrArray *lines;
+    time_t start;
+    struct tm *tm;
+    gchar when[32];
+    guint i;
+
+    if (!g_hash_table_size(tapinfo->lines))
+      return;
+
+    lines = g_ptr_array_new();
+    g_hash_table_foreach(tapinfo->lines, ipsc_rssi_add_line, lines);
+    g_ptr_array_sort(lines, ipsc_rssi_compare);
+
+    start = (time_t)tapinfo->current;
+    tm = gmtime(&start);
+    if (!tm || !strftime(when, sizeof(when), "%Y-%m-%d %H:%M:%S", tm))
+      g_snprintf(when, sizeof(when), "%" G_GINT64_MODIFIER "d", tapinfo->current);
+
+    for (i = 0; i < lines->len; i++)
+    {
+      line = (ipsc_rssi_line_t *)g_ptr_array_index(lines, i);
+
+      printf("%-20s %10u %2u %10u %7u %6d %7.1f %6d\n",
+             when, line->rpt_id, line->slot, line->src_id, line->stats.count,
+             line->stats.min, ipsc_wire_rssi_stats_avg(&line->stats), line->stats.max);
+    }
+
+    g_ptr_array_free(lines, TRUE);
+    g_hash_table_remove_all(tapinfo->lines);
+}
+
+static int
+ipsc_rssi_packet(void *arg, packet_info *pinfo, epan_dissect_t *edt _U_, const void *data)
+{
+    ipsc_rssi_t *tapinfo = (ipsc_rssi_t *)arg;
+    const ipsc_info_t *ipsc_info = (const ipsc_info_t *)data;
+    ipsc_rssi_line_t *line;
+    guint64 key;
+    gint64 start;
+
+    if (!ipsc_info->is_call || !ipsc_info->has_rssi)
+      return 0;
+
+    /* Capture order is time order but for a little reordering; a late packet joins the current interval */
+    start = ipsc_wire_rssi_bucket(pinfo->fd->abs_ts.secs, tapinfo->interval);
+    if (!tapinfo->seen)
+    {
+      tapinfo->seen = TRUE;
+      tapinfo->current = start;
+    }
+    else if (start > tapinfo->current)
+    {
+      ipsc_rssi_flush(tapinfo);
+      tapinfo->current = start;
+    }
+
+    key = ((guint64)ipsc_info->rpt_id << 32) | ((guint64)ipsc_info->slot << 24) | ipsc_info->src_id;
+    line = (ipsc_rssi_line_t *)g_hash_table_lookup(tapinfo->lines, &key);
+    if (!line)
+    {
+      line = g_new0(ipsc_rssi_line_t, 1);
+      line->key = key;
+      line->rpt_id = ipsc_info->rpt_id;
+      line->slot = ipsc_info->slot;
+      line->src_id = ipsc_info->src_id;
+      line->stats.start = tapinfo->current;
+      g_hash_table_insert(tapinfo->lines, &line->key, line);
+    }
+
+    ipsc_wire_rssi_stats_add(&line->stats, ipsc_info->rssi);
+
+    return 0;
+}
+
+static void
+ipsc_rssi_draw(void *arg)
+{
+    ipsc_rssi_t *tapinfo = (ipsc_rssi_t *)arg;
+
+    ipsc_rssi_flush(tapinfo);
+    printf("=======================================================================\n");
+}
+
+static void
+ipsc_rssi_init(const char *optarg, void *userdata _U_)
+{
+    GString *err_p;
+    int interval = IPSC_RSSI_DEFAULT_INTERVAL;
+
+    if (sscanf(optarg, "ipsc,rssi,%d", &interval) == 1 && interval <= 0)
+    {
+      fprintf(stderr, "tshark: invalid \"-z ipsc,rssi,<secs>\" interval\n");
+      exit(1);
+    }
+    ipsc_rssi.interval = interval;
+
+    ipsc_rssi_reset(&ipsc_rssi);
+
+    err_p = register_tap_listener("ipsc", &ipsc_rssi, NULL, 0,
+                                  ipsc_rssi_reset, ipsc_rssi_packet, ipsc_rssi_draw);
+    if (err_p != NULL)
+    {
+      fprintf(stderr, "tshark: Couldn't register ipsc,rssi tap: %s\n", err_p->str);
+      g_string_free(err_p, TRUE);
+      exit(1);
+    }
+
+    /* Lines come out while the capture is read */
+    printf("============================ IPSC RSSI ================================\n");
+    printf("Interval: %d s, levels in dBm\n", interval);
+    printf("%-20s %10s %2s %10s %7s %6s %7s %6s\n",
+           "Interval Start (UTC)", "Rpt Id", "TS", "Radio", "Samples", "Min", "Avg", "Max");
+}
+
+void
+register_tap_listener_ipsc_rssi(void)
+{
+    register_stat_cmd_arg("ipsc,rssi", ipsc_rssi_init, NULL);
+}
@@ -0,0 +1,164 @@
+/* tap-ipscstreams.c
+ * IPSC voice stream summary for tshark, -z ipsc,streams
+ *
+ * Wireshark - Network traffic analyzer
+ * By Gerald Combs <gerald@wireshark.org>
+ * Copyright 1998 Gerald Combs
+ *
+ * Copyright by Bogdan Diaconesc yo3iiu@yo3iiu.ro
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <glib.h>
+
+#include <epan/packet.h>
+#include <epan/tap.h>
+#include <epan/stat_cmd_args.h>
+#include <epan/dissectors/packet-ipsc.h>
+
+/* One line of the table, per call */
+typedef struct _ipsc_stream_info_t {
+    guint32 call_id;
+    guint32 rpt_id;
+    guint8  slot;
+    guint32 src_id;
+    guint32 dst_id;
+    guint32 first_frame;
+    guint32 packets;
+    guint32 lost;
+    guint32 duplicates;
+    guint32 out_of_order;
+    gdouble jitter;         /* ms, at the last packet */
+    gdouble max_jitter;     /* ms */
+} ipsc_stream_info_t;
+
+typedef struct _ipsc_streams_t {
+    GHashTable *streams;    /* call_id -> ipsc_stream_info_t */
+    guint32 max_call_id;
+} ipsc_streams_t;
+
+static ipsc_streams_t ipsc_streams;
+
+static void
+ipsc_streams_reset(void *arg)
+{
+    ipsc_streams_t *tapinfo = (ipsc_streams_t *)arg;
+
+    if (tapinfo->streams)
+      g_hash_table_destroy(tapinfo->streams);
+
+    tapinfo->streams = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, g_free);
+    tapinfo->max_call_id = 0;
+}
+
+static int
+ipsc_streams_packet(void *arg, packet_info *pinfo, epan_dissect_t *edt _U_, const void *data)
+{
+    ipsc_streams_t *tapinfo = (ipsc_streams_t *)arg;
+    const ipsc_info_t *ipsc_info = (const ipsc_info_t *)data;
+    ipsc_stream_info_t *stream;
+
+    if (!ipsc_info->call_id)
+      return 0;
+
+    stream = (ipsc_stream_info_t *)g_hash_table_lookup(tapinfo->streams, GUINT_TO_POINTER(ipsc_info->call_id));
+    if (!stream)
+    {
+      stream = g_new0(ipsc_stream_info_t, 1);
+      stream->call_id = ipsc_info->call_id;
+      stream->rpt_id = ipsc_info->rpt_id;
+      stream->slot = ipsc_info->slot;
+      stream->src_id = ipsc_info->src_id;
+      stream->dst_id = ipsc_info->dst_id;
+      stream->first_frame = pinfo->fd->num;
+      g_hash_table_insert(tapinfo->streams, GUINT_TO_POINTER(ipsc_info->call_id), stream);
+
+      if (ipsc_info->call_id > tapinfo->max_call_id)
+        tapinfo->max_call_id = ipsc_info->call_id;
+    }
+
+    stream->packets++;
+    stream->lost += ipsc_info->lost;
+    if (ipsc_info->stream_flags & IPSC_STREAM_DUPLICATE)
+      stream->duplicates++;
+    if (ipsc_info->stream_flags & IPSC_STREAM_OUT_OF_ORDER)
+    {
+      stream->out_of_order++;
+      /* The late packet was already counted in a gap */
+      if (stream->lost)
+        stream->lost--;
+    }
+    stream->jitter = ipsc_info->jitter;
+    if (ipsc_info->jitter > stream->max_jitter)
+      stream->max_jitter = ipsc_info->jitter;
+
+    return 0;
+}
+
+static void
+ipsc_streams_draw(void *arg)
+{
+    ipsc_streams_t *tapinfo = (ipsc_streams_t *)arg;
+    ipsc_stream_info_t *stream;
+    guint32 call_id;
+
+    printf("========================= IPSC Voice Streams ==========================\n");
+    printf("%6s %10s %2s %9s %9s %8s %7s %7s %5s %5s %8s %8s\n",
+           "Call", "Rpt Id", "TS", "Src Id", "Dst Id", "Frame", "Pkts", "Lost", "Dup", "OOO",
+           "Jit(ms)", "MaxJit");
+
+    /* Call ids are handed out in order, so this lists the calls as they started */
+    for (call_id = 1; call_id <= tapinfo->max_call_id; call_id++)
+    {
+      stream = (ipsc_stream_info_t *)g_hash_table_lookup(tapinfo->streams, GUINT_TO_POINTER(call_id));
+      if (!stream)
+        continue;
+
+      printf("%6u %10u %2u %9u %9u %8u %7u %7u %5u %5u %8.2f %8.2f\n",
+             stream->call_id, stream->rpt_id, stream->slot, stream->src_id, stream->dst_id,
+             stream->first_frame, stream->packets, stream->lost, stream->duplicates,
+             stream->out_of_order, stream->jitter, stream->max_jitter);
+    }
+    printf("=======================================================================\n");
+}
+
+static void
+ipsc_streams_init(const char *optarg _U_, void *userdata _U_)
+{
+    GString *err_p;
+
+    ipsc_streams_reset(&ipsc_streams);
+
+    err_p = register_tap_listener("ipsc", &ipsc_streams, NULL, 0,
+                                  ipsc_streams_reset, ipsc_streams_packet, ipsc_streams_draw);
+    if (err_p != NULL)
+    {
+      fprintf(stderr, "tshark: Couldn't register ipsc,streams tap: %s\n", err_p->str);
+      g_string_free(err_p, TRUE);
+      exit(1);
+    }
+}
+
+void
+register_tap_listener_ipsc_streams(void)
+{
+    register_stat_cmd_arg("ipsc,streams", ipsc_streams_init, NULL);
+}